@@ -0,0 +1,221 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include "Aeras_ExplicitRKSolver.hpp"
+
+#include "Phalanx_KokkosDeviceTypes.hpp"
+#include "Teuchos_TestForException.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "Teuchos_VerboseObject.hpp"
+
+Aeras::ExplicitRKSolver::ExplicitRKSolver(
+    const Teuchos::RCP<Albany::Application>& app,
+    const Teuchos::RCP<Teuchos::ParameterList>& appParams,
+    const bool useExplHyperviscosity)
+    : app_(app)
+{
+  Teuchos::ParameterList& rkParams =
+    appParams->sublist("Piro").sublist("Aeras Explicit RK");
+
+  const std::string scheme = rkParams.get<std::string>("Scheme", "SSP-RK3");
+  if      (scheme == "Forward Euler") scheme_ = FORWARD_EULER;
+  else if (scheme == "SSP-RK2")       scheme_ = SSP_RK2;
+  else if (scheme == "SSP-RK3")       scheme_ = SSP_RK3;
+  else if (scheme == "RK4")           scheme_ = RK4;
+  else TEUCHOS_TEST_FOR_EXCEPTION(true, std::logic_error,
+         "Error! Aeras::ExplicitRKSolver: unknown Scheme " << scheme
+         << ". Valid options are Forward Euler, SSP-RK2, SSP-RK3 and RK4.\n");
+
+  initial_time_    = rkParams.get<double>("Initial Time", 0.0);
+  final_time_      = rkParams.get<double>("Final Time", 1.0);
+  num_steps_       = rkParams.get<int>("Number of Time Steps", 1);
+  output_interval_ = rkParams.get<int>("Output Interval", 1);
+  TEUCHOS_TEST_FOR_EXCEPTION(num_steps_ < 1, std::logic_error,
+    "Error! Aeras::ExplicitRKSolver: Number of Time Steps must be positive.\n");
+
+  const std::string appname = app_->getProblemPL()->get("Name", "");
+  const bool SW_app = (appname == "Aeras Shallow Water 3D");
+
+  // The decorator already holds the lumped mass. Without hyperviscosity the
+  // mass is assembled once here, the same way HVDecorator::createOperatorDiag does.
+  if (useExplHyperviscosity) {
+    hv_ = Teuchos::rcp(new HVDecorator(app_, appParams));
+    model_ = hv_;
+    inv_mass_diag_ = hv_->getInvMassDiag();
+  }
+  else {
+    model_ = Teuchos::rcp(new Albany::ModelEvaluatorT(app_, appParams));
+    const Teuchos::RCP<Tpetra_CrsMatrix> mass =
+      Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(
+        ConverterT::getTpetraOperator(model_->create_W_op()), true);
+    const Teuchos::RCP<const Tpetra_Vector> xT =
+      ConverterT::getConstTpetraVector(model_->getNominalValues().get_x());
+    const Teuchos::RCP<Tpetra_Vector> x_dotT = Teuchos::rcp(new Tpetra_Vector(xT->getMap(), true));
+    Teuchos::RCP<Tpetra_Vector> x_dotdotT = Teuchos::null;
+    if (SW_app)
+      x_dotdotT = Teuchos::rcp(new Tpetra_Vector(xT->getMap(), true));
+    Tpetra_Vector fT(xT->getMap());
+    app_->computeGlobalJacobianT(1.0, 0.0, 0.0, initial_time_, x_dotT.get(), x_dotdotT.get(),
+                                 *xT, p_, &fT, *mass);
+    const Teuchos::RCP<Tpetra_Vector> inv_mass = Teuchos::rcp(new Tpetra_Vector(mass->getRowMap()));
+    mass->getLocalDiagCopy(*inv_mass);
+    inv_mass->reciprocal(*inv_mass);
+    inv_mass_diag_ = inv_mass;
+  }
+
+  initial_x_ = ConverterT::getConstTpetraVector(model_->getNominalValues().get_x());
+  observer_ = Teuchos::rcp(new Albany::ObserverImpl(app_));
+
+  const Teuchos::RCP<const Tpetra_Map> map = inv_mass_diag_->getMap();
+  f_      = Teuchos::rcp(new Tpetra_Vector(map));
+  x_dot_  = Teuchos::rcp(new Tpetra_Vector(map, true));
+  x0_     = Teuchos::rcp(new Tpetra_Vector(map));
+  x1_     = Teuchos::rcp(new Tpetra_Vector(map));
+  if (scheme_ == SSP_RK3 || scheme_ == RK4)
+    x2_   = Teuchos::rcp(new Tpetra_Vector(map));
+  if (scheme_ == RK4)
+    acc_  = Teuchos::rcp(new Tpetra_Vector(map));
+  if (Teuchos::nonnull(hv_))
+    xtilde_ = Teuchos::rcp(new Tpetra_Vector(map));
+}
+
+Teuchos::RCP<const Thyra::VectorSpaceBase<ST> >
+Aeras::ExplicitRKSolver::get_p_space(int l) const
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter,
+    "Error in Aeras::ExplicitRKSolver::get_p_space(): parameters are not supported.\n");
+  return Teuchos::null;
+}
+
+Teuchos::RCP<const Thyra::VectorSpaceBase<ST> >
+Aeras::ExplicitRKSolver::get_g_space(int j) const
+{
+  const int num_g = model_->Ng();
+  TEUCHOS_TEST_FOR_EXCEPTION(j > num_g || j < 0, Teuchos::Exceptions::InvalidParameter,
+    "Error in Aeras::ExplicitRKSolver::get_g_space(): Invalid response index j = " << j << "\n");
+  // The last response is the solution
+  if (j == num_g) return model_->get_x_space();
+  return model_->get_g_space(j);
+}
+
+Thyra::ModelEvaluatorBase::InArgs<ST>
+Aeras::ExplicitRKSolver::createInArgs() const
+{
+  Thyra::ModelEvaluatorBase::InArgsSetup<ST> inArgs;
+  inArgs.setModelEvalDescription(this->description());
+  inArgs.set_Np(0);
+  return inArgs;
+}
+
+Thyra::ModelEvaluatorBase::OutArgs<ST>
+Aeras::ExplicitRKSolver::createOutArgsImpl() const
+{
+  Thyra::ModelEvaluatorBase::OutArgsSetup<ST> outArgs;
+  outArgs.setModelEvalDescription(this->description());
+  outArgs.set_Np_Ng(0, model_->Ng()+1);
+  return outArgs;
+}
+
+void
+Aeras::ExplicitRKSolver::stage(
+    const double t, const Tpetra_Vector& x,
+    const double a, const double b, const double c,
+    const double d, const double w,
+    Tpetra_Vector& x_next) const
+{
+  app_->computeGlobalResidualT(t, x_dot_.get(), NULL, x, p_, *f_);
+  if (Teuchos::nonnull(hv_))
+    hv_->applyLinvML(Teuchos::rcpFromRef(x), xtilde_);
+
+  Teuchos::ArrayRCP<const ST> f_constView = f_->get1dView();
+  Teuchos::ArrayRCP<const ST> m_constView = inv_mass_diag_->get1dView();
+  Teuchos::ArrayRCP<const ST> x_constView = x.get1dView();
+  Teuchos::ArrayRCP<const ST> x0_constView = x0_->get1dView();
+  Teuchos::ArrayRCP<const ST> xt_constView;
+  if (Teuchos::nonnull(xtilde_)) xt_constView = xtilde_->get1dView();
+  Teuchos::ArrayRCP<ST> acc_nonconstView;
+  if (Teuchos::nonnull(acc_)) acc_nonconstView = acc_->get1dViewNonConst();
+  Teuchos::ArrayRCP<ST> xn_nonconstView = x_next.get1dViewNonConst();
+
+  const ST* fv  = f_constView.getRawPtr();
+  const ST* mv  = m_constView.getRawPtr();
+  const ST* xv  = x_constView.getRawPtr();
+  const ST* x0v = x0_constView.getRawPtr();
+  const ST* xtv = xt_constView.getRawPtr();
+  ST* accv = acc_nonconstView.getRawPtr();
+  ST* xnv  = xn_nonconstView.getRawPtr();
+
+  // Each entry reads x0, x and acc before writing, so x_next may alias them
+  Kokkos::parallel_for(Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0,x_next.getLocalLength()),
+                       [=](const int i) {
+    const ST k = -mv[i]*(xtv ? fv[i]+xtv[i] : fv[i]);
+    ST xn = a*x0v[i] + b*xv[i] + c*k;
+    if (accv) {
+      xn += d*accv[i];
+      accv[i] += w*k;
+    }
+    xnv[i] = xn;
+  });
+}
+
+void
+Aeras::ExplicitRKSolver::evalModelImpl(
+    const Thyra::ModelEvaluatorBase::InArgs<ST>& inArgs,
+    const Thyra::ModelEvaluatorBase::OutArgs<ST>& outArgs) const
+{
+  static Teuchos::RCP<Teuchos::Time> timer =
+    Teuchos::TimeMonitor::getNewTimer("Albany: Aeras Explicit RK");
+  Teuchos::TimeMonitor Timer(*timer);
+
+  Teuchos::RCP<Teuchos::FancyOStream> out = Teuchos::VerboseObjectBase::getDefaultOStream();
+
+  const double dt = (final_time_ - initial_time_)/num_steps_;
+  double t = initial_time_;
+  x0_->assign(*initial_x_);
+  observer_->observeSolutionT(t, *x0_, Teuchos::null);
+
+  for (int step=1; step<=num_steps_; ++step) {
+    switch (scheme_) {
+    case FORWARD_EULER:
+      stage(t,      *x0_, 0.0, 1.0, dt, 0.0, 0.0, *x0_);
+      break;
+    // Shu-Osher form: x_s = a*x0 + b*(x_{s-1} + dt*k_{s-1})
+    case SSP_RK2:
+      stage(t,      *x0_, 0.0, 1.0, dt,     0.0, 0.0, *x1_);
+      stage(t+dt,   *x1_, 0.5, 0.5, 0.5*dt, 0.0, 0.0, *x0_);
+      break;
+    case SSP_RK3:
+      stage(t,        *x0_, 0.0,     1.0,     dt,         0.0, 0.0, *x1_);
+      stage(t+dt,     *x1_, 0.75,    0.25,    0.25*dt,    0.0, 0.0, *x2_);
+      stage(t+0.5*dt, *x2_, 1.0/3.0, 2.0/3.0, 2.0/3.0*dt, 0.0, 0.0, *x0_);
+      break;
+    // acc collects dt*(k1 + 2 k2 + 2 k3)/6, the last stage adds it to x0
+    case RK4:
+      acc_->putScalar(0.0);
+      stage(t,        *x0_, 1.0, 0.0, 0.5*dt, 0.0, dt/6.0, *x1_);
+      stage(t+0.5*dt, *x1_, 1.0, 0.0, 0.5*dt, 0.0, dt/3.0, *x2_);
+      stage(t+0.5*dt, *x2_, 1.0, 0.0, dt,     0.0, dt/3.0, *x1_);
+      stage(t+dt,     *x1_, 1.0, 0.0, dt/6.0, 1.0, 0.0,    *x0_);
+      break;
+    }
+    t = initial_time_ + step*dt;
+
+    if ((output_interval_ > 0 && step % output_interval_ == 0) || step == num_steps_)
+      observer_->observeSolutionT(t, *x0_, Teuchos::null);
+  }
+  *out << "Aeras::ExplicitRKSolver: " << num_steps_ << " steps to time " << t << std::endl;
+
+  // Responses at the final time, then the solution itself
+  const int num_g = model_->Ng();
+  for (int j=0; j<num_g; ++j) {
+    const Teuchos::RCP<Thyra::VectorBase<ST> > g_out = outArgs.get_g(j);
+    if (Teuchos::nonnull(g_out))
+      app_->evaluateResponseT(j, t, x_dot_.get(), NULL, *x0_, p_,
+                              *ConverterT::getTpetraVector(g_out));
+  }
+  const Teuchos::RCP<Thyra::VectorBase<ST> > x_out = outArgs.get_g(num_g);
+  if (Teuchos::nonnull(x_out))
+    ConverterT::getTpetraVector(x_out)->assign(*x0_);
+}
@@ -0,0 +1,89 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#if !defined(Aeras_ExplicitRKSolver_hpp)
+#define Aeras_ExplicitRKSolver_hpp
+
+#include "Albany_Application.hpp"
+#include "Albany_DataTypes.hpp"
+#include "Albany_ModelEvaluatorT.hpp"
+#include "Albany_ObserverImpl.hpp"
+#include "Thyra_ResponseOnlyModelEvaluatorBase.hpp"
+
+#include "Aeras_HVDecorator.hpp"
+
+namespace Aeras {
+
+///
+/// \brief Explicit Runge-Kutta time stepper for lumped-mass Aeras problems
+///
+/// Integrates M x_dot + f(x) = 0 with a diagonal M, i.e.
+/// x_dot = -M^{-1} (f(x) + L M^{-1} L x) when explicit hyperviscosity is on.
+/// The residual goes straight to Application::computeGlobalResidualT, and
+/// the inverse mass, the stage combination and the accumulation of the
+/// final update are applied in one pass over the owned dofs, so a stage
+/// costs one residual evaluation and one sweep over the vectors.
+///
+/// Selected by a "Aeras Explicit RK" sublist of "Piro" with the
+/// "Aeras Hyperviscosity" solution method. Responses are evaluated at the
+/// final time; the last response is the solution, as for the Piro solvers.
+///
+class ExplicitRKSolver: public Thyra::ResponseOnlyModelEvaluatorBase<ST> {
+
+public:
+
+  /// Constructor
+  ExplicitRKSolver(
+      const Teuchos::RCP<Albany::Application>& app,
+      const Teuchos::RCP<Teuchos::ParameterList>& appParams,
+      const bool useExplHyperviscosity);
+
+  /// Return parameter vector map
+  Teuchos::RCP<const Thyra::VectorSpaceBase<ST> > get_p_space(int l) const;
+
+  /// Return response function map
+  Teuchos::RCP<const Thyra::VectorSpaceBase<ST> > get_g_space(int j) const;
+
+  Thyra::ModelEvaluatorBase::InArgs<ST> createInArgs() const;
+
+private:
+
+  Thyra::ModelEvaluatorBase::OutArgs<ST> createOutArgsImpl() const;
+
+  void evalModelImpl(
+      const Thyra::ModelEvaluatorBase::InArgs<ST>& inArgs,
+      const Thyra::ModelEvaluatorBase::OutArgs<ST>& outArgs) const;
+
+  /// k = -M^{-1} (f(x) + L M^{-1} L x) at time t, fused with the stage update
+  ///   x_next = a*x0 + b*x + c*k + d*acc,  acc += w*k
+  /// where x0 is the solution at the start of the step. x_next may alias x0 or x.
+  void stage(const double t, const Tpetra_Vector& x,
+             const double a, const double b, const double c,
+             const double d, const double w,
+             Tpetra_Vector& x_next) const;
+
+  enum Scheme {FORWARD_EULER, SSP_RK2, SSP_RK3, RK4};
+
+  Teuchos::RCP<Albany::Application> app_;
+  Teuchos::RCP<Albany::ModelEvaluatorT> model_;
+  //! Non-null when explicit hyperviscosity is on
+  Teuchos::RCP<HVDecorator> hv_;
+  Teuchos::RCP<Albany::ObserverImpl> observer_;
+
+  Scheme scheme_;
+  double initial_time_, final_time_;
+  int    num_steps_, output_interval_;
+
+  Teuchos::RCP<const Tpetra_Vector> inv_mass_diag_;
+  Teuchos::RCP<const Tpetra_Vector> initial_x_;
+  //! Work vectors: residual, hyperviscosity term, zero x_dot, stages, RK4 accumulator
+  Teuchos::RCP<Tpetra_Vector> f_, xtilde_, x_dot_, x0_, x1_, x2_, acc_;
+  Teuchos::Array<ParamVec> p_;
+};
+
+}
+
+#endif // Aeras_ExplicitRKSolver_hpp
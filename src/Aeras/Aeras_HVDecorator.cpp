@@ -4,6 +4,7 @@
 //    in the file "license.txt" in the top-level Albany directory  //
 //*****************************************************************//
 #include "Aeras_HVDecorator.hpp"
+#include "Aeras_HydrostaticProblem.hpp"
 #include "Albany_SolverFactory.hpp"
 #include "Albany_ModelFactory.hpp"
 #include "Teuchos_TestForException.hpp"
@@ -93,17 +94,40 @@ Aeras::HVDecorator::HVDecorator(
   const bool SW_app = (appname == "Aeras Shallow Water 3D");
   const bool Hydro_app = (appname == "Aeras Hydrostatic");
 
+  // For the hydrostatic problem the Laplace evaluation below only records the
+  // element geometry in hvLaplace_ (unless "Matrix-Free Hyperviscosity" is
+  // false), and the operator is then applied without assembling anything.
+  if(Hydro_app) {
+    Teuchos::RCP<Aeras::HydrostaticProblem> hydro =
+      Teuchos::rcp_dynamic_cast<Aeras::HydrostaticProblem>(app->getProblem());
+    if (Teuchos::nonnull(hydro))
+      hvLaplace_ = hydro->getHVLaplaceOperator();
+  }
+
+  Teuchos::RCP<Tpetra_CrsMatrix> laplace;
+  if(SW_app)
+      laplace = createOperator(0.0, 0.0, 1.0, true);
+  if(Hydro_app)
+      laplace = createOperator(0.0, 0.0, 1.0, false);
+
+  const Teuchos::RCP<const Albany::AbstractDiscretization> disc = app->getDiscretization();
+  if (Teuchos::nonnull(hvLaplace_) && hvLaplace_->isRecorded(disc->getWsElNodeEqID().size())) {
+    hvLaplace_->initialize(disc);
+    inv_mass_diag_ = Teuchos::rcp(new Tpetra_Vector(disc->getMapT()));
+    hvLaplace_->lumpedMass(*inv_mass_diag_);
+    inv_mass_diag_->reciprocal(*inv_mass_diag_);
+    wrk_ = Teuchos::rcp(new Tpetra_Vector(disc->getMapT()));
+    xtildeT = Teuchos::rcp(new Tpetra_Vector(disc->getMapT()));
+    return;
+  }
+  hvLaplace_ = Teuchos::null;
+
   // Create and store mass and Laplacian operators (in CrsMatrix form). 
   Teuchos::RCP<Tpetra_CrsMatrix> mass;
   if(SW_app)
 	  mass = createOperatorDiag(1.0, 0.0, 0.0, true);
   if(Hydro_app)
 	  mass = createOperatorDiag(1.0, 0.0, 0.0, false);
-  Teuchos::RCP<Tpetra_CrsMatrix> laplace;
-  if(SW_app)
-      laplace = createOperator(0.0, 0.0, 1.0, true);
-  if(Hydro_app)
-      laplace = createOperator(0.0, 0.0, 1.0, false);
 
   // Do some preprocessing to speed up subsequent residual calculations.
   // 1. Store the lumped mass diag reciprocal.
@@ -215,6 +239,14 @@ const
   std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
 #endif
 
+  if (Teuchos::nonnull(hvLaplace_)) {
+    // Same sequence, with the element-local operator
+    hvLaplace_->apply(*x_in, *x_out);
+    wrk_->elementWiseMultiply(1.0, *inv_mass_diag_, *x_out, 0.0);
+    hvLaplace_->apply(*wrk_, *x_out);
+    return;
+  }
+
   // x_out = laplace_ * x_in
   laplace_->apply(*x_in, *x_out, Teuchos::NO_TRANS, 1.0, 0.0); 
   // wrk_ = inv(M) * x_out
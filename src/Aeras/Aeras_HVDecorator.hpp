@@ -14,6 +14,8 @@
 
 #include "Thyra_ModelEvaluatorDefaultBase.hpp"
 
+#include "Aeras_HVLaplaceOperator.hpp"
+
 namespace Aeras {
 
 ///
@@ -36,6 +38,9 @@ public:
 
   void applyLinvML(Teuchos::RCP<const Tpetra_Vector> x_in, Teuchos::RCP<Tpetra_Vector> x_out) const; 
 
+  //! Reciprocal of the lumped mass
+  Teuchos::RCP<const Tpetra_Vector> getInvMassDiag() const { return inv_mass_diag_; }
+
 protected:
 
   //! Evaluate model on InArgs
@@ -46,6 +51,8 @@ protected:
 private: 
   //Mass and Laplace operators
   Teuchos::RCP<Tpetra_CrsMatrix> laplace_; 
+  //Matrix-free Laplace, used instead of laplace_ when available
+  Teuchos::RCP<HVLaplaceOperator> hvLaplace_;
   Teuchos::RCP<Tpetra_Vector> inv_mass_diag_, wrk_;
   Teuchos::RCP<Tpetra_Vector> xtildeT; 
 };
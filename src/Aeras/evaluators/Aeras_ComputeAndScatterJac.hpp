@@ -13,6 +13,7 @@
 #include "Phalanx_MDField.hpp"
 
 #include "Aeras_Layouts.hpp"
+#include "Aeras_HVLaplaceOperator.hpp"
 
 #include "Teuchos_ParameterList.hpp"
 
@@ -70,6 +71,13 @@ protected:
 protected:
   double sqrtHVcoef;
 
+  //! Matrix-free hyperviscosity: the Laplace evaluation only records the geometry
+  Teuchos::RCP<HVLaplaceOperator> hvLaplace;
+  PHX::MDField<const MeshScalarT,Cell,QuadPoint,Dim,Dim> jacobian_inv;
+  Teuchos::RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > intrepidBasis;
+  Teuchos::RCP<Intrepid2::Cubature<PHX::Device> > cubature;
+  const int numQPs;
+
 };
 
 template<typename EvalT, typename Traits> class ComputeAndScatterJac;
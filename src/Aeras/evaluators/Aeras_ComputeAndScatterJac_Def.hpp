@@ -28,7 +28,8 @@ ComputeAndScatterJacBase(const Teuchos::ParameterList& p,
   numNodes   (dl->node_scalar             ->dimension(1)),
   numDims    (dl->node_qp_gradient        ->dimension(3)),
   numLevels  (dl->node_scalar_level       ->dimension(2)), 
-  numFields  (0), numNodeVar(0), numVectorLevelVar(0),  numScalarLevelVar(0), numTracerVar(0)
+  numFields  (0), numNodeVar(0), numVectorLevelVar(0),  numScalarLevelVar(0), numTracerVar(0),
+  numQPs     (dl->node_qp_scalar          ->dimension(2))
 {
   std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
 
@@ -64,6 +65,19 @@ ComputeAndScatterJacBase(const Teuchos::ParameterList& p,
   double HVcoef = p.get<double>("HV coefficient");
   sqrtHVcoef = std::sqrt(HVcoef);
 
+#ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  if (p.isParameter("HV Laplace Operator")) {
+    Teuchos::RCP<HVLaplaceOperator> op = p.get<Teuchos::RCP<HVLaplaceOperator> >("HV Laplace Operator");
+    if (Teuchos::nonnull(op) && op->isEnabled()) {
+      hvLaplace = op;
+      PHX::MDField<const MeshScalarT,Cell,QuadPoint,Dim,Dim> tmp(p.get<std::string>("Jacobian Inv Name"), dl->qp_tensor);
+      jacobian_inv  = tmp;
+      intrepidBasis = p.get<Teuchos::RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > >("Intrepid2 Basis");
+      cubature      = p.get<Teuchos::RCP<Intrepid2::Cubature<PHX::Device> > >("Cubature");
+      this->addDependentField(jacobian_inv);
+    }
+  }
+#endif
 }
 
 // **********************************************************************
@@ -78,6 +92,19 @@ postRegistrationSetup(typename Traits::SetupData d,
   this->utils.setFieldData(wGradBF,fm);
   this->utils.setFieldData(lambda_nodal,fm);
   this->utils.setFieldData(theta_nodal,fm);
+
+  if (Teuchos::nonnull(hvLaplace)) {
+    this->utils.setFieldData(jacobian_inv,fm);
+
+    Kokkos::DynRankView<RealType, PHX::Device> refPoints ("XXX", numQPs, 2);
+    Kokkos::DynRankView<RealType, PHX::Device> refWeights("XXX", numQPs);
+    Kokkos::DynRankView<RealType, PHX::Device> grad_at_cub_points("XXX", numNodes, numQPs, 2);
+    cubature->getCubature(refPoints, refWeights);
+    intrepidBasis->getValues(grad_at_cub_points, refPoints, Intrepid2::OPERATOR_GRAD);
+
+    hvLaplace->setup(numNodes, numQPs, numLevels, numNodeVar, numVectorLevelVar,
+                     numScalarLevelVar, numTracerVar, sqrtHVcoef, refPoints, grad_at_cub_points);
+  }
 }
 
 
@@ -416,7 +443,12 @@ evaluateFields(typename Traits::EvalData workset)
 
 
 ////////////////////////////////////////////////////////
-  if ( buildLaplace ) {
+  if ( buildLaplace && Teuchos::nonnull(this->hvLaplace) ) {
+    //HVDecorator applies the Laplace matrix-free, so only keep what it needs
+    this->hvLaplace->recordWorkset(workset.wsIndex, workset.numCells, this->jacobian_inv,
+                                   this->wBF, this->lambda_nodal, this->theta_nodal);
+  }
+  else if ( buildLaplace ) {
     int numn = this->numNodes;
     Kokkos::DynRankView<RealType, PHX::Device>  KK("KK", numn*3, numn*2);
     Kokkos::DynRankView<RealType, PHX::Device>  KT("KK", numn*2, numn*3);
@@ -14,6 +14,7 @@
 
 #include "Aeras_Layouts.hpp"
 #include "Aeras_Dimension.hpp"
+#include "Aeras_SpectralTensorBasis.hpp"
 
 namespace Aeras {
 /** \brief Finite Element Interpolation Evaluator
@@ -57,6 +58,16 @@ private:
   const int numQPs;
   const int numLevels;
 
+  // Optional sum-factorised path, enabled by passing "Jacobian Inv Name",
+  // "Intrepid2 Basis" and "Cubature" for a collocated tensor-product basis
+  bool useTensorBasis;
+  PHX::MDField<const MeshScalarT,Cell,QuadPoint,Dim,Dim> jacobian_inv;
+  Teuchos::RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > intrepidBasis;
+  Teuchos::RCP<Intrepid2::Cubature<PHX::Device> > cubature;
+  SpectralTensorBasis tensorBasis;
+  Kokkos::DynRankView<ScalarT, PHX::Device>     val_levels;
+  Kokkos::DynRankView<ScalarT, PHX::Device>     grad_ref;
+
 #ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT
 public:
   typedef Kokkos::View<int***, PHX::Device>::execution_space ExecutionSpace;
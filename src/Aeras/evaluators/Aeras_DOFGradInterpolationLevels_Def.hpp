@@ -23,12 +23,24 @@ DOFGradInterpolationLevels(Teuchos::ParameterList& p,
   numNodes   (dl->node_scalar             ->dimension(1)),
   numDims    (dl->node_qp_gradient        ->dimension(3)),
   numQPs     (dl->node_qp_scalar          ->dimension(2)),
-  numLevels  (dl->node_scalar_level       ->dimension(2))
+  numLevels  (dl->node_scalar_level       ->dimension(2)),
+  useTensorBasis (false)
 {
   this->addDependentField(val_node);
   this->addDependentField(GradBF);
   this->addEvaluatedField(grad_val_qp);
 
+#ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  if (p.isParameter("Jacobian Inv Name") && p.isParameter("Intrepid2 Basis") && p.isParameter("Cubature")) {
+    useTensorBasis = true;
+    PHX::MDField<const MeshScalarT,Cell,QuadPoint,Dim,Dim> tmp(p.get<std::string>("Jacobian Inv Name"), dl->qp_tensor);
+    jacobian_inv  = tmp;
+    intrepidBasis = p.get<Teuchos::RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > >("Intrepid2 Basis");
+    cubature      = p.get<Teuchos::RCP<Intrepid2::Cubature<PHX::Device> > >("Cubature");
+    this->addDependentField(jacobian_inv);
+  }
+#endif
+
   this->setName("Aeras::DOFGradInterpolationLevels"+PHX::typeAsString<EvalT>());
 
   //std::cout << "Aeras::DOFGradInterpolationLevels: " << numDims << " " << numQPs << " " << numLevels << std::endl;
@@ -43,6 +55,24 @@ postRegistrationSetup(typename Traits::SetupData d,
   this->utils.setFieldData(val_node,fm);
   this->utils.setFieldData(GradBF,fm);
   this->utils.setFieldData(grad_val_qp,fm);
+
+  if (useTensorBasis) {
+    this->utils.setFieldData(jacobian_inv,fm);
+
+    Kokkos::DynRankView<RealType, PHX::Device> refPoints ("XXX", numQPs, 2);
+    Kokkos::DynRankView<RealType, PHX::Device> refWeights("XXX", numQPs);
+    Kokkos::DynRankView<RealType, PHX::Device> grad_at_cub_points("XXX", numNodes, numQPs, 2);
+    cubature->getCubature(refPoints, refWeights);
+    intrepidBasis->getValues(grad_at_cub_points, refPoints, Intrepid2::OPERATOR_GRAD);
+
+    // Falls back to the dense loop below if the basis does not factorise
+    tensorBasis.setup(numNodes, numQPs, refPoints, grad_at_cub_points);
+    useTensorBasis = tensorBasis.isTensor() && numDims==2;
+    if (useTensorBasis) {
+      val_levels = Kokkos::createDynRankView(val_node.get_view(), "XXX", numNodes, numLevels);
+      grad_ref   = Kokkos::createDynRankView(val_node.get_view(), "XXX", numQPs, numLevels, 2);
+    }
+  }
 }
 
 //**********************************************************************
@@ -102,6 +132,28 @@ evaluateFields(typename Traits::EvalData workset)
   }
   */
 
+  if (useTensorBasis) {
+    // Sum-factorised reference gradient, mapped with the inverse Jacobian
+    // exactly as Intrepid2 HGRADtransformGRAD builds GradBF
+    for (int cell=0; cell < workset.numCells; ++cell) {
+      for (int node=0; node < numNodes; ++node)
+        for (int level=0; level < numLevels; ++level)
+          val_levels(node,level) = val_node(cell,node,level);
+
+      tensorBasis.gradient(val_levels, grad_ref, numLevels);
+
+      for (int qp=0; qp < numQPs; ++qp) {
+        for (int dim=0; dim<numDims; dim++) {
+          const MeshScalarT jinv0 = jacobian_inv(cell,qp,0,dim);
+          const MeshScalarT jinv1 = jacobian_inv(cell,qp,1,dim);
+          for (int level=0; level < numLevels; ++level)
+            grad_val_qp(cell,qp,level,dim) = jinv0*grad_ref(qp,level,0) + jinv1*grad_ref(qp,level,1);
+        }
+      }
+    }
+    return;
+  }
+
   for (int cell=0; cell < workset.numCells; ++cell) {
     for (int qp=0; qp < numQPs; ++qp) {
       for (int level=0; level < numLevels; ++level) {
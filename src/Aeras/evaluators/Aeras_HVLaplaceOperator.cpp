@@ -0,0 +1,190 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Aeras_HVLaplaceOperator.hpp"
+
+#include "Phalanx_KokkosDeviceTypes.hpp"
+#include "Teuchos_TestForException.hpp"
+
+namespace {
+// Single-level views of raw per-cell buffers for SpectralTensorBasis
+template<typename T>
+struct NodeAccessor {
+  T* v;
+  T& operator() (const int node, const int) const { return v[node]; }
+};
+template<typename T>
+struct QPAccessor {
+  T* v;
+  T& operator() (const int qp, const int, const int dim) const { return v[2*qp+dim]; }
+};
+} // namespace
+
+//**********************************************************************
+Aeras::HVLaplaceOperator::
+HVLaplaceOperator(const bool enabled_) :
+  enabled(enabled_),
+  numNodes(0), numQPs(0), numLevels(0),
+  numNodeVar(0), numVectorLevelVar(0), numScalarLevelVar(0), numTracerVar(0),
+  sqrtHVcoef(0)
+{
+}
+
+//**********************************************************************
+bool Aeras::HVLaplaceOperator::
+isRecorded(const int numWorksets) const
+{
+  if (!enabled || numQPs!=numNodes || static_cast<int>(recorded.size())!=numWorksets)
+    return false;
+  for (int ws=0; ws<numWorksets; ++ws)
+    if (!recorded[ws]) return false;
+  return true;
+}
+
+//**********************************************************************
+void Aeras::HVLaplaceOperator::
+initialize(const Teuchos::RCP<const Albany::AbstractDiscretization>& disc)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(!isRecorded(disc->getWsElNodeEqID().size()), std::logic_error,
+    "Error! Aeras::HVLaplaceOperator: not every workset was recorded by ComputeAndScatterJac.\n");
+
+  wsElNodeEqID = disc->getWsElNodeEqID();
+  importer = Teuchos::rcp(new Tpetra_Import(disc->getMapT(), disc->getOverlapMapT()));
+  exporter = Teuchos::rcp(new Tpetra_Export(disc->getOverlapMapT(), disc->getMapT()));
+  x_ov = Teuchos::rcp(new Tpetra_Vector(disc->getOverlapMapT()));
+  y_ov = Teuchos::rcp(new Tpetra_Vector(disc->getOverlapMapT()));
+}
+
+//**********************************************************************
+void Aeras::HVLaplaceOperator::
+lumpedMass(Tpetra_Vector& diag) const
+{
+  y_ov->putScalar(0.0);
+  {
+    Teuchos::ArrayRCP<ST> y_nonconstView = y_ov->get1dViewNonConst();
+    for (int ws=0; ws<static_cast<int>(numCells.size()); ++ws) {
+      const Albany::AbstractDiscretization::WorksetConn& nodeID = wsElNodeEqID[ws];
+      const int neq = nodeID.dimension(2);
+      for (int cell=0; cell<numCells[ws]; ++cell)
+        for (int node=0; node<numNodes; ++node)
+          for (int eq=0; eq<neq; ++eq)
+            y_nonconstView[nodeID(cell,node,eq)] += mass[ws][cell*numNodes+node];
+    }
+  }
+  diag.putScalar(0.0);
+  diag.doExport(*y_ov, *exporter, Tpetra::ADD);
+}
+
+//**********************************************************************
+void Aeras::HVLaplaceOperator::
+weakLaplace(const RealType* G, const RealType* u, RealType* grad, RealType* out) const
+{
+  if (tensorBasis.isTensor()) {
+    NodeAccessor<const RealType> u_acc = {u};
+    QPAccessor<RealType> grad_acc = {grad};
+    tensorBasis.gradient(u_acc, grad_acc, 1);
+  }
+  else {
+    for (int qp=0; qp<numQPs; ++qp) {
+      grad[2*qp] = grad[2*qp+1] = 0;
+      for (int node=0; node<numNodes; ++node) {
+        grad[2*qp]   += grad_ref[(node*numQPs+qp)*2]  *u[node];
+        grad[2*qp+1] += grad_ref[(node*numQPs+qp)*2+1]*u[node];
+      }
+    }
+  }
+
+  for (int qp=0; qp<numQPs; ++qp) {
+    const RealType r0 = grad[2*qp], r1 = grad[2*qp+1];
+    grad[2*qp]   = G[3*qp]  *r0 + G[3*qp+1]*r1;
+    grad[2*qp+1] = G[3*qp+1]*r0 + G[3*qp+2]*r1;
+  }
+
+  if (tensorBasis.isTensor()) {
+    QPAccessor<RealType> flux_acc = {grad};
+    NodeAccessor<RealType> out_acc = {out};
+    tensorBasis.gradientTranspose(flux_acc, out_acc, 1);
+  }
+  else {
+    for (int node=0; node<numNodes; ++node) {
+      out[node] = 0;
+      for (int qp=0; qp<numQPs; ++qp)
+        out[node] += grad_ref[(node*numQPs+qp)*2]  *grad[2*qp]
+                   + grad_ref[(node*numQPs+qp)*2+1]*grad[2*qp+1];
+    }
+  }
+}
+
+//**********************************************************************
+void Aeras::HVLaplaceOperator::
+apply(const Tpetra_Vector& x, Tpetra_Vector& y) const
+{
+  x_ov->doImport(x, *importer, Tpetra::INSERT);
+  y_ov->putScalar(0.0);
+
+  {
+    Teuchos::ArrayRCP<const ST> x_constView = x_ov->get1dView();
+    Teuchos::ArrayRCP<ST> y_nonconstView = y_ov->get1dViewNonConst();
+    const ST* xv = x_constView.getRawPtr();
+    ST* yv = y_nonconstView.getRawPtr();
+
+    // Dof layout of ComputeAndScatterJac: node vars, then per level the
+    // vector (u,v) and scalar vars, then per level the tracers
+    const int levelStride  = 2*numVectorLevelVar + numScalarLevelVar;
+    const int tracerOffset = numNodeVar + numLevels*levelStride;
+    const int numWorksets  = numCells.size();
+
+    // Every level writes its own dofs only, so levels run concurrently
+    Kokkos::parallel_for(Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0,numLevels),
+                         [&](const int level) {
+      std::vector<RealType> u(3*numNodes), out(3*numNodes), grad(2*numQPs);
+
+      for (int ws=0; ws<numWorksets; ++ws) {
+        const Albany::AbstractDiscretization::WorksetConn& nodeID = wsElNodeEqID[ws];
+        for (int cell=0; cell<numCells[ws]; ++cell) {
+          const RealType* G = &metric[ws][cell*numQPs*3];
+          const RealType* K = &kmat[ws][cell*numNodes*5];
+
+          // velocity: K^T L K, L acting on each xyz component
+          for (int j=0; j<numVectorLevelVar; ++j) {
+            const int n = numNodeVar + level*levelStride + 2*j;
+            for (int node=0; node<numNodes; ++node) {
+              const RealType* k = K + 5*node;
+              const ST uu = xv[nodeID(cell,node,n)];
+              const ST vv = xv[nodeID(cell,node,n+1)];
+              u[node]            = k[0]*uu + k[1]*vv;
+              u[numNodes+node]   = k[2]*uu + k[3]*vv;
+              u[2*numNodes+node] =           k[4]*vv;
+            }
+            for (int c=0; c<3; ++c)
+              weakLaplace(G, &u[c*numNodes], &grad[0], &out[c*numNodes]);
+            for (int node=0; node<numNodes; ++node) {
+              const RealType* k = K + 5*node;
+              yv[nodeID(cell,node,n)]   += sqrtHVcoef*(k[0]*out[node] + k[2]*out[numNodes+node]);
+              yv[nodeID(cell,node,n+1)] += sqrtHVcoef*(k[1]*out[node] + k[3]*out[numNodes+node]
+                                                     + k[4]*out[2*numNodes+node]);
+            }
+          }
+
+          // temperature and tracers: scalar weak Laplacian
+          for (int j=0; j<numScalarLevelVar+numTracerVar; ++j) {
+            const int n = j<numScalarLevelVar ?
+              numNodeVar + level*levelStride + 2*numVectorLevelVar + j :
+              tracerOffset + level*numTracerVar + (j-numScalarLevelVar);
+            for (int node=0; node<numNodes; ++node)
+              u[node] = xv[nodeID(cell,node,n)];
+            weakLaplace(G, &u[0], &grad[0], &out[0]);
+            for (int node=0; node<numNodes; ++node)
+              yv[nodeID(cell,node,n)] += sqrtHVcoef*out[node];
+          }
+        }
+      }
+    });
+  }
+
+  y.putScalar(0.0);
+  y.doExport(*y_ov, *exporter, Tpetra::ADD);
+}
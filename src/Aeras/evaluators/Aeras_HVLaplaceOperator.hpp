@@ -0,0 +1,169 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef AERAS_HVLAPLACE_OPERATOR_HPP
+#define AERAS_HVLAPLACE_OPERATOR_HPP
+
+#include <vector>
+
+#include "Albany_DataTypes.hpp"
+#include "Albany_AbstractDiscretization.hpp"
+#include "Aeras_SpectralTensorBasis.hpp"
+
+namespace Aeras {
+/** \brief Matrix-free weak Laplacian for the hydrostatic hyperviscosity
+
+    Applies the same operator that ComputeAndScatterJac assembles when the
+    Laplace flag (n_coeff == 1) is set: a scalar weak Laplacian for
+    temperature and tracers, and K^T L K for the velocity (K maps lon/lat
+    velocity to xyz), scaled by sqrt(HV coefficient). Surface pressure is
+    left out, as in the assembled operator.
+
+    Only what is needed to rebuild the element operators is stored: the
+    reference gradient (sum-factorised on GLL quads), the metric
+    w_q*Jinv*Jinv^T at every point, the K entries at every node and the
+    lumped mass. The element contributions are summed on the overlap map
+    and exported with ADD, which is the DSS the Jacobian export performs.
+
+    ComputeAndScatterJac records each workset during the Laplace
+    evaluation and then skips the assembly. HVDecorator then calls
+    initialize() and apply().
+*/
+
+class HVLaplaceOperator {
+
+public:
+
+  HVLaplaceOperator(const bool enabled);
+
+  bool isEnabled () const { return enabled; }
+
+  //! Basis and field layout, set by ComputeAndScatterJac
+  template<typename PointView, typename GradView>
+  void setup (const int numNodes, const int numQPs, const int numLevels,
+              const int numNodeVar, const int numVectorLevelVar,
+              const int numScalarLevelVar, const int numTracerVar,
+              const RealType sqrtHVcoef,
+              const PointView& refPoints, const GradView& grad_at_cub_points);
+
+  //! Store the geometry of workset ws
+  template<typename JacInvField, typename WBFField, typename NodalField>
+  void recordWorkset (const int ws, const int numCells,
+                      const JacInvField& jacobian_inv, const WBFField& wBF,
+                      const NodalField& lambda_nodal, const NodalField& theta_nodal);
+
+  //! True once every workset of the discretization has been recorded
+  bool isRecorded (const int numWorksets) const;
+
+  //! Build the owned <-> overlapped transfers
+  void initialize (const Teuchos::RCP<const Albany::AbstractDiscretization>& disc);
+
+  //! diag = lumped mass, assembled like ComputeAndScatterJac's buildMass
+  void lumpedMass (Tpetra_Vector& diag) const;
+
+  //! y = L x
+  void apply (const Tpetra_Vector& x, Tpetra_Vector& y) const;
+
+private:
+
+  //! out = weak Laplacian of u on one cell
+  void weakLaplace (const RealType* metric, const RealType* u,
+                    RealType* grad, RealType* out) const;
+
+  const bool enabled;
+
+  int numNodes, numQPs, numLevels;
+  int numNodeVar, numVectorLevelVar, numScalarLevelVar, numTracerVar;
+  RealType sqrtHVcoef;
+
+  SpectralTensorBasis tensorBasis;
+  //! Dense reference gradient (node,qp,dim), used when the basis does not factorise
+  std::vector<RealType> grad_ref;
+
+  //! Per workset: number of cells, metric (cell,qp,3), K (cell,node,5), mass (cell,node)
+  std::vector<int> numCells;
+  std::vector<std::vector<RealType> > metric, kmat, mass;
+  std::vector<bool> recorded;
+
+  Albany::AbstractDiscretization::Conn wsElNodeEqID;
+  Teuchos::RCP<Tpetra_Import> importer;
+  Teuchos::RCP<Tpetra_Export> exporter;
+  Teuchos::RCP<Tpetra_Vector> x_ov, y_ov;
+};
+
+//**********************************************************************
+template<typename PointView, typename GradView>
+void HVLaplaceOperator::
+setup (const int numNodes_, const int numQPs_, const int numLevels_,
+       const int numNodeVar_, const int numVectorLevelVar_,
+       const int numScalarLevelVar_, const int numTracerVar_,
+       const RealType sqrtHVcoef_,
+       const PointView& refPoints, const GradView& grad_at_cub_points)
+{
+  numNodes          = numNodes_;
+  numQPs            = numQPs_;
+  numLevels         = numLevels_;
+  numNodeVar        = numNodeVar_;
+  numVectorLevelVar = numVectorLevelVar_;
+  numScalarLevelVar = numScalarLevelVar_;
+  numTracerVar      = numTracerVar_;
+  sqrtHVcoef        = sqrtHVcoef_;
+
+  tensorBasis.setup(numNodes, numQPs, refPoints, grad_at_cub_points);
+
+  grad_ref.resize(numNodes*numQPs*2);
+  for (int node=0; node<numNodes; ++node)
+    for (int qp=0; qp<numQPs; ++qp)
+      for (int dim=0; dim<2; ++dim)
+        grad_ref[(node*numQPs+qp)*2+dim] = grad_at_cub_points(node,qp,dim);
+}
+
+//**********************************************************************
+template<typename JacInvField, typename WBFField, typename NodalField>
+void HVLaplaceOperator::
+recordWorkset (const int ws, const int numCells_,
+               const JacInvField& jacobian_inv, const WBFField& wBF,
+               const NodalField& lambda_nodal, const NodalField& theta_nodal)
+{
+  if (ws >= static_cast<int>(numCells.size())) {
+    numCells.resize(ws+1, 0);
+    metric.resize(ws+1);
+    kmat.resize(ws+1);
+    mass.resize(ws+1);
+    recorded.resize(ws+1, false);
+  }
+
+  numCells[ws] = numCells_;
+  metric[ws].resize(numCells_*numQPs*3);
+  kmat[ws].resize(numCells_*numNodes*5);
+  mass[ws].resize(numCells_*numNodes);
+
+  for (int cell=0; cell<numCells_; ++cell) {
+    for (int qp=0; qp<numQPs; ++qp) {
+      // The laplace integrand is GradBF.GradBF*wBF with GradBF = Jinv^T grad_ref
+      const RealType w = wBF(cell,qp,qp);
+      RealType* G = &metric[ws][(cell*numQPs+qp)*3];
+      G[0] = w*(jacobian_inv(cell,qp,0,0)*jacobian_inv(cell,qp,0,0) + jacobian_inv(cell,qp,0,1)*jacobian_inv(cell,qp,0,1));
+      G[1] = w*(jacobian_inv(cell,qp,0,0)*jacobian_inv(cell,qp,1,0) + jacobian_inv(cell,qp,0,1)*jacobian_inv(cell,qp,1,1));
+      G[2] = w*(jacobian_inv(cell,qp,1,0)*jacobian_inv(cell,qp,1,0) + jacobian_inv(cell,qp,1,1)*jacobian_inv(cell,qp,1,1));
+    }
+    for (int node=0; node<numNodes; ++node) {
+      const RealType lam = lambda_nodal(cell,node),
+                     th  = theta_nodal(cell,node);
+      RealType* K = &kmat[ws][(cell*numNodes+node)*5];
+      K[0] = -sin(lam);
+      K[1] = -sin(th)*cos(lam);
+      K[2] =  cos(lam);
+      K[3] = -sin(th)*sin(lam);
+      K[4] =  cos(th);
+      mass[ws][cell*numNodes+node] = wBF(cell,node,node);
+    }
+  }
+  recorded[ws] = true;
+}
+
+}
+#endif
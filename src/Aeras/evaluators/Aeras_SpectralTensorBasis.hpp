@@ -0,0 +1,200 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef AERAS_SPECTRAL_TENSOR_BASIS_HPP
+#define AERAS_SPECTRAL_TENSOR_BASIS_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "Albany_DataTypes.hpp"
+
+namespace Aeras {
+/** \brief Sum-factorised reference derivatives on spectral quads
+
+    On the GLL elements of the Aeras spectral discretization the nodes
+    coincide with the cubature points and the basis is the tensor product
+    of np 1D Lagrange polynomials. With node n=(i,j) and point q=(a,b) the
+    reference gradient is D(a,i)*delta(j,b) in xi and delta(i,a)*D(b,j)
+    in eta, so applying the 1D derivative matrix D along the lattice lines
+    through q costs O(np) per point instead of a dense sum over all np^2
+    nodes.
+
+    setup() recovers the lattice and D from the cubature points and the
+    full reference gradient and checks the factorisation entry by entry.
+    If it does not hold (e.g. non-collocated cubature) isTensor() returns
+    false and the caller should keep its dense loop.
+*/
+
+class SpectralTensorBasis {
+
+public:
+
+  SpectralTensorBasis() : np(0), tensor(false) {}
+
+  template<typename PointView, typename GradView>
+  void setup (const int numNodes, const int numQPs,
+              const PointView& refPoints, const GradView& grad_at_cub_points);
+
+  bool isTensor () const { return tensor; }
+
+  //! du(qp,level,dim) = reference gradient of u(node,level)
+  template<typename InView, typename OutView>
+  void gradient (const InView& u, const OutView& du, const int numLevels) const;
+
+  //! div(qp,level) = reference divergence of v(node,level,dim)
+  template<typename InView, typename OutView>
+  void divergence (const InView& v, const OutView& div, const int numLevels) const;
+
+  //! out(node,level) = sum_qp,dim grad_ref(node,qp,dim)*f(qp,level,dim), the transpose of gradient()
+  template<typename InView, typename OutView>
+  void gradientTranspose (const InView& f, const OutView& out, const int numLevels) const;
+
+private:
+
+  int  np;
+  bool tensor;
+
+  //! lattice[i+np*j] = node (and qp) index of lattice point (i,j)
+  std::vector<int> lattice;
+  //! ij[2*n], ij[2*n+1] = lattice coordinates of node n
+  std::vector<int> ij;
+  //! D[dim][a*np+i] = derivative of the i-th 1D basis at the a-th point
+  std::vector<RealType> D[2];
+};
+
+//**********************************************************************
+template<typename PointView, typename GradView>
+void SpectralTensorBasis::
+setup (const int numNodes, const int numQPs,
+       const PointView& refPoints, const GradView& grad_at_cub_points)
+{
+  tensor = false;
+  if (numNodes!=numQPs) return;
+
+  np = static_cast<int>(std::floor(std::sqrt(static_cast<double>(numQPs))+.1));
+  if (np<2 || np*np!=numQPs) return;
+
+  const RealType tol = 1.0e-10;
+
+  // Distinct 1D coordinates of the cubature points in each direction
+  std::vector<RealType> coords[2];
+  for (int dim=0; dim<2; ++dim) {
+    std::vector<RealType> sorted(numQPs);
+    for (int qp=0; qp<numQPs; ++qp) sorted[qp] = refPoints(qp,dim);
+    std::sort(sorted.begin(), sorted.end());
+    coords[dim].push_back(sorted[0]);
+    for (int qp=1; qp<numQPs; ++qp)
+      if (sorted[qp]-coords[dim].back() > tol) coords[dim].push_back(sorted[qp]);
+    if (coords[dim].size()!=static_cast<std::size_t>(np)) return;
+  }
+
+  lattice.assign(numQPs,-1);
+  ij.assign(2*numQPs,-1);
+  for (int qp=0; qp<numQPs; ++qp) {
+    for (int dim=0; dim<2; ++dim) {
+      for (int k=0; k<np; ++k)
+        if (std::fabs(refPoints(qp,dim)-coords[dim][k]) <= tol) ij[2*qp+dim] = k;
+      if (ij[2*qp+dim]<0) return;
+    }
+    int& l = lattice[ij[2*qp]+np*ij[2*qp+1]];
+    if (l>=0) return;
+    l = qp;
+  }
+
+  // D along xi from the line b=0, along eta from the line a=0
+  D[0].assign(np*np,0);
+  D[1].assign(np*np,0);
+  for (int a=0; a<np; ++a) {
+    for (int i=0; i<np; ++i) {
+      D[0][a*np+i] = grad_at_cub_points(lattice[i],    lattice[a],    0);
+      D[1][a*np+i] = grad_at_cub_points(lattice[np*i], lattice[np*a], 1);
+    }
+  }
+
+  RealType scale = 0;
+  for (int k=0; k<np*np; ++k)
+    scale = std::max(scale, std::max(std::fabs(D[0][k]), std::fabs(D[1][k])));
+
+  for (int node=0; node<numNodes; ++node) {
+    const int i = ij[2*node], j = ij[2*node+1];
+    for (int qp=0; qp<numQPs; ++qp) {
+      const int a = ij[2*qp], b = ij[2*qp+1];
+      const RealType g0 = j==b ? D[0][a*np+i] : 0;
+      const RealType g1 = i==a ? D[1][b*np+j] : 0;
+      if (std::fabs(grad_at_cub_points(node,qp,0)-g0) > tol*scale ||
+          std::fabs(grad_at_cub_points(node,qp,1)-g1) > tol*scale) return;
+    }
+  }
+
+  tensor = true;
+}
+
+//**********************************************************************
+template<typename InView, typename OutView>
+void SpectralTensorBasis::
+gradient (const InView& u, const OutView& du, const int numLevels) const
+{
+  for (int qp=0; qp<np*np; ++qp) {
+    const int a = ij[2*qp], b = ij[2*qp+1];
+    for (int level=0; level<numLevels; ++level) {
+      du(qp,level,0) = 0;
+      du(qp,level,1) = 0;
+    }
+    for (int k=0; k<np; ++k) {
+      const RealType dx = D[0][a*np+k];
+      const RealType dy = D[1][b*np+k];
+      const int nx = lattice[k+np*b];
+      const int ny = lattice[a+np*k];
+      for (int level=0; level<numLevels; ++level) {
+        du(qp,level,0) += dx*u(nx,level);
+        du(qp,level,1) += dy*u(ny,level);
+      }
+    }
+  }
+}
+
+//**********************************************************************
+template<typename InView, typename OutView>
+void SpectralTensorBasis::
+divergence (const InView& v, const OutView& div, const int numLevels) const
+{
+  for (int qp=0; qp<np*np; ++qp) {
+    const int a = ij[2*qp], b = ij[2*qp+1];
+    for (int level=0; level<numLevels; ++level) div(qp,level) = 0;
+    for (int k=0; k<np; ++k) {
+      const RealType dx = D[0][a*np+k];
+      const RealType dy = D[1][b*np+k];
+      const int nx = lattice[k+np*b];
+      const int ny = lattice[a+np*k];
+      for (int level=0; level<numLevels; ++level)
+        div(qp,level) += dx*v(nx,level,0) + dy*v(ny,level,1);
+    }
+  }
+}
+
+//**********************************************************************
+template<typename InView, typename OutView>
+void SpectralTensorBasis::
+gradientTranspose (const InView& f, const OutView& out, const int numLevels) const
+{
+  for (int node=0; node<np*np; ++node) {
+    const int i = ij[2*node], j = ij[2*node+1];
+    for (int level=0; level<numLevels; ++level) out(node,level) = 0;
+    for (int k=0; k<np; ++k) {
+      const RealType dx = D[0][k*np+i];
+      const RealType dy = D[1][k*np+j];
+      const int qx = lattice[k+np*j];
+      const int qy = lattice[i+np*k];
+      for (int level=0; level<numLevels; ++level)
+        out(node,level) += dx*f(qx,level,0) + dy*f(qy,level,1);
+    }
+  }
+}
+
+}
+#endif
@@ -14,6 +14,7 @@
 
 #include "Aeras_Layouts.hpp"
 #include "Aeras_Dimension.hpp"
+#include "Aeras_SpectralTensorBasis.hpp"
 
 namespace Aeras {
 /** \brief Finite Element Interpolation Evaluator
@@ -63,6 +64,11 @@ private:
   Kokkos::DynRankView<RealType, PHX::Device>    grad_at_cub_points;
   Kokkos::DynRankView<ScalarT, PHX::Device>     vco;
 
+  //! Sum-factorised path, used when the basis is a collocated tensor product
+  SpectralTensorBasis tensorBasis;
+  Kokkos::DynRankView<ScalarT, PHX::Device>     vco_levels;
+  Kokkos::DynRankView<ScalarT, PHX::Device>     vort_ref;
+
   const int numNodes;
   const int numDims;
   const int numQPs;
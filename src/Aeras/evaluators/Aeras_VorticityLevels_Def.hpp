@@ -60,6 +60,14 @@ postRegistrationSetup(typename Traits::SetupData d,
   intrepidBasis->getValues(grad_at_cub_points, refPoints, Intrepid2::OPERATOR_GRAD);
 
   vco = Kokkos::createDynRankView(val_node.get_view(), "XXX", numNodes, 2);
+
+#ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  tensorBasis.setup(numNodes, numQPs, refPoints, grad_at_cub_points);
+  if (tensorBasis.isTensor()) {
+    vco_levels = Kokkos::createDynRankView(val_node.get_view(), "XXX", numNodes, numLevels, 2);
+    vort_ref   = Kokkos::createDynRankView(val_node.get_view(), "XXX", numQPs, numLevels);
+  }
+#endif
 }
 
 //**********************************************************************
@@ -131,24 +139,50 @@ evaluateFields(typename Traits::EvalData workset)
     }
   }
 #else
-  for (int cell=0; cell < workset.numCells; ++cell) {
-    for (int level=0; level < numLevels; ++level) {
-      for (std::size_t node=0; node < numNodes; ++node) {
-	const MeshScalarT j00 = jacobian(cell, node, 0, 0);
-	const MeshScalarT j01 = jacobian(cell, node, 0, 1);
-	const MeshScalarT j10 = jacobian(cell, node, 1, 0);
-	const MeshScalarT j11 = jacobian(cell, node, 1, 1);
+  if (tensorBasis.isTensor()) {
+    // The curl is the reference divergence of (vco1, -vco0), sum-factorised
+    for (int cell=0; cell < workset.numCells; ++cell) {
+      for (int node=0; node < numNodes; ++node) {
+        const MeshScalarT j00 = jacobian(cell, node, 0, 0);
+        const MeshScalarT j01 = jacobian(cell, node, 0, 1);
+        const MeshScalarT j10 = jacobian(cell, node, 1, 0);
+        const MeshScalarT j11 = jacobian(cell, node, 1, 1);
 
-	vco(node, 0 ) = j00*val_node(cell, node, level, 0) + j10*val_node(cell, node, level, 1);
-	vco(node, 1 ) = j01*val_node(cell, node, level, 0) + j11*val_node(cell, node, level, 1);
+        for (int level=0; level < numLevels; ++level) {
+          vco_levels(node, level, 0) =   j01*val_node(cell, node, level, 0) + j11*val_node(cell, node, level, 1);
+          vco_levels(node, level, 1) = -(j00*val_node(cell, node, level, 0) + j10*val_node(cell, node, level, 1));
+        }
       }
 
-      for (std::size_t qp=0; qp < numQPs; ++qp) {
+      tensorBasis.divergence(vco_levels, vort_ref, numLevels);
+
+      for (int qp=0; qp < numQPs; ++qp) {
+        const MeshScalarT rdet_j = 1.0/jacobian_det(cell,qp);
+        for (int level=0; level < numLevels; ++level)
+          vort_val_qp(cell,qp,level) = vort_ref(qp,level)*rdet_j;
+      }
+    }
+  }
+  else {
+    for (int cell=0; cell < workset.numCells; ++cell) {
+      for (int level=0; level < numLevels; ++level) {
         for (std::size_t node=0; node < numNodes; ++node) {
-	  vort_val_qp(cell,qp,level) += vco(node, 1)*grad_at_cub_points(node, qp,0)
-            	                     - vco(node, 0)*grad_at_cub_points(node, qp,1);
-	}
-	vort_val_qp(cell,qp,level) /= jacobian_det(cell,qp);
+          const MeshScalarT j00 = jacobian(cell, node, 0, 0);
+          const MeshScalarT j01 = jacobian(cell, node, 0, 1);
+          const MeshScalarT j10 = jacobian(cell, node, 1, 0);
+          const MeshScalarT j11 = jacobian(cell, node, 1, 1);
+
+          vco(node, 0 ) = j00*val_node(cell, node, level, 0) + j10*val_node(cell, node, level, 1);
+          vco(node, 1 ) = j01*val_node(cell, node, level, 0) + j11*val_node(cell, node, level, 1);
+        }
+
+        for (std::size_t qp=0; qp < numQPs; ++qp) {
+          for (std::size_t node=0; node < numNodes; ++node) {
+            vort_val_qp(cell,qp,level) += vco(node, 1)*grad_at_cub_points(node, qp,0)
+                                           - vco(node, 0)*grad_at_cub_points(node, qp,1);
+          }
+          vort_val_qp(cell,qp,level) /= jacobian_det(cell,qp);
+        }
       }
     }
   }
@@ -0,0 +1,97 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef AERAS_XZHYDROSTATIC_COLUMNPHYSICS_HPP
+#define AERAS_XZHYDROSTATIC_COLUMNPHYSICS_HPP
+
+#include <vector>
+
+#include "Phalanx_config.hpp"
+#include "Phalanx_Evaluator_WithBaseImpl.hpp"
+#include "Phalanx_Evaluator_Derived.hpp"
+#include "Phalanx_MDField.hpp"
+#include "Aeras_Layouts.hpp"
+#include "Aeras_Dimension.hpp"
+#include "Aeras_Eta.hpp"
+
+namespace Aeras {
+/** \brief Nodal column quantities for the (XZ)Hydrostatic models
+
+    Computes in a single bottom-up sweep of each node column what
+    XZHydrostatic_Pressure, XZHydrostatic_VirtualT, XZHydrostatic_Density
+    and XZHydrostatic_GeoPotential compute separately:
+      Pressure = A*P0 + B*Ps,  Pi = (p(level+1/2) - p(level-1/2))/delta
+      Tv = T + (Rv/R-1)*T*qv/Pi,  Cpstar = Cp + (Cpv-Cp)*qv/Pi
+      Density = Pressure/(R*T)
+      Phi = PhiSurf + sum of Pi*delta/Density below the level (half of its own)
+    The geopotential is accumulated on the way up, so the column costs
+    O(numLevels). In the non-Kokkos build the node loop is innermost so
+    the Residual sweep vectorises across the nodes of a cell.
+*/
+template<typename EvalT, typename Traits>
+class XZHydrostatic_ColumnPhysics : public PHX::EvaluatorWithBaseImpl<Traits>,
+                   public PHX::EvaluatorDerived<EvalT, Traits> {
+
+public:
+  typedef typename EvalT::ScalarT ScalarT;
+  typedef typename EvalT::MeshScalarT MeshScalarT;
+
+  XZHydrostatic_ColumnPhysics(const Teuchos::ParameterList& p,
+                const Teuchos::RCP<Aeras::Layouts>& dl);
+
+  void postRegistrationSetup(typename Traits::SetupData d,
+			     PHX::FieldManager<Traits>& vm);
+
+  void evaluateFields(typename Traits::EvalData d);
+
+private:
+  // Input
+  PHX::MDField<const ScalarT,Cell,Node>       Ps;
+  PHX::MDField<const ScalarT,Cell,Node>       PhiSurf;
+  PHX::MDField<const ScalarT,Cell,Node,Level> temperature;
+  PHX::MDField<const ScalarT,Cell,Node,Level> qv;
+
+  // Output:
+  PHX::MDField<ScalarT,Cell,Node,Level> Pressure;
+  PHX::MDField<ScalarT,Cell,Node,Level> Pi;
+  PHX::MDField<ScalarT,Cell,Node,Level> virt_t;
+  PHX::MDField<ScalarT,Cell,Node,Level> Cpstar;
+  PHX::MDField<ScalarT,Cell,Node,Level> density;
+  PHX::MDField<ScalarT,Cell,Node,Level> Phi;
+
+  const Teuchos::ArrayRCP<std::string> tracerNames;
+
+  const int numNodes;
+  const int numLevels;
+  const Eta<EvalT> &E;
+  const ScalarT P0, Ptop;
+  bool vapor;
+  const double Cp;
+  double Cpv;
+  double R;
+  double factor;
+
+  //! Per node state of the sweep: pressure at the level, interface pressure below it, geopotential below it
+  std::vector<ScalarT> p_col, pp_col, phi_col;
+
+#ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  Kokkos::DynRankView<ScalarT, PHX::Device> A, B, delta;
+
+public:
+  typedef Kokkos::View<int***, PHX::Device>::execution_space ExecutionSpace;
+
+  struct XZHydrostatic_ColumnPhysics_Tag{};
+
+  typedef Kokkos::RangePolicy<ExecutionSpace, XZHydrostatic_ColumnPhysics_Tag> XZHydrostatic_ColumnPhysics_Policy;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const XZHydrostatic_ColumnPhysics_Tag& tag, const int& i) const;
+
+#endif
+};
+}
+
+#endif
@@ -0,0 +1,193 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Teuchos_TestForException.hpp"
+#include "Teuchos_VerboseObject.hpp"
+#include "Teuchos_RCP.hpp"
+#include "Phalanx_DataLayout.hpp"
+#include "Albany_Utils.hpp"
+
+#include "Aeras_Layouts.hpp"
+#include "Aeras_Eta.hpp"
+
+namespace Aeras {
+
+//**********************************************************************
+template<typename EvalT, typename Traits>
+XZHydrostatic_ColumnPhysics<EvalT, Traits>::
+XZHydrostatic_ColumnPhysics(const Teuchos::ParameterList& p,
+              const Teuchos::RCP<Aeras::Layouts>& dl) :
+  Ps          (p.get<std::string> ("Pressure Level 0"),     dl->node_scalar),
+  PhiSurf     (p.get<std::string> ("SurfaceGeopotential"),  dl->node_scalar),
+  temperature (p.get<std::string> ("Temperature"),          dl->node_scalar_level),
+  Pressure    (p.get<std::string> ("Pressure"),             dl->node_scalar_level),
+  Pi          (p.get<std::string> ("Pi"),                   dl->node_scalar_level),
+  virt_t      (p.get<std::string> ("Virtual_Temperature"),  dl->node_scalar_level),
+  Cpstar      (p.get<std::string> ("Cpstar"),               dl->node_scalar_level),
+  density     (p.get<std::string> ("Density"),              dl->node_scalar_level),
+  Phi         (p.get<std::string> ("GeoPotential"),         dl->node_scalar_level),
+  tracerNames (p.get< Teuchos::ArrayRCP<std::string> >("Tracer Names")),
+
+  numNodes ( dl->node_scalar          ->dimension(1)),
+  numLevels( dl->node_scalar_level    ->dimension(2)),
+  E    (Eta<EvalT>::self()),
+  P0   (E.p0()),
+  Ptop (E.ptop()),
+  vapor(false),
+  Cp   (p.isParameter("XZHydrostatic Problem") ?
+          p.get<Teuchos::ParameterList*>("XZHydrostatic Problem")->get<double>("Cp", 1005.7):
+          p.get<Teuchos::ParameterList*>("Hydrostatic Problem")->get<double>("Cp", 1005.7))
+{
+  // Same constants as XZHydrostatic_VirtualT and XZHydrostatic_Density
+  Cpv = 1870.0; // (J/kgK)
+  R   = 287.0;
+  factor = 461.5/R - 1.0;
+
+  for (int j=0; j<tracerNames.size() && !vapor; ++j)
+    if (tracerNames[j] == "Vapor") vapor = true;
+
+  if (vapor) {
+    qv = decltype(qv)("Vapor", dl->node_scalar_level);
+    this->addDependentField(qv);
+  }
+
+  this->addDependentField(Ps);
+  this->addDependentField(PhiSurf);
+  this->addDependentField(temperature);
+
+  this->addEvaluatedField(Pressure);
+  this->addEvaluatedField(Pi);
+  this->addEvaluatedField(virt_t);
+  this->addEvaluatedField(Cpstar);
+  this->addEvaluatedField(density);
+  this->addEvaluatedField(Phi);
+  this->setName("Aeras::XZHydrostatic_ColumnPhysics" + PHX::typeAsString<EvalT>());
+
+#ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  A = E.A_kokkos;
+  B = E.B_kokkos;
+  delta = E.delta_kokkos;
+#endif
+}
+
+//**********************************************************************
+template<typename EvalT, typename Traits>
+void XZHydrostatic_ColumnPhysics<EvalT, Traits>::
+postRegistrationSetup(typename Traits::SetupData d,
+                      PHX::FieldManager<Traits>& fm)
+{
+  this->utils.setFieldData(Ps          ,fm);
+  this->utils.setFieldData(PhiSurf     ,fm);
+  this->utils.setFieldData(temperature ,fm);
+  if (vapor) this->utils.setFieldData(qv, fm);
+  this->utils.setFieldData(Pressure    ,fm);
+  this->utils.setFieldData(Pi          ,fm);
+  this->utils.setFieldData(virt_t      ,fm);
+  this->utils.setFieldData(Cpstar      ,fm);
+  this->utils.setFieldData(density     ,fm);
+  this->utils.setFieldData(Phi         ,fm);
+
+  p_col  .resize(numNodes);
+  pp_col .resize(numNodes);
+  phi_col.resize(numNodes);
+}
+
+//**********************************************************************
+// Kokkos kernels
+#ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+template<typename EvalT, typename Traits>
+KOKKOS_INLINE_FUNCTION
+void XZHydrostatic_ColumnPhysics<EvalT, Traits>::
+operator() (const XZHydrostatic_ColumnPhysics_Tag& tag, const int& cell) const{
+  for (int node=0; node < numNodes; ++node) {
+    ScalarT p   = A(numLevels-1)*P0 + B(numLevels-1)*Ps(cell,node);
+    ScalarT pp  = Ps(cell,node);
+    ScalarT phi = PhiSurf(cell,node);
+    for (int level=numLevels-1; level >= 0; --level) {
+      const ScalarT p_above = level ? A(level-1)*P0 + B(level-1)*Ps(cell,node) : ScalarT(0);
+      const ScalarT pm      = level ? 0.5*( p + p_above ) : Ptop;
+      const ScalarT pi      = (pp - pm)/delta(level);
+      const ScalarT T       = temperature(cell,node,level);
+      const ScalarT rho     = p/(R*T);
+      const ScalarT dphi    = pi*delta(level)/rho;
+
+      Pressure(cell,node,level) = p;
+      Pi      (cell,node,level) = pi;
+      density (cell,node,level) = rho;
+      Phi     (cell,node,level) = phi + 0.5*dphi;
+      if (vapor) {
+        const ScalarT q = qv(cell,node,level)/pi;
+        virt_t(cell,node,level) = T + factor*T*q;
+        Cpstar(cell,node,level) = Cp + (Cpv - Cp)*q;
+      } else {
+        virt_t(cell,node,level) = T;
+        Cpstar(cell,node,level) = Cp;
+      }
+
+      phi += dphi;
+      pp   = pm;
+      p    = p_above;
+    }
+  }
+}
+#endif
+
+//**********************************************************************
+template<typename EvalT, typename Traits>
+void XZHydrostatic_ColumnPhysics<EvalT, Traits>::
+evaluateFields(typename Traits::EvalData workset)
+{
+#ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  for (int cell=0; cell < workset.numCells; ++cell) {
+    for (int node=0; node < numNodes; ++node) {
+      p_col[node]   = E.A(numLevels-1)*P0 + E.B(numLevels-1)*Ps(cell,node);
+      pp_col[node]  = Ps(cell,node);
+      phi_col[node] = PhiSurf(cell,node);
+    }
+    // Bottom-up: the interface below a level is known from the previous
+    // (lower) level, the geopotential is the running sum of the layers below
+    for (int level=numLevels-1; level >= 0; --level) {
+      const ScalarT delta = E.delta(level);
+      for (int node=0; node < numNodes; ++node) {
+        const ScalarT p       = p_col[node];
+        const ScalarT p_above = level ? E.A(level-1)*P0 + E.B(level-1)*Ps(cell,node) : ScalarT(0);
+        const ScalarT pm      = level ? 0.5*( p + p_above ) : Ptop;
+        const ScalarT pi      = (pp_col[node] - pm)/delta;
+        const ScalarT T       = temperature(cell,node,level);
+        const ScalarT rho     = p/(R*T);
+        const ScalarT dphi    = pi*delta/rho;
+
+        Pressure(cell,node,level) = p;
+        Pi      (cell,node,level) = pi;
+        density (cell,node,level) = rho;
+        Phi     (cell,node,level) = phi_col[node] + 0.5*dphi;
+
+        phi_col[node] += dphi;
+        pp_col[node]   = pm;
+        p_col[node]    = p_above;
+      }
+      if (vapor) {
+        for (int node=0; node < numNodes; ++node) {
+          const ScalarT T = temperature(cell,node,level);
+          const ScalarT q = qv(cell,node,level)/Pi(cell,node,level);
+          virt_t(cell,node,level) = T + factor*T*q;
+          Cpstar(cell,node,level) = Cp + (Cpv - Cp)*q;
+        }
+      } else {
+        for (int node=0; node < numNodes; ++node) {
+          virt_t(cell,node,level) = temperature(cell,node,level);
+          Cpstar(cell,node,level) = Cp;
+        }
+      }
+    }
+  }
+
+#else
+  Kokkos::parallel_for(XZHydrostatic_ColumnPhysics_Policy(0,workset.numCells),*this);
+  cudaCheckError();
+#endif
+}
+}
@@ -118,10 +118,10 @@ operator() (const XZHydrostatic_EtaDotPi_Tag& tag, const int& cell) const{
     for (int level=0; level < numLevels; ++level) pdotp0 -= divpivelx(cell,qp,level) * delta(level);
 
     //etadotpi(level) shifted by 1/2
+    ScalarT integral = 0;
     for (int level=0; level < numLevels; ++level) {
       //define etadotpi on interfaces
-      ScalarT integral = 0;
-      for (int j=0; j<=level; ++j) integral += divpivelx(cell,qp,j) * delta(j);
+      integral += divpivelx(cell,qp,level) * delta(level);
 
       etadotpi(cell,level) = -b(level+1)*pdotp0 - integral;
     }
@@ -241,10 +241,10 @@ evaluateFields(typename Traits::EvalData workset)
 
         ScalarT pdotp0 = 0;
 	for (int level=0; level < numLevels; ++level) pdotp0 -= divpivelx(cell,qp,level) * E.delta(level);
+	ScalarT integral = 0;
 	for (int level=0; level < numLevels; ++level) {
 	  //define etadotpi on interfaces
-	  ScalarT integral = 0;
-	  for (int j=0; j<=level; ++j) integral += divpivelx(cell,qp,j) * E.delta(j);
+	  integral += divpivelx(cell,qp,level) * E.delta(level);
 	  etadotpi[level] = -E.B(level+.5)*pdotp0 - integral;
 	}
 	etadotpi[0] = etadotpi[numLevels] = 0;
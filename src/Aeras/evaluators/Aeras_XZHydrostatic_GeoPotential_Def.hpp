@@ -75,13 +75,12 @@ KOKKOS_INLINE_FUNCTION
 void XZHydrostatic_GeoPotential<EvalT, Traits>::
 operator() (const XZHydrostatic_GeoPotential_Tag& tag, const int& cell) const{
   for (int node=0; node < numNodes; ++node) {
-    for (int level=0; level < numLevels; ++level) {
-      ScalarT sum =
-      PhiSurf(cell,node) +
-      0.5 * Pi(cell,node,level) * delta(level) / density(cell,node,level);
-      for (int j=level+1; j < numLevels; ++j) sum += Pi(cell,node,j)     * delta(j)     / density(cell,node,j);
-
-      Phi(cell,node,level) = sum;
+    // Integrate upwards from the surface; sum holds the levels below
+    ScalarT sum = PhiSurf(cell,node);
+    for (int level=numLevels-1; level >= 0; --level) {
+      const ScalarT dphi = Pi(cell,node,level) * delta(level) / density(cell,node,level);
+      Phi(cell,node,level) = sum + 0.5 * dphi;
+      sum += dphi;
     }
   }
 }
@@ -96,16 +95,12 @@ evaluateFields(typename Traits::EvalData workset)
 #ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
   for (int cell=0; cell < workset.numCells; ++cell) {
     for (int node=0; node < numNodes; ++node) {
-      for (int level=0; level < numLevels; ++level) {
-        ScalarT sum =
-        PhiSurf(cell,node) +
-        0.5 * Pi(cell,node,level) * E.delta(level) / density(cell,node,level);
-        for (int j=level+1; j < numLevels; ++j) sum += Pi(cell,node,j)     * E.delta(j)     / density(cell,node,j);
-
-        Phi(cell,node,level) = sum;
-        
-        //std::cout <<"Inside GeoP, cell, node, PhiSurf(cell,node)="<<cell<<
-        //", "<<node<<", "<<PhiSurf(cell,node) <<std::endl;
+      // Integrate upwards from the surface; sum holds the levels below
+      ScalarT sum = PhiSurf(cell,node);
+      for (int level=numLevels-1; level >= 0; --level) {
+        const ScalarT dphi = Pi(cell,node,level) * E.delta(level) / density(cell,node,level);
+        Phi(cell,node,level) = sum + 0.5 * dphi;
+        sum += dphi;
       }
     }
   }
@@ -75,11 +75,13 @@ KOKKOS_INLINE_FUNCTION
 void XZHydrostatic_Omega<EvalT, Traits>::
 operator() (const XZHydrostatic_Omega_Tag& tag, const int& cell) const{
   for (int qp=0; qp < numQPs; ++qp) {
+    // integral = sum of divpivelx*delta over the levels above
+    ScalarT integral = 0;
     for (int level=0; level < numLevels; ++level) {
-      ScalarT                               sum  = -0.5*divpivelx(cell,qp,level) * delta(level);
-      for (int j=0; j<level; ++j)           sum -=     divpivelx(cell,qp,j)     * delta(j);
+      ScalarT                               sum  = -0.5*divpivelx(cell,qp,level) * delta(level) - integral;
       for (int dim=0; dim < numDims; ++dim) sum += Velocity(cell,qp,level,dim)*gradp(cell,qp,level,dim);
       omega(cell,qp,level) = sum/(Cpstar(cell,qp,level)*density(cell,qp,level));
+      integral += divpivelx(cell,qp,level) * delta(level);
     }
   }
 }
@@ -94,11 +96,13 @@ evaluateFields(typename Traits::EvalData workset)
 #ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
   for (int cell=0; cell < workset.numCells; ++cell) {
     for (int qp=0; qp < numQPs; ++qp) {
+      // integral = sum of divpivelx*delta over the levels above
+      ScalarT integral = 0;
       for (int level=0; level < numLevels; ++level) {
-        ScalarT                               sum  = -0.5*divpivelx(cell,qp,level) * E.delta(level);
-        for (int j=0; j<level; ++j)           sum -=     divpivelx(cell,qp,j)     * E.delta(j);
+        ScalarT                               sum  = -0.5*divpivelx(cell,qp,level) * E.delta(level) - integral;
         for (int dim=0; dim < numDims; ++dim) sum += Velocity(cell,qp,level,dim)*gradp(cell,qp,level,dim);
         omega(cell,qp,level) = sum/(Cpstar(cell,qp,level)*density(cell,qp,level));
+        integral += divpivelx(cell,qp,level) * E.delta(level);
       }
     }
   }
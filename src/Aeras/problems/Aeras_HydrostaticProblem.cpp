@@ -33,6 +33,9 @@ HydrostaticProblem( const Teuchos::RCP<Teuchos::ParameterList>& params_,
 
   neq       = 1 + (3*numLevels) + (numTracers*numLevels);
 
+  hvLaplace = Teuchos::rcp(new Aeras::HVLaplaceOperator(
+      params_->sublist("Hydrostatic Problem").get<bool>("Matrix-Free Hyperviscosity", true)));
+
   // Set the num PDEs for the null space object to pass to ML
   this->rigidBodyModes->setNumPDEs(neq);
 }
@@ -448,6 +451,13 @@ HydrostaticProblem::constructEvaluators<PHAL::AlbanyTraits::Jacobian>(
 
     p->set<double>("HV coefficient", HVcoef);
 
+    if (numDim == 2) {
+      p->set< RCP<Aeras::HVLaplaceOperator> >("HV Laplace Operator", hvLaplace);
+      p->set<string>("Jacobian Inv Name", "Jacobian Inv");
+      p->set< RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > >("Intrepid2 Basis", intrepidBasis);
+      p->set< RCP<Intrepid2::Cubature<PHX::Device> > >("Cubature", cubature);
+    }
+
     ev = rcp(new Aeras::ComputeAndScatterJac<EvalT,AlbanyTraits>(*p,dl));
     fm0.registerEvaluator<EvalT>(ev);
   }
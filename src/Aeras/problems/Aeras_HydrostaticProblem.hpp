@@ -18,6 +18,7 @@
 #include "Aeras_GatherSolution.hpp"
 #include "Aeras_ScatterResidual.hpp"
 #include "Aeras_ComputeAndScatterJac.hpp"
+#include "Aeras_HVLaplaceOperator.hpp"
 #include "Aeras_DOFInterpolation.hpp"
 #include "Aeras_DOFInterpolationLevels.hpp"
 #include "Aeras_DOFVecInterpolationLevels.hpp"
@@ -27,6 +28,7 @@
 #include "Aeras_DOFDInterpolationLevels.hpp"
 #include "Aeras_DOFGradInterpolationLevels.hpp"
 #include "Aeras_Atmosphere_Moisture.hpp"
+#include "Aeras_XZHydrostatic_ColumnPhysics.hpp"
 #include "Aeras_XZHydrostatic_Density.hpp"
 #include "Aeras_XZHydrostatic_EtaDotPi.hpp"
 #include "Aeras_XZHydrostatic_GeoPotential.hpp"
@@ -125,8 +127,12 @@ namespace Aeras {
     void constructDirichletEvaluators(const Albany::MeshSpecsStruct& meshSpecs);
     void constructNeumannEvaluators(const Teuchos::RCP<Albany::MeshSpecsStruct>& meshSpecs);
 
+    //! Matrix-free hyperviscosity Laplacian, filled by the Jacobian evaluation
+    Teuchos::RCP<Aeras::HVLaplaceOperator> getHVLaplaceOperator() const { return hvLaplace; }
+
   protected:
     Teuchos::RCP<Aeras::Layouts> dl;
+    Teuchos::RCP<Aeras::HVLaplaceOperator> hvLaplace;
     const Teuchos::ArrayRCP<std::string> dof_names_tracers;
     const int numDim;
     const int numLevels;
@@ -314,6 +320,9 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Variable Name", dof_names_tracers[t]);
     p->set<string>("Gradient BF Name", "Grad BF");
     p->set<string>("Gradient Variable Name", dof_names_tracers_gradient[t]);
+    p->set<string>("Jacobian Inv Name", "Jacobian Inv");
+    p->set< RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > >("Intrepid2 Basis", intrepidBasis);
+    p->set< RCP<Intrepid2::Cubature<PHX::Device> > >("Cubature", cubature);
 
     ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
@@ -431,6 +440,9 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Variable Name", dof_names_levels[1]);
     p->set<string>("Gradient BF Name", "Grad BF");
     p->set<string>("Gradient Variable Name", dof_names_levels_gradient[1]);
+    p->set<string>("Jacobian Inv Name", "Jacobian Inv");
+    p->set< RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > >("Intrepid2 Basis", intrepidBasis);
+    p->set< RCP<Intrepid2::Cubature<PHX::Device> > >("Cubature", cubature);
     
     ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
@@ -470,6 +482,9 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Variable Name", "KineticEnergy");
     p->set<string>("Gradient BF Name", "Grad BF");
     p->set<string>("Gradient Variable Name", "KineticEnergy_gradient");
+    p->set<string>("Jacobian Inv Name", "Jacobian Inv");
+    p->set< RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > >("Intrepid2 Basis", intrepidBasis);
+    p->set< RCP<Intrepid2::Cubature<PHX::Device> > >("Cubature", cubature);
   
     ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
@@ -566,7 +581,34 @@ Aeras::HydrostaticProblem::constructEvaluators(
     ev = rcp(new Aeras::XZHydrostatic_TemperatureResid<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
-  { // Hydrostatic Pressure 
+  // Pressure, Pi, virtual temperature, Cpstar, density and geopotential
+  // in one sweep per node column, instead of the four evaluators below
+  const bool fusedColumn = params->sublist("Hydrostatic Problem").get<bool>("Fused Column Kernel", true);
+  if (fusedColumn) {
+    RCP<ParameterList> p = rcp(new ParameterList("Hydrostatic_ColumnPhysics"));
+
+    p->set<RCP<ParamLib> >("Parameter Library", paramLib);
+    Teuchos::ParameterList& paramList = params->sublist("Hydrostatic Problem");
+    p->set<Teuchos::ParameterList*>("Hydrostatic Problem", &paramList);
+
+    //Input
+    p->set<std::string>("Pressure Level 0",    dof_names_nodes[0]);
+    p->set<std::string>("Temperature",         dof_names_levels[1]);
+    p->set<std::string>("SurfaceGeopotential", "SurfaceGeopotential");
+    p->set< Teuchos::ArrayRCP<std::string> >("Tracer Names", dof_names_tracers);
+
+    //Output
+    p->set<std::string>("Pressure",            "Pressure");
+    p->set<std::string>("Pi",                  "Pi");
+    p->set<std::string>("Virtual_Temperature", "VirtualT");
+    p->set<std::string>("Cpstar",              "Cpstar");
+    p->set<std::string>("Density",             "Density");
+    p->set<std::string>("GeoPotential",        "GeoPotential");
+
+    ev = rcp(new Aeras::XZHydrostatic_ColumnPhysics<EvalT,AlbanyTraits>(*p,dl));
+    fm0.template registerEvaluator<EvalT>(ev);
+  }
+  if (!fusedColumn) { // Hydrostatic Pressure 
     RCP<ParameterList> p = rcp(new ParameterList("Hydrostatic_Pressure"));
 
     p->set<RCP<ParamLib> >("Parameter Library", paramLib);
@@ -598,6 +640,9 @@ Aeras::HydrostaticProblem::constructEvaluators(
       p->set<string>("Variable Name"            ,   "Pressure");
       p->set<string>("Gradient BF Name"    ,   "Grad BF");
       p->set<string>("Gradient Variable Name",   "Gradient QP Pressure");
+      p->set<string>("Jacobian Inv Name", "Jacobian Inv");
+      p->set< RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > >("Intrepid2 Basis", intrepidBasis);
+      p->set< RCP<Intrepid2::Cubature<PHX::Device> > >("Cubature", cubature);
     
       ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
       fm0.template registerEvaluator<EvalT>(ev);
@@ -641,7 +686,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
   //}
 
 
-  { // Hydrostatic Density 
+  if (!fusedColumn) { // Hydrostatic Density 
     RCP<ParameterList> p = rcp(new ParameterList("Hydrostatic_Density"));
 
     p->set<RCP<ParamLib> >("Parameter Library", paramLib);
@@ -666,7 +711,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     fm0.template registerEvaluator<EvalT>(ev);
   }
 
-  { // Hydrostatic Virtual Temperature
+  if (!fusedColumn) { // Hydrostatic Virtual Temperature
     RCP<ParameterList> p = rcp(new ParameterList("Hydrostatic_VirtualT"));
 
     p->set<RCP<ParamLib> >("Parameter Library", paramLib);
@@ -695,7 +740,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     fm0.template registerEvaluator<EvalT>(ev);
   }
 
-  { // Hydrostatic GeoPotential
+  if (!fusedColumn) { // Hydrostatic GeoPotential
     RCP<ParameterList> p = rcp(new ParameterList("Hydrostatic_GeoPotential"));
 
     p->set<RCP<ParamLib> >("Parameter Library", paramLib);
@@ -748,6 +793,9 @@ Aeras::HydrostaticProblem::constructEvaluators(
       p->set<string>("Variable Name",          "GeoPotential");
       p->set<string>("Gradient BF Name",       "Grad BF");
       p->set<string>("Gradient Variable Name", "Gradient QP GeoPotential");
+      p->set<string>("Jacobian Inv Name", "Jacobian Inv");
+      p->set< RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > >("Intrepid2 Basis", intrepidBasis);
+      p->set< RCP<Intrepid2::Cubature<PHX::Device> > >("Cubature", cubature);
     
       ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
       fm0.template registerEvaluator<EvalT>(ev);
@@ -869,6 +917,9 @@ Aeras::HydrostaticProblem::constructEvaluators(
       p->set<string>("Variable Name", dof_names_tracers[t]);
       p->set<string>("Gradient BF Name", "Grad BF");
       p->set<string>("Gradient Variable Name", dof_names_tracers_gradient[t]);
+      p->set<string>("Jacobian Inv Name", "Jacobian Inv");
+      p->set< RCP<Intrepid2::Basis<PHX::Device, RealType, RealType> > >("Intrepid2 Basis", intrepidBasis);
+      p->set< RCP<Intrepid2::Cubature<PHX::Device> > >("Cubature", cubature);
     
       ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
       fm0.template registerEvaluator<EvalT>(ev);
@@ -25,6 +25,7 @@
 #include "Aeras_DOFDInterpolationLevels.hpp"
 #include "Aeras_DOFGradInterpolationLevels.hpp"
 #include "Aeras_Atmosphere_Moisture.hpp"
+#include "Aeras_XZHydrostatic_ColumnPhysics.hpp"
 #include "Aeras_XZHydrostatic_Density.hpp"
 #include "Aeras_XZHydrostatic_EtaDotPi.hpp"
 #include "Aeras_XZHydrostatic_GeoPotential.hpp"
@@ -479,7 +480,34 @@ Aeras::XZHydrostaticProblem::constructEvaluators(
     ev = rcp(new Aeras::XZHydrostatic_TemperatureResid<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
-  { // XZHydrostatic Pressure 
+  // Pressure, Pi, virtual temperature, Cpstar, density and geopotential
+  // in one sweep per node column, instead of the four evaluators below
+  const bool fusedColumn = params->sublist("XZHydrostatic Problem").get<bool>("Fused Column Kernel", true);
+  if (fusedColumn) {
+    RCP<ParameterList> p = rcp(new ParameterList("XZHydrostatic_ColumnPhysics"));
+
+    p->set<RCP<ParamLib> >("Parameter Library", paramLib);
+    Teuchos::ParameterList& paramList = params->sublist("XZHydrostatic Problem");
+    p->set<Teuchos::ParameterList*>("XZHydrostatic Problem", &paramList);
+
+    //Input
+    p->set<std::string>("Pressure Level 0",    dof_names_nodes[0]);
+    p->set<std::string>("Temperature",         dof_names_levels[1]);
+    p->set<std::string>("SurfaceGeopotential", "SurfaceGeopotential");
+    p->set< Teuchos::ArrayRCP<std::string> >("Tracer Names", dof_names_tracers);
+
+    //Output
+    p->set<std::string>("Pressure",            "Pressure");
+    p->set<std::string>("Pi",                  "Pi");
+    p->set<std::string>("Virtual_Temperature", "VirtualT");
+    p->set<std::string>("Cpstar",              "Cpstar");
+    p->set<std::string>("Density",             "Density");
+    p->set<std::string>("GeoPotential",        "GeoPotential");
+
+    ev = rcp(new Aeras::XZHydrostatic_ColumnPhysics<EvalT,AlbanyTraits>(*p,dl));
+    fm0.template registerEvaluator<EvalT>(ev);
+  }
+  if (!fusedColumn) { // XZHydrostatic Pressure 
     RCP<ParameterList> p = rcp(new ParameterList("XZHydrostatic_Pressure"));
 
     p->set<RCP<ParamLib> >("Parameter Library", paramLib);
@@ -554,7 +582,7 @@ Aeras::XZHydrostaticProblem::constructEvaluators(
   //}
 
 
-  { // XZHydrostatic Density 
+  if (!fusedColumn) { // XZHydrostatic Density 
     RCP<ParameterList> p = rcp(new ParameterList("XZHydrostatic_Density"));
 
     p->set<RCP<ParamLib> >("Parameter Library", paramLib);
@@ -579,7 +607,7 @@ Aeras::XZHydrostaticProblem::constructEvaluators(
     fm0.template registerEvaluator<EvalT>(ev);
   }
 
-  { // XZHydrostatic Virtual Temperature
+  if (!fusedColumn) { // XZHydrostatic Virtual Temperature
     RCP<ParameterList> p = rcp(new ParameterList("XZHydrostatic_VirtualT"));
 
     p->set<RCP<ParamLib> >("Parameter Library", paramLib);
@@ -607,7 +635,7 @@ Aeras::XZHydrostaticProblem::constructEvaluators(
     fm0.template registerEvaluator<EvalT>(ev);
   }
 
-  {// XZHydrostatic GeoPotential
+  if (!fusedColumn) {// XZHydrostatic GeoPotential
     RCP<ParameterList> p = rcp(new ParameterList("XZHydrostatic_GeoPotential"));
 
     p->set<RCP<ParamLib> >("Parameter Library", paramLib);
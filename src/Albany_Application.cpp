@@ -1260,8 +1260,15 @@ void Albany::Application::computeGlobalResidualImplT(
 
   Teuchos::RCP<Tpetra_Import> const importerT = solMgrT->get_importerT();
 
+  // Worksets whose nodes are all owned are filled while the ghosted entries
+  // of x are in flight; the remaining ones after they have arrived
+  const auto &wsIsInterior = disc->getWsIsInterior();
+  bool const splitHalo = static_cast<int>(wsIsInterior.size()) == numWorksets &&
+      xT->getMap()->getComm()->getSize() > 1;
+
   // Scatter x and xdot to the overlapped distrbution
-  solMgrT->scatterXT(*xT, xdotT.get(), xdotdotT.get());
+  if (!splitHalo)
+    solMgrT->scatterXT(*xT, xdotT.get(), xdotdotT.get());
 
   // Scatter distributed parameters
   distParamLib->scatter();
@@ -1320,41 +1327,52 @@ void Albany::Application::computeGlobalResidualImplT(
 
     workset.fT = overlapped_fT;
 
-    for (int ws = 0; ws < numWorksets; ws++) {
-      loadWorksetBucketInfo<PHAL::AlbanyTraits::Residual>(workset, ws);
+    for (int pass = 0; pass < (splitHalo ? 2 : 1); ++pass) {
+      // Posted just before the interior worksets so that no other import
+      // runs while these messages are pending
+      if (splitHalo && pass == 0)
+        solMgrT->beginScatterXT(*xT, xdotT.get(), xdotdotT.get());
+      else if (splitHalo && pass == 1)
+        solMgrT->endScatterXT();
+
+      for (int ws = 0; ws < numWorksets; ws++) {
+        if (splitHalo && wsIsInterior[ws] != (pass == 0)) continue;
+
+        loadWorksetBucketInfo<PHAL::AlbanyTraits::Residual>(workset, ws);
 
 #ifdef DEBUG_OUTPUT
-      *out << "IKT countRes = " << countRes
-           << ", computeGlobalResid workset.xT = \n ";
-      (workset.xT)->describe(*out, Teuchos::VERB_EXTREME);
+        *out << "IKT countRes = " << countRes
+             << ", computeGlobalResid workset.xT = \n ";
+        (workset.xT)->describe(*out, Teuchos::VERB_EXTREME);
 #endif
 
-      // FillType template argument used to specialize Sacado
+        // FillType template argument used to specialize Sacado
 #ifdef DEBUG_OUTPUT2
-      std::cout << "calling FM evaluate fields in computeGlobalResidualImplT" << std::endl;
+        std::cout << "calling FM evaluate fields in computeGlobalResidualImplT" << std::endl;
 #endif
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Residual>(
-          workset);
-      if (nfm != Teuchos::null) {
+        fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Residual>(
+            workset);
+        if (nfm != Teuchos::null) {
 #ifdef ALBANY_PERIDIGM
-        // DJL this is a hack to avoid running a block with sphere elements
-        // through a Neumann field manager that was constructed for a non-sphere
-        // element topology.  The root cause is that Albany currently supports
-        // only a single Neumann field manager.  The history on that is murky.
-        // The single field manager is created for a specific element topology,
-        // and it fails if applied to worksets with a different element
-        // topology. The Peridigm use case is a discretization that contains
-        // blocks with sphere elements and blocks with standard FEM solid
-        // elements, and we want to apply Neumann BC to the standard solid
-        // elements.
-        if (workset.sideSets->size() != 0) {
+          // DJL this is a hack to avoid running a block with sphere elements
+          // through a Neumann field manager that was constructed for a non-sphere
+          // element topology.  The root cause is that Albany currently supports
+          // only a single Neumann field manager.  The history on that is murky.
+          // The single field manager is created for a specific element topology,
+          // and it fails if applied to worksets with a different element
+          // topology. The Peridigm use case is a discretization that contains
+          // blocks with sphere elements and blocks with standard FEM solid
+          // elements, and we want to apply Neumann BC to the standard solid
+          // elements.
+          if (workset.sideSets->size() != 0) {
+            deref_nfm(nfm, wsPhysIndex, ws)
+                ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+          }
+#else
           deref_nfm(nfm, wsPhysIndex, ws)
               ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
-        }
-#else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
 #endif
+        }
       }
     }
   }
@@ -3625,6 +3643,7 @@ void Albany::Application::loadWorksetSidesetInfo(PHAL::Workset &workset,
                                                  const int ws) {
 
   workset.sideSets = Teuchos::rcpFromRef(disc->getSideSets(ws));
+  workset.localSideSets = Teuchos::rcpFromRef(disc->getLocalSideSets(ws));
 }
 
 #if defined(ALBANY_EPETRA)
@@ -201,7 +201,8 @@ void subtractCentroid(const Teuchos::RCP<Tpetra_MultiVector> &coordMV)
 
 RigidBodyModes::RigidBodyModes(int numPDEs_)
   : numPDEs(numPDEs_), numElasticityDim(0), nullSpaceDim(0),
-    numScalar(0), mlUsed(false), mueLuUsed(false), setNonElastRBM(false)
+    numScalar(0), mlUsed(false), mueLuUsed(false), setNonElastRBM(false),
+    useVerticalLines(false), numSemicoarsenLevels(0)
 {}
 
 void RigidBodyModes::
@@ -244,6 +245,37 @@ void RigidBodyModes::setParameters(
   setNonElastRBM = setNonElastRBM_;
 }
 
+void RigidBodyModes::
+setVerticalLinePreconditioning(const bool useVerticalLines_,
+                               const int numSemicoarsenLevels_)
+{
+  useVerticalLines = useVerticalLines_;
+  numSemicoarsenLevels = numSemicoarsenLevels_;
+}
+
+void RigidBodyModes::
+setLayeredMeshInfo(const int numLayers, const bool columnwiseOrdering)
+{
+  if (!useVerticalLines || !isMueLuUsed()) return;
+
+  // The verbose input deck describes the factories explicitly, nothing we
+  // can safely add to it.
+  if (plist->isSublist("Factories")) return;
+
+  // With the columnwise ordering the nodes of a column are numbered
+  // consecutively and MueLu can find the lines from the numbering alone;
+  // otherwise it detects them from the coordinates.
+  plist->get<std::string>("linedetection: orientation",
+                          columnwiseOrdering ? "vertical" : "coordinates");
+  plist->get<int>("linedetection: num layers", numLayers + 1);
+  plist->get<std::string>("smoother: type", "LINESMOOTHING_BANDEDRELAXATION");
+
+  if (numSemicoarsenLevels > 0) {
+    plist->get<int>("semicoarsen: number of levels", numSemicoarsenLevels);
+    plist->get<int>("semicoarsen: coarsen rate", 3);
+  }
+}
+
 void RigidBodyModes::
 setCoordinates(const Teuchos::RCP<Tpetra_MultiVector> &coordMV_)
 {
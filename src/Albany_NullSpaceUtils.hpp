@@ -100,10 +100,24 @@ public:
   //! Pass only the coordinates.
   void setCoordinates(const Teuchos::RCP<Tpetra_MultiVector> &coordMV);
 
+  //! Request vertical line smoothing, and semicoarsening if
+  //! numSemicoarsenLevels > 0, for layered meshes (MueLu only).
+  void setVerticalLinePreconditioning(const bool useVerticalLines,
+                                      const int numSemicoarsenLevels = 0);
+
+  //! Pass the column structure of a layered mesh. If vertical line
+  //! preconditioning was requested, set up MueLu line detection (and
+  //! semicoarsening) for columns of numLayers+1 nodes. Parameters already
+  //! present in the MueLu list are not overwritten.
+  void setLayeredMeshInfo(const int numLayers, const bool columnwiseOrdering);
+
 private:
   int numPDEs, numElasticityDim, numScalar, nullSpaceDim;
   bool mlUsed, mueLuUsed, setNonElastRBM;
 
+  bool useVerticalLines;
+  int numSemicoarsenLevels;
+
   Teuchos::RCP<Teuchos::ParameterList> plist;
 
   Teuchos::RCP<Tpetra_MultiVector> coordMV;
@@ -48,6 +48,7 @@
 #include "QCAD_Solver.hpp"
 #endif
 #include "QCADT_CoupledPoissonSchrodinger.hpp"
+#include "QCADT_GenEigensolver.hpp"
 #endif
 
 #include "Albany_ModelEvaluatorT.hpp"
@@ -66,6 +67,7 @@
 
 #ifdef ALBANY_AERAS
 #include "Aeras/Aeras_HVDecorator.hpp"
+#include "Aeras/Aeras_ExplicitRKSolver.hpp"
 #endif
 
 #include "Thyra_DefaultModelEvaluatorWithSolveFactory.hpp"
@@ -619,7 +621,7 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
         std::logic_error,
         "QCAD Multi-Problem does not work with AlbanyT executable!  "
         "QCAD::Solver class needs to be implemented with Thyra::ModelEvaluator "
-        "instead of EpetraExt. \n");
+        "instead of EpetraExt; use the Albany executable. \n");
 // IK, 7/25/17: need to finish implementing QCADT::Solver class that returns
 // Thyra::ModelEvaluator instead of EpetraExt one
 // and takes in Tpetra objects.
@@ -631,23 +633,15 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
 
   if (solutionMethod == "QCAD Poisson-Schrodinger") {
 #ifdef ALBANY_QCAD
-    TEUCHOS_TEST_FOR_EXCEPTION(
-        true,
-        std::logic_error,
-        "QCAD Poisson-Schrodinger does not work with AlbanyT executable!  "
-        "QCAD::CoupledPoissonSchrodinger class needs to be implemented with "
-        "Thyra::ModelEvaluator instead of EpetraExt. \n");
-    std::cout
-        << "In Albany_SolverFactory: solutionMethod = QCAD Poisson-Schrodinger!"
-        << std::endl;
     const RCP<ParameterList> piroParams = Teuchos::sublist(appParams, "Piro");
     const Teuchos::RCP<Teuchos::ParameterList> stratList =
         Piro::extractStratimikosParams(piroParams);
     // Create and setup the Piro solver factory
     Piro::SolverFactory piroFactory;
-    // Setup linear solver
+    // Setup linear solver.  The coupled model evaluator supplies its own
+    // block preconditioner (W_prec), so Stratimikos must not build one.
+    stratList->set<std::string>("Preconditioner Type", "None");
     Stratimikos::DefaultLinearSolverBuilder linearSolverBuilder;
-    // FIXME, IKT, 5/22/15: inject Ifpack2, MueLu, Teko into Stratimikos.
     linearSolverBuilder.setParameterList(stratList);
     const RCP<Thyra::LinearOpWithSolveFactoryBase<ST>> lowsFactory =
         createLinearSolveStrategy(linearSolverBuilder);
@@ -688,28 +682,33 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
 
   if (solutionMethod == "Eigensolve") {
 #ifdef ALBANY_QCAD
-    TEUCHOS_TEST_FOR_EXCEPTION(
-        true,
-        std::logic_error,
-        "Eigensolve does not work with AlbanyT executable!  "
-        "QCAD::GenEigensolver class needs to be implemented with "
-        "Thyra::ModelEvaluator instead of EpetraExt. \n");
-
-    // RCP<Albany::Application> app;
-    // const RCP<Thyra::ModelEvaluator<ST> > modelT_ =
-    // createAlbanyAppAndModelT(app, appComm, initial_guess); albanyApp = app;
-
-    // QCAD::GenEigensolver uses a state manager as an observer (for now)
-    // RCP<Albany::StateManager> observer = rcp( &(app->getStateMgr()), false);
+    RCP<Albany::Application> app;
+    if (createAlbanyApp) {
+      app = rcp(new Albany::Application(
+          appComm, appParams, initial_guess, is_schwarz_));
+      albanyApp = app;
+    } else
+      app = albanyApp;
 
-    // Currently, QCAD eigensolver just uses LOCA's eigensolver list under Piro
-    // -- maybe give it it's own list outside of Piro? const RCP<ParameterList>
-    // eigensolveParams =
-    // rcp(&(appParams->sublist("Piro").sublist("LOCA").sublist("Stepper").sublist("Eigensolver")),
-    // false);
-    // const RCP<QCAD::GenEigensolver> es_model = rcp(new
-    // QCAD::GenEigensolver(eigensolveParams, modelT_, observer, solverComm));
-    // return es_model;
+    // As for the Epetra executable, the QCAD eigensolver uses LOCA's
+    // eigensolver list under Piro. The Stratimikos solver is only needed for
+    // the shift-invert operator.
+    const RCP<ParameterList> eigensolveParams = rcp(
+        &(appParams->sublist("Piro").sublist("LOCA").sublist("Stepper").sublist(
+            "Eigensolver")),
+        false);
+    RCP<Thyra::LinearOpWithSolveFactoryBase<ST>> lowsFactory;
+    const Teuchos::RCP<Teuchos::ParameterList> stratList =
+        Piro::extractStratimikosParams(Teuchos::sublist(appParams, "Piro"));
+    if (Teuchos::nonnull(stratList)) {
+      Stratimikos::DefaultLinearSolverBuilder linearSolverBuilder;
+      enableIfpack2(linearSolverBuilder);
+      enableMueLu(albanyApp, stratList, linearSolverBuilder);
+      linearSolverBuilder.setParameterList(stratList);
+      lowsFactory = createLinearSolveStrategy(linearSolverBuilder);
+    }
+    return rcp(new QCADT::GenEigensolver(
+        eigensolveParams, app, appParams, lowsFactory));
 
 #else  /* ALBANY_QCAD */
     TEUCHOS_TEST_FOR_EXCEPTION(true, std::logic_error, "Must activate QCAD\n");
@@ -777,6 +776,16 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
           << useExplHyperviscosity << "\n";
     }
 
+    // Native explicit Runge-Kutta stepper with the lumped mass, bypassing
+    // the Rythmos/Piro path.
+    if (appParams->sublist("Piro").isSublist("Aeras Explicit RK")) {
+      const RCP<Albany::Application> app = rcp(new Albany::Application(
+          appComm, appParams, initial_guess, is_schwarz_));
+      albanyApp = app;
+      return rcp(new Aeras::ExplicitRKSolver(
+          app, appParams, useExplHyperviscosity && (tau != 0.0)));
+    }
+
     if ((useExplHyperviscosity) && (tau != 0.0)) {
       ///// make a solver, repeated code
       const RCP<ParameterList> piroParams = Teuchos::sublist(appParams, "Piro");
@@ -4,6 +4,9 @@
 //    in the file "license.txt" in the top-level Albany directory  //
 //*****************************************************************//
 #include "Albany_StateManager.hpp"
+
+#include <algorithm>
+
 #include "Albany_Utils.hpp"
 #include "Teuchos_TestForException.hpp"
 #include "Teuchos_VerboseObject.hpp"
@@ -13,7 +16,9 @@
 //#define DEBUG_INTERNAL_STATES
 
 Albany::StateManager::StateManager()
-    : stateVarsAreAllocated(false), stateInfo(Teuchos::rcp(new StateInfoStruct))
+    : stateVarsAreAllocated(false),
+      savedStatesAreValid(false),
+      stateInfo(Teuchos::rcp(new StateInfoStruct))
 {
   // Nothing to be done here
 }
@@ -882,6 +887,83 @@ Albany::StateManager::setStateArrays(Albany::StateArrays& sa)
   return;
 }
 
+namespace {
+
+std::size_t
+stateArraysSize(Albany::StateArrayVec const& sav)
+{
+  std::size_t size = 0;
+  for (auto const& ws_states : sav)
+    for (auto const& state : ws_states) size += state.second.size();
+  return size;
+}
+
+// Copy the state arrays into (to_buffer = true) or from a flat buffer
+// starting at offset, and return the offset past the last value copied.
+std::size_t
+copyStateArrays(
+    Albany::StateArrayVec& sav,
+    std::vector<double>&   buffer,
+    std::size_t            offset,
+    bool const             to_buffer)
+{
+  for (auto& ws_states : sav) {
+    for (auto& state : ws_states) {
+      Albany::MDArray& array = state.second;
+      double* const    data  = array.contiguous_data();
+      std::size_t const size = array.size();
+      if (to_buffer)
+        std::copy(data, data + size, buffer.data() + offset);
+      else
+        std::copy(buffer.data() + offset, buffer.data() + offset + size, data);
+      offset += size;
+    }
+  }
+  return offset;
+}
+
+}  // anonymous namespace
+
+void
+Albany::StateManager::saveStates()
+{
+  ALBANY_ASSERT(stateVarsAreAllocated == true);
+
+  Albany::StateArrays& sa = disc->getStateArrays();
+
+  std::size_t const size =
+      stateArraysSize(sa.elemStateArrays) + stateArraysSize(sa.nodeStateArrays);
+
+  // Only allocates the first time around, as the layout of the states
+  // does not change after allocation.
+  savedStates.resize(size);
+
+  std::size_t offset = 0;
+  offset = copyStateArrays(sa.elemStateArrays, savedStates, offset, true);
+  offset = copyStateArrays(sa.nodeStateArrays, savedStates, offset, true);
+
+  savedStatesAreValid = true;
+}
+
+void
+Albany::StateManager::restoreStates()
+{
+  ALBANY_ASSERT(stateVarsAreAllocated == true);
+  ALBANY_ASSERT(
+      savedStatesAreValid == true,
+      "restoreStates() called before saveStates()");
+
+  Albany::StateArrays& sa = disc->getStateArrays();
+
+  std::size_t offset = 0;
+  offset = copyStateArrays(sa.elemStateArrays, savedStates, offset, false);
+  offset = copyStateArrays(sa.nodeStateArrays, savedStates, offset, false);
+
+  ALBANY_ASSERT(
+      offset == savedStates.size(),
+      "State layout changed since the last call to saveStates()");
+}
+
 void
 Albany::StateManager::updateStates()
 {
@@ -983,6 +1065,12 @@ Albany::StateManager::setAuxDataT(
   auxDataT = aux_data;
 }
 
+Teuchos::RCP<Albany::EigendataStructT>
+Albany::StateManager::getEigenDataT()
+{
+  return eigenDataT;
+}
+
 void
 Albany::StateManager::setEigenDataT(
     const Teuchos::RCP<Albany::EigendataStructT>& eigdata)
@@ -217,6 +217,22 @@ class StateManager {
   void
   setStateArrays(Albany::StateArrays& sa);
 
+  /// Take a snapshot of all element and nodal states. The snapshot buffer
+  /// is allocated on the first call and reused by later ones, so repeated
+  /// snapshots (e.g. once per load step) do not allocate.
+  void
+  saveStates();
+
+  /// Roll the states back to the last snapshot taken by saveStates().
+  void
+  restoreStates();
+
+  bool
+  haveSavedStates() const
+  {
+    return savedStatesAreValid;
+  }
+
   Albany::StateArrays&
   getSideSetStateArrays(const std::string& sideSet);
 
@@ -248,6 +264,8 @@ class StateManager {
   Teuchos::RCP<Tpetra_MultiVector>
   getAuxDataT();
 
+  Teuchos::RCP<Albany::EigendataStructT>
+  getEigenDataT();
   void
   setEigenDataT(const Teuchos::RCP<Albany::EigendataStructT>& eigdata);
   void
@@ -283,6 +301,11 @@ class StateManager {
   std::map<std::string, std::map<std::string, RegisteredStates>>
       sideSetStatesToStore;
 
+  /// Flat copy of the element and then nodal state arrays, in the order in
+  /// which they are stored in the discretization, filled by saveStates()
+  std::vector<double> savedStates;
+  bool                savedStatesAreValid;
+
   /// Discretization object which allows StateManager to perform input/output
   /// with exodus and Epetra vectors
   Teuchos::RCP<Albany::AbstractDiscretization> disc;
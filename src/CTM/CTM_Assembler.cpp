@@ -86,6 +86,7 @@ void Assembler::load_ws_bucket(PHAL::Workset& workset, const int ws) {
 
   workset.local_Vp.resize(workset.numCells);
   workset.sideSets = rcpFromRef(disc->getSideSets(ws));
+  workset.localSideSets = rcpFromRef(disc->getLocalSideSets(ws));
   workset.stateArrayPtr =
     &(state_mgr->getStateArray(Albany::StateManager::ELEM, ws));
 }
@@ -341,22 +341,27 @@ template<typename EvalT, typename Traits, bool IsHydrology, bool IsStokes, bool
 void BasalFrictionCoefficient<EvalT, Traits, IsHydrology, IsStokes, ThermoCoupled>::
 evaluateFieldsSide (typename Traits::EvalData workset, ScalarT mu, ScalarT lambda, ScalarT power)
 {
-  if (workset.sideSets->find(basalSideName)==workset.sideSets->end())
+  if (beta_type==GIVEN_CONSTANT)
+    return;   // We can save ourself some useless iterations
+
+  if (workset.localSideSets->find(basalSideName)==workset.localSideSets->end())
     return;
 
   const int dim = nodal ? numNodes : numQPs;
 
-  const std::vector<Albany::SideStruct>& sideSet = workset.sideSets->at(basalSideName);
-  for (auto const& it_side : sideSet)
+  // Each side only writes its own (cell,side) entries, so sides can be processed concurrently
+  const Albany::LocalSideSetInfo& sideSet = workset.localSideSets->at(basalSideName);
+  Kokkos::parallel_for(Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0,sideSet.numSides),
+                       [&](const int iside)
   {
     // Get the local data of side and cell
-    const int cell = it_side.elem_LID;
-    const int side = it_side.side_local_id;
+    const int cell = sideSet.elem_LID[iside];
+    const int side = sideSet.side_local_id[iside];
 
     switch (beta_type)
     {
       case GIVEN_CONSTANT:
-        return;   // We can save ourself some useless iterations
+        break;
 
       case GIVEN_FIELD:
         for (int ipt=0; ipt<dim; ++ipt)
@@ -416,7 +421,7 @@ evaluateFieldsSide (typename Traits::EvalData workset, ScalarT mu, ScalarT lambd
         beta(cell,side,ipt) *= h*h;
       }
     }
-  }
+  });
 }
 
 template<typename EvalT, typename Traits, bool IsHydrology, bool IsStokes, bool ThermoCoupled>
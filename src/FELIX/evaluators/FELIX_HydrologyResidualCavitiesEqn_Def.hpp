@@ -181,21 +181,23 @@ void HydrologyResidualCavitiesEqn<EvalT, Traits, IsStokes, ThermoCoupled>::
 evaluateFieldsSide (typename Traits::EvalData workset)
 {
   // h' = W_O - W_C = (m/rho_i + u_b*(h_b-h)/l_b) - AhN^n
-  ScalarT res_node, res_qp, zero(0.0);
+  const ScalarT zero(0.0);
 
   // Zero out, to avoid leaving stuff from previous workset!
   residual.deep_copy(ScalarT(0.0));
 
-  if (workset.sideSets->find(sideSetName)==workset.sideSets->end()) {
+  if (workset.localSideSets->find(sideSetName)==workset.localSideSets->end()) {
     return;
   }
 
-  const std::vector<Albany::SideStruct>& sideSet = workset.sideSets->at(sideSetName);
-  for (auto const& it_side : sideSet) {
+  const Albany::LocalSideSetInfo& sideSet = workset.localSideSets->at(sideSetName);
+  Kokkos::parallel_for(Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0,sideSet.numSides),
+                       [&](const int iside) {
     // Get the local data of side and cell
-    const int cell = it_side.elem_LID;
-    const int side = it_side.side_local_id;
+    const int cell = sideSet.elem_LID[iside];
+    const int side = sideSet.side_local_id[iside];
 
+    ScalarT res_node, res_qp;
     for (int node=0; node < numNodes; ++node) {
       res_node = 0;
       if (nodal_equation) {
@@ -218,7 +220,7 @@ evaluateFieldsSide (typename Traits::EvalData workset)
 
       residual (cell,side,node) = res_node;
     }
-  }
+  });
 }
 
 template<typename EvalT, typename Traits, bool IsStokes, bool ThermoCoupled>
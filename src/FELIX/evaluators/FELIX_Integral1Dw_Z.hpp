@@ -16,10 +16,17 @@
 
 #include "PHAL_AlbanyTraits.hpp"
 
+#include <utility>
+#include <vector>
+
 namespace FELIX {
 /** \brief Integral 1D w_Z
 
     This evaluator computes the integral int1d_b^z of w_z
+
+    The integral is computed with a single sweep per column of the
+    LayeredMeshNumbering (prefix sums of the trapezoidal rule), so the
+    cost is linear in the number of layers.
 */
 
 template<typename EvalT, typename Traits>
@@ -57,6 +64,26 @@ protected:
   bool StokesThermoCoupled;
 
   int offset, neq;
+
+  // Fills the per-node column data below for the cells of the workset.
+  void computeColumnIntegrals(typename Traits::EvalData workset);
+
+  // Per (cell,node), stored as cell*numNodes+node: index of the column
+  // in worksetColumns and level of the node.
+  std::vector<int> nodeColumn;
+  std::vector<LO>  nodeLevel;
+
+  // Per column touched by the workset: local column id, basal (cell,node)
+  // and the integral of w_z from the base up to each level, stored as
+  // column*numLevels+level.
+  std::vector<LO> worksetColumns;
+  std::vector<std::pair<std::size_t,std::size_t> > basalCellNode;
+  std::vector<double> columnInt1D;
+  int numLevels;
+
+  // Local column id -> index in worksetColumns (-1 if not in the workset).
+  // Kept across fills to avoid rebuilding a map every time.
+  std::vector<int> columnIndex;
 };
 
 template<typename EvalT, typename Traits> class Integral1Dw_Z;
@@ -14,6 +14,8 @@
 
 #include "Intrepid2_FunctionSpaceTools.hpp"
 
+#include <algorithm>
+
 //uncomment the following line if you want debug output to be printed to screen
 //#define OUTPUT_TO_SCREEN
 
@@ -66,68 +68,110 @@ postRegistrationSetup(typename Traits::SetupData d,
     this->utils.setFieldData(int1Dw_z,fm);
 }
 
-// Specialization for AlbanyTraits::Residual
-template<typename Traits>
-Integral1Dw_Z<PHAL::AlbanyTraits::Residual, Traits>::
-Integral1Dw_Z(const Teuchos::ParameterList& p,
-          const Teuchos::RCP<Albany::Layouts>& dl)
-          : Integral1Dw_ZBase<PHAL::AlbanyTraits::Residual, Traits>(p,dl)
-            {}
-
-template<typename Traits>
-void Integral1Dw_Z<PHAL::AlbanyTraits::Residual, Traits>::
-evaluateFields(typename Traits::EvalData workset)
+template<typename EvalT, typename Traits>
+void Integral1Dw_ZBase<EvalT, Traits>::
+computeColumnIntegrals(typename Traits::EvalData workset)
 {
     Teuchos::RCP<const Tpetra_Vector> xT = workset.xT;
     Teuchos::ArrayRCP<const ST> xT_constView = xT->get1dView();
 
-    Kokkos::deep_copy(this->int1Dw_z.get_view(), ScalarT(0.0));
-
     const Teuchos::ArrayRCP<Teuchos::ArrayRCP<GO> >& wsElNodeID  = workset.disc->getWsElNodeID()[workset.wsIndex];
+    Teuchos::RCP<const Tpetra_Map> overlapNodeMap = workset.disc->getOverlapNodeMapT();
 
     const Albany::LayeredMeshNumbering<LO>& layeredMeshNumbering = *workset.disc->getLayeredMeshNumbering();
     const Albany::NodalDOFManager& solDOFManager = workset.disc->getOverlapDOFManager("ordinary_solution");
     const Teuchos::ArrayRCP<double>& layers_ratio = layeredMeshNumbering.layers_ratio;
-    int numLayers = layeredMeshNumbering.numLayers;
-    LO baseId, ilayer;
-    std::map<LO,std::pair<std::size_t,std::size_t> > basalCellsMap;
+    numLevels = layeredMeshNumbering.numLayers + 1;
+
+    // Collect the columns of the workset and the highest level needed in each
+    nodeColumn.resize(workset.numCells*numNodes);
+    nodeLevel.resize(workset.numCells*numNodes);
+    worksetColumns.clear();
+    basalCellNode.clear();
+    std::vector<LO> topLevel;
+    LO baseId, ilevel;
 
     for ( std::size_t cell = 0; cell < workset.numCells; ++cell )
     {
       const Teuchos::ArrayRCP<GO>& nodeID = wsElNodeID[cell];
 
-      for (std::size_t node = 0; node < this->numNodes; ++node)
+      for (std::size_t node = 0; node < numNodes; ++node)
       {
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(nodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilayer);
-
-        if(ilayer==0)
-          basalCellsMap[baseId]= std::make_pair(cell,node);
+        LO lnodeId = overlapNodeMap->getLocalElement(nodeID[node]);
+        layeredMeshNumbering.getIndices(lnodeId, baseId, ilevel);
 
-        double int1D = 0;
+        if (baseId >= static_cast<LO>(columnIndex.size()))
+          columnIndex.resize(baseId+1, -1);
 
-        for (int il = 0; il < ilayer; ++il)
+        int& col = columnIndex[baseId];
+        if (col < 0)
         {
-          LO inode0 = layeredMeshNumbering.getId(baseId, il);
-          LO inode1 = layeredMeshNumbering.getId(baseId, il+1);
-          int1D += 0.5 * ( xT_constView[solDOFManager.getLocalDOF(inode0, this->offset)] + xT_constView[solDOFManager.getLocalDOF(inode1, this->offset)] ) * layers_ratio[il];
+          col = worksetColumns.size();
+          worksetColumns.push_back(baseId);
+          basalCellNode.push_back(std::make_pair(std::size_t(0),std::size_t(0)));
+          topLevel.push_back(0);
         }
 
-        this->int1Dw_z(cell,node) = int1D * this->thickness(cell,node);
+        if(ilevel==0)
+          basalCellNode[col] = std::make_pair(cell,node);
+        topLevel[col] = std::max(topLevel[col], ilevel);
+
+        nodeColumn[cell*numNodes+node] = col;
+        nodeLevel[cell*numNodes+node] = ilevel;
       }
     }
 
-    for ( std::size_t cell = 0; cell < workset.numCells; ++cell )
+    for (std::size_t col = 0; col < worksetColumns.size(); ++col)
+      columnIndex[worksetColumns[col]] = -1;
+
+    // Trapezoidal prefix sums, one sweep per column
+    columnInt1D.resize(worksetColumns.size()*numLevels);
+    const int w_z = offset;
+    Kokkos::parallel_for(Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0,worksetColumns.size()),
+                         [&](const int col)
     {
-      const Teuchos::ArrayRCP<GO>& nodeID = wsElNodeID[cell];
+      double* int1D = &columnInt1D[col*numLevels];
+      const LO columnId = worksetColumns[col];
+      double w0 = xT_constView[solDOFManager.getLocalDOF(layeredMeshNumbering.getId(columnId, 0), w_z)];
+      int1D[0] = 0;
+      for (int il = 0; il < topLevel[col]; ++il)
+      {
+        double w1 = xT_constView[solDOFManager.getLocalDOF(layeredMeshNumbering.getId(columnId, il+1), w_z)];
+        int1D[il+1] = int1D[il] + 0.5 * (w0 + w1) * layers_ratio[il];
+        w0 = w1;
+      }
+    });
+}
+
+// Specialization for AlbanyTraits::Residual
+template<typename Traits>
+Integral1Dw_Z<PHAL::AlbanyTraits::Residual, Traits>::
+Integral1Dw_Z(const Teuchos::ParameterList& p,
+          const Teuchos::RCP<Albany::Layouts>& dl)
+          : Integral1Dw_ZBase<PHAL::AlbanyTraits::Residual, Traits>(p,dl)
+            {}
+
+template<typename Traits>
+void Integral1Dw_Z<PHAL::AlbanyTraits::Residual, Traits>::
+evaluateFields(typename Traits::EvalData workset)
+{
+    this->computeColumnIntegrals(workset);
+
+    const int numNodes = this->numNodes;
+    const int numLevels = this->numLevels;
 
-      for (std::size_t node = 0; node < this->numNodes; ++node)
+    Kokkos::parallel_for(Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0,workset.numCells),
+                         [&](const int cell)
+    {
+      for (int node = 0; node < numNodes; ++node)
       {
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(nodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilayer);
-        this->int1Dw_z(cell,node) += this->basal_velocity(basalCellsMap[baseId].first, basalCellsMap[baseId].second);
+        const int col = this->nodeColumn[cell*numNodes+node];
+        const double int1D = this->columnInt1D[col*numLevels + this->nodeLevel[cell*numNodes+node]];
+        const std::pair<std::size_t,std::size_t>& basal = this->basalCellNode[col];
+
+        this->int1Dw_z(cell,node) = int1D * this->thickness(cell,node) + this->basal_velocity(basal.first, basal.second);
       }
-    }
+    });
 }
 
 // Specialization for AlbanyTraits::Jacobian
@@ -142,83 +186,44 @@ template<typename Traits>
 void Integral1Dw_Z<PHAL::AlbanyTraits::Jacobian, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
-    Teuchos::RCP<const Tpetra_Vector> xT = workset.xT;
-    Teuchos::ArrayRCP<const ST> xT_constView = xT->get1dView();
+    this->computeColumnIntegrals(workset);
 
-    Kokkos::deep_copy(this->int1Dw_z.get_view(), ScalarT(0.0));
-
-    const Teuchos::ArrayRCP<Teuchos::ArrayRCP<GO> >& wsElNodeID  = workset.disc->getWsElNodeID()[workset.wsIndex];
+    const Teuchos::ArrayRCP<double>& layers_ratio = workset.disc->getLayeredMeshNumbering()->layers_ratio;
+    const int numNodes = this->numNodes;
+    const int numLevels = this->numLevels;
 
-    const Albany::LayeredMeshNumbering<LO>& layeredMeshNumbering = *workset.disc->getLayeredMeshNumbering();
-    const Albany::NodalDOFManager& solDOFManager = workset.disc->getOverlapDOFManager("ordinary_solution");
-
-    const Teuchos::ArrayRCP<double>& layers_ratio = layeredMeshNumbering.layers_ratio;
-    int numLayers = layeredMeshNumbering.numLayers;
-
-    LO baseId, ilevel, baseId_curr, ilevel_curr;
-    std::map<LO,std::pair<std::size_t,std::size_t> > basalCellsMap;
-
-    for ( std::size_t cell = 0; cell < workset.numCells; ++cell )
+    Kokkos::parallel_for(Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0,workset.numCells),
+                         [&](const int cell)
     {
-      const Teuchos::ArrayRCP<GO>& nodeID = wsElNodeID[cell];
-
-      for (std::size_t node = 0; node < this->numNodes; ++node)
+      for (int node = 0; node < numNodes; ++node)
       {
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(nodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilevel);
-
-        if(ilevel==0)
-          basalCellsMap[baseId]= std::make_pair(cell,node);
+        const int col = this->nodeColumn[cell*numNodes+node];
+        const LO ilevel = this->nodeLevel[cell*numNodes+node];
 
-        double int1D = 0;
+        this->int1Dw_z(cell,node) = FadType(this->int1Dw_z(cell,node).size(), this->columnInt1D[col*numLevels+ilevel]);
 
-        for (int il = 0; il < ilevel; ++il)
+        // Only the nodes of the cell in the same column, at the level of
+        // the node or at the one below, contribute to the derivative.
+        // TODO implement the derivative for the extra term mb
+        for (int node_curr = 0; node_curr < numNodes; ++node_curr)
         {
-          LO inode0 = layeredMeshNumbering.getId(baseId, il);
-          LO inode1 = layeredMeshNumbering.getId(baseId, il+1);
-          int1D += 0.5 * ( xT_constView[solDOFManager.getLocalDOF(inode0, this->offset)] + xT_constView[solDOFManager.getLocalDOF(inode1, this->offset)] ) * layers_ratio[il];
-        }
-
-        this->int1Dw_z(cell,node) = FadType(this->int1Dw_z(cell,node).size(), int1D);
-      }
-    }
-
-    for ( std::size_t cell = 0; cell < workset.numCells; ++cell )
-    {
-      const Teuchos::ArrayRCP<GO>& nodeID = wsElNodeID[cell];
+          if (this->nodeColumn[cell*numNodes+node_curr] != col) continue;
 
-      for (std::size_t node = 0; node < this->numNodes; ++node)
-      {
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(nodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilevel);
+          const LO ilevel_curr = this->nodeLevel[cell*numNodes+node_curr];
+          const int idx = this->neq * node_curr + this->offset;
 
+          if(ilevel_curr == ilevel - 1)
+            this->int1Dw_z(cell,node).fastAccessDx(idx) = 0.5 * layers_ratio[ilevel_curr] * workset.j_coeff;
 
-        // TODO implement the derivative for the extra term mb
-        for (std::size_t node_curr = 0; node_curr < this->numNodes; ++node_curr)
-          {
-            LO lnodeId_curr = nodeID[node_curr];
-              layeredMeshNumbering.getIndices(lnodeId_curr, baseId_curr, ilevel_curr);
-              if (baseId_curr == baseId)
-              {
-                int idx = this->neq * node_curr + this->offset;
-                //int idx = this->offset * this->numNodes + node_curr;
-
-                if(ilevel_curr == ilevel - 1)
-                  this->int1Dw_z(cell,node).fastAccessDx(idx) = 0.5 * layers_ratio[ilevel_curr] * workset.j_coeff;
-
-                if( ((ilevel_curr == ilevel)||(ilevel_curr == ilevel - 1))&&(ilevel_curr > 0) )
-                  this->int1Dw_z(cell,node).fastAccessDx(idx) += 0.5 * layers_ratio[ilevel_curr - 1] * workset.j_coeff;
-              }
-          }
+          if( ((ilevel_curr == ilevel)||(ilevel_curr == ilevel - 1))&&(ilevel_curr > 0) )
+            this->int1Dw_z(cell,node).fastAccessDx(idx) += 0.5 * layers_ratio[ilevel_curr - 1] * workset.j_coeff;
+        }
 
+        const std::pair<std::size_t,std::size_t>& basal = this->basalCellNode[col];
         this->int1Dw_z(cell,node) *= this->thickness(cell,node);
-
-          if (0)//lnodeId == baseId)
-            this->int1Dw_z(cell,node) += this->basal_velocity(basalCellsMap[baseId].first, basalCellsMap[baseId].second);
-          else
-            this->int1Dw_z(cell,node) += Albany::ADValue(this->basal_velocity(basalCellsMap[baseId].first, basalCellsMap[baseId].second));
+        this->int1Dw_z(cell,node) += Albany::ADValue(this->basal_velocity(basal.first, basal.second));
       }
-    }
+    });
 }
 
 // Specialization for AlbanyTraits::Tangent
@@ -113,28 +113,33 @@ void StokesFOBasalResid<EvalT, Traits, BetaScalarT>::evaluateFields (typename Tr
       for (int dim=0; dim<vecDim; ++dim)
         basalResid(cell,node,dim) = 0;
 
-  if (workset.sideSets->find(basalSideName)==workset.sideSets->end())
+  if (workset.localSideSets->find(basalSideName)==workset.localSideSets->end())
     return;
 
-  const std::vector<Albany::SideStruct>& sideSet = workset.sideSets->at(basalSideName);
-
-  for (auto const& it_side : sideSet)
+  // The sides are grouped by cell, so threading over the cells never has two
+  // threads accumulating into the same cell.
+  const Albany::LocalSideSetInfo& sideSet = workset.localSideSets->at(basalSideName);
+  Kokkos::parallel_for(Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0,sideSet.numCells),
+                       [&](const int icell)
   {
-    // Get the local data of side and cell
-    const int cell = it_side.elem_LID;
-    const int side = it_side.side_local_id;
-
-    for (int node=0; node<numSideNodes; ++node)
+    for (int iside=sideSet.cellOffsets[icell]; iside<sideSet.cellOffsets[icell+1]; ++iside)
     {
-      for (int dim=0; dim<vecDimFO; ++dim)
+      // Get the local data of side and cell
+      const int cell = sideSet.elem_LID[iside];
+      const int side = sideSet.side_local_id[iside];
+
+      for (int node=0; node<numSideNodes; ++node)
       {
-        for (int qp=0; qp<numSideQPs; ++qp)
+        for (int dim=0; dim<vecDimFO; ++dim)
         {
-          basalResid(cell,sideNodes[side][node],dim) += (ff + beta(cell,side,qp)*u(cell,side,qp,dim))*BF(cell,side,node,qp)*w_measure(cell,side,qp);
+          for (int qp=0; qp<numSideQPs; ++qp)
+          {
+            basalResid(cell,sideNodes[side][node],dim) += (ff + beta(cell,side,qp)*u(cell,side,qp,dim))*BF(cell,side,node,qp)*w_measure(cell,side,qp);
+          }
         }
       }
     }
-  }
+  });
 }
 
 } // Namespace FELIX
@@ -40,6 +40,8 @@ public:
   void evaluateFields(typename Traits::EvalData d);
 
 private:
+  void computeFlowFactor(typename Traits::EvalData d);
+
   template<typename TemperatureT>
   KOKKOS_INLINE_FUNCTION
   TemperatureT flowRate(const TemperatureT& T) const;
@@ -73,6 +75,22 @@ private:
   bool performContinuousHomotopy;
   double expCoeff;
 
+  // Constants of Glen's law, computed once per evaluation rather than per cell/qp
+  double power;               // exponent of the effective strain rate, (1/n-1)/2
+  double uniformFlowFactor;   // 1/2 A^{-1/n}
+  ScalarT ff;                 // regularization of the effective strain rate
+  ScalarT scale;              // weight of the constant viscosity in the continuous homotopy
+
+  // When the flow rate does not depend on the solution (temperature or ice softness
+  // given as a parameter), the per-cell flow factor 1/2 A(T)^{-1/n} is computed in a
+  // separate pass, and cached per workset: it is only recomputed for the cells whose
+  // temperature (or softness) changed since the previous evaluation.
+  bool precomputeFlowFactor;
+  int wsIndex;
+  Kokkos::View<double*, PHX::Device> cellFlowFactor;
+  Kokkos::View<double**, PHX::Device> cachedFlowInput;
+  Kokkos::View<double**, PHX::Device> cachedFlowFactor;
+
 
   // Output:
   PHX::MDField<ScalarT,Cell,QuadPoint> mu;  // [k^2 Pa yr], k=1000
@@ -100,6 +118,8 @@ public:
   struct ViscosityFO_GLENSLAW_XZ_TEMPERATUREBASED_Tag{};
   struct ViscosityFO_GLENSLAW_XZ_FROMFILE_Tag{};
   struct ViscosityFO_GLENSLAW_XZ_FROMCISM_Tag{};
+  struct ViscosityFO_FLOWFACTOR_Tag{};
+  struct ViscosityFO_GLENSLAW_PRECOMPUTED_Tag{};
 
   typedef Kokkos::RangePolicy<ExecutionSpace, ViscosityFO_EXPTRIG_Tag> ViscosityFO_EXPTRIG_Policy;
   typedef Kokkos::RangePolicy<ExecutionSpace, ViscosityFO_CONSTANT_Tag> ViscosityFO_CONSTANT_Policy;
@@ -110,6 +130,8 @@ public:
   typedef Kokkos::RangePolicy<ExecutionSpace, ViscosityFO_GLENSLAW_XZ_TEMPERATUREBASED_Tag> ViscosityFO_GLENSLAW_XZ_TEMPERATUREBASED_Policy;
   typedef Kokkos::RangePolicy<ExecutionSpace, ViscosityFO_GLENSLAW_XZ_FROMFILE_Tag> ViscosityFO_GLENSLAW_XZ_FROMFILE_Policy;
   typedef Kokkos::RangePolicy<ExecutionSpace, ViscosityFO_GLENSLAW_XZ_FROMCISM_Tag> ViscosityFO_GLENSLAW_XZ_FROMCISM_Policy;
+  typedef Kokkos::RangePolicy<ExecutionSpace, ViscosityFO_FLOWFACTOR_Tag> ViscosityFO_FLOWFACTOR_Policy;
+  typedef Kokkos::RangePolicy<ExecutionSpace, ViscosityFO_GLENSLAW_PRECOMPUTED_Tag> ViscosityFO_GLENSLAW_PRECOMPUTED_Policy;
 
   KOKKOS_INLINE_FUNCTION
   void operator() (const ViscosityFO_EXPTRIG_Tag& tag, const int& i) const;
@@ -138,6 +160,12 @@ public:
   KOKKOS_INLINE_FUNCTION
   void operator() (const ViscosityFO_GLENSLAW_XZ_FROMCISM_Tag& tag, const int& i) const;
 
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ViscosityFO_FLOWFACTOR_Tag& tag, const int& i) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ViscosityFO_GLENSLAW_PRECOMPUTED_Tag& tag, const int& i) const;
+
   KOKKOS_INLINE_FUNCTION
   void glenslaw (const ScalarT &flowFactorVec, const int& cell) const;
 
@@ -10,6 +10,9 @@
 
 #include "Albany_Layouts.hpp"
 
+#include <limits>
+#include <type_traits>
+
 //uncomment the following line if you want debug output to be printed to screen
 //#define OUTPUT_TO_SCREEN
 
@@ -169,6 +172,15 @@ ViscosityFO(const Teuchos::ParameterList& p,
   performContinuousHomotopy = visc_list->get("Continuous Homotopy With Constant Initial Viscosity", false);
   expCoeff = performContinuousHomotopy ? visc_list->get<double>("Coefficient For Continuous Homotopy") : 0.0;
 
+  power = 0.5*(1.0/n - 1.0);
+  uniformFlowFactor = 0.5*std::pow(A, -1.0/n);
+
+  // The flow factor can be precomputed only if it does not carry derivatives
+  // (Glen's Law X-Z always uses a uniform flow rate)
+  precomputeFlowFactor = std::is_same<TemprT,RealType>::value && flowRate_type != UNIFORM &&
+                         visc_type == GLENSLAW;
+  wsIndex = 0;
+
   //dummy initialization
   R=R2=x_0=y_0=0;
 
@@ -198,6 +210,9 @@ postRegistrationSetup(typename Traits::SetupData d,
     this->utils.setFieldData(coordVec,fm);
   }
   this->utils.setFieldData(homotopyParam, fm);
+
+  if (precomputeFlowFactor)
+    cellFlowFactor = Kokkos::View<double*, PHX::Device>("cellFlowFactor", numCells);
 }
 
 //**********************************************************************
@@ -237,10 +252,6 @@ template<typename EvalT, typename Traits, typename VelT, typename TemprT>
 KOKKOS_INLINE_FUNCTION
 void ViscosityFO<EvalT, Traits, VelT, TemprT>::glenslaw (const ScalarT &flowFactorVec, const int& cell) const
 {
-  double power = 0.5*(1.0/n - 1.0);
-  double a = 1.0;
-  //ScalarT scale = std::pow(1.0-homotopyParam(0),8);
-  ScalarT scale = performContinuousHomotopy ? std::pow(1.0-homotopyParam(0),expCoeff) : ScalarT(0);
   if (0)//homotopyParam(0) == 0.0)
   {
     //set constant viscosity
@@ -251,7 +262,6 @@ void ViscosityFO<EvalT, Traits, VelT, TemprT>::glenslaw (const ScalarT &flowFact
   }
   else
   {
-    ScalarT ff = pow(10.0, -10.0*homotopyParam(0));
     ScalarT epsilonEqpSq = 0.0;
     if(useStereographicMap)
     {
@@ -347,9 +357,7 @@ void ViscosityFO<EvalT, Traits, VelT, TemprT>::glenslaw (const ScalarT &flowFact
 template<typename EvalT, typename Traits, typename VelT, typename TemprT>
 KOKKOS_INLINE_FUNCTION
 void ViscosityFO<EvalT, Traits, VelT, TemprT>::operator () (const ViscosityFO_GLENSLAW_UNIFORM_Tag& tag, const int& cell) const{
-  TemprT flowFactorVec;
-  flowFactorVec = 1.0/2.0*pow(A, -1.0/n);
-  glenslaw(flowFactorVec,cell);
+  glenslaw(uniformFlowFactor,cell);
 }
 
 template<typename EvalT, typename Traits, typename VelT, typename TemprT>
@@ -376,9 +384,6 @@ template<typename EvalT, typename Traits, typename VelT, typename TemprT>
 KOKKOS_INLINE_FUNCTION
 void ViscosityFO<EvalT, Traits, VelT, TemprT>::glenslaw_xz (const TemprT &flowFactorVec, const int& cell) const
 {
-  double power = 0.5*(1.0/n - 1.0);
-  double a = 1.0;
-  ScalarT scale = performContinuousHomotopy ? std::pow(1.0-homotopyParam(0),expCoeff) : ScalarT(0);
   if (0)//homotopyParam(0) == 0.0)
   {
     //set constant viscosity
@@ -389,7 +394,6 @@ void ViscosityFO<EvalT, Traits, VelT, TemprT>::glenslaw_xz (const TemprT &flowFa
   }
   else
   {
-    ScalarT ff = pow(10.0, -10.0*homotopyParam(0));
     ScalarT epsilonEqpSq = 0.0;
     if (extractStrainRateSq)
     {
@@ -423,9 +427,7 @@ template<typename EvalT, typename Traits, typename VelT, typename TemprT>
 KOKKOS_INLINE_FUNCTION
 void ViscosityFO<EvalT, Traits, VelT, TemprT>::operator () (const ViscosityFO_GLENSLAW_XZ_UNIFORM_Tag& tag, const int& cell) const
 {
-  TemprT flowFactorVec;
-  flowFactorVec = 1.0/2.0*pow(A, -1.0/n);
-  glenslaw_xz(flowFactorVec,cell);
+  glenslaw_xz(TemprT(uniformFlowFactor),cell);
 }
 
 template<typename EvalT, typename Traits, typename VelT, typename TemprT>
@@ -453,6 +455,47 @@ void ViscosityFO<EvalT, Traits, VelT, TemprT>::operator () (const ViscosityFO_GL
 
 }
 
+template<typename EvalT, typename Traits, typename VelT, typename TemprT>
+KOKKOS_INLINE_FUNCTION
+void ViscosityFO<EvalT, Traits, VelT, TemprT>::operator () (const ViscosityFO_FLOWFACTOR_Tag& tag, const int& cell) const
+{
+  // Only used when TemprT is RealType, ADValue is a no-op
+  const double input = (flowRate_type == TEMPERATUREBASED) ? Albany::ADValue(temperature(cell)) : Albany::ADValue(flowFactorA(cell));
+  if (input != cachedFlowInput(wsIndex,cell))
+  {
+    const double rate = (flowRate_type == TEMPERATUREBASED) ? flowRate<double>(input) : input;
+    cachedFlowFactor(wsIndex,cell) = 0.5*std::pow(rate, -1.0/n);
+    cachedFlowInput(wsIndex,cell) = input;
+  }
+  cellFlowFactor(cell) = cachedFlowFactor(wsIndex,cell);
+}
+
+template<typename EvalT, typename Traits, typename VelT, typename TemprT>
+KOKKOS_INLINE_FUNCTION
+void ViscosityFO<EvalT, Traits, VelT, TemprT>::operator () (const ViscosityFO_GLENSLAW_PRECOMPUTED_Tag& tag, const int& cell) const
+{
+  glenslaw(cellFlowFactor(cell),cell);
+}
+
+//**********************************************************************
+template<typename EvalT, typename Traits, typename VelT, typename TemprT>
+void ViscosityFO<EvalT, Traits, VelT, TemprT>::
+computeFlowFactor(typename Traits::EvalData workset)
+{
+  // Grow the per-workset cache if needed. New entries are NaN, so they never match an input.
+  wsIndex = workset.wsIndex;
+  if (wsIndex >= static_cast<int>(cachedFlowInput.extent(0)))
+  {
+    const int numWorksets = cachedFlowInput.extent(0);
+    Kokkos::resize(cachedFlowInput, wsIndex+1, numCells);
+    Kokkos::resize(cachedFlowFactor, wsIndex+1, numCells);
+    Kokkos::deep_copy(Kokkos::subview(cachedFlowInput, std::make_pair(numWorksets, wsIndex+1), Kokkos::ALL()),
+                      std::numeric_limits<double>::quiet_NaN());
+  }
+
+  Kokkos::parallel_for(ViscosityFO_FLOWFACTOR_Policy(0,workset.numCells),*this);
+}
+
 //**********************************************************************
 template<typename EvalT, typename Traits, typename VelT, typename TemprT>
 void ViscosityFO<EvalT, Traits, VelT, TemprT>::
@@ -467,6 +510,8 @@ evaluateFields(typename Traits::EvalData workset)
       Kokkos::parallel_for(ViscosityFO_EXPTRIG_Policy(0,workset.numCells),*this);
       break;
     case GLENSLAW:
+      ff = pow(10.0, -10.0*homotopyParam(0));
+      scale = performContinuousHomotopy ? std::pow(1.0-homotopyParam(0),expCoeff) : ScalarT(0);
       if(useStereographicMap)
       {
         R = stereographicMapList->get<double>("Earth Radius", 6371);
@@ -475,6 +520,13 @@ evaluateFields(typename Traits::EvalData workset)
         R2 = std::pow(R,2);
       }
 
+      if (precomputeFlowFactor)
+      {
+        computeFlowFactor(workset);
+        Kokkos::parallel_for(ViscosityFO_GLENSLAW_PRECOMPUTED_Policy(0,workset.numCells),*this);
+        break;
+      }
+
       switch (flowRate_type)
       {
         case UNIFORM:
@@ -490,6 +542,8 @@ evaluateFields(typename Traits::EvalData workset)
       }
       break;
     case GLENSLAW_XZ:
+      ff = pow(10.0, -10.0*homotopyParam(0));
+      scale = performContinuousHomotopy ? std::pow(1.0-homotopyParam(0),expCoeff) : ScalarT(0);
       switch (flowRate_type)
       {
         case UNIFORM:
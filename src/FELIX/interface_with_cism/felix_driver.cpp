@@ -83,6 +83,9 @@ int nNodes2D; //number global nodes in the domain in 2D
 int nNodesProc2D; //number of nodes on each processor in 2D  
 //vector used to renumber nodes on each processor from the Albany convention (horizontal levels first) to the CISM convention (vertical layers first)
 std::vector<int> cismToAlbanyNodeNumberMap; 
+//STK node for each entry of cismToAlbanyNodeNumberMap (invalid if the node is not in an active element).
+//Built once when the mesh is created, so that the coupling does not look up entities one at a time.
+std::vector<stk::mesh::Entity> cismNodeEntities;
 
 
 int rank, number_procs;
@@ -139,6 +142,26 @@ bool first_time_step = true;
 bool keep_proc = true; 
 const Tpetra::global_size_t INVALID = Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid ();
 
+//Build the permutation from the CISM node numbering (vertical layers first, without halo) to the 
+//Albany node numbering (horizontal levels first), and resolve the STK node of each CISM node. 
+//Must be called after the mesh has been constructed. 
+void buildCismToAlbanyNodeMaps()
+{
+  nNodes2D = (global_ewn + 1)*(global_nsn+1); //number global nodes in the domain in 2D 
+  nNodesProc2D = (nsn-2*nhalo+1)*(ewn-2*nhalo+1); //number of nodes on each processor in 2D  
+  cismToAlbanyNodeNumberMap.resize(upn*nNodesProc2D);
+  cismNodeEntities.resize(upn*nNodesProc2D);
+  for (int j=0; j<nsn-2*nhalo+1;j++) { 
+    for (int i=0; i<ewn-2*nhalo+1; i++) {
+      for (int k=0; k<upn; k++) { 
+        int index = k+upn*i + j*(ewn-2*nhalo+1)*upn; 
+        cismToAlbanyNodeNumberMap[index] = k*nNodes2D + global_node_id_owned_map_Ptr[i+j*(ewn-2*nhalo+1)]; 
+        cismNodeEntities[index] = meshStruct->bulkData->get_entity(stk::topology::NODE_RANK, cismToAlbanyNodeNumberMap[index]);
+      }
+    }
+  }
+}
+
 #ifdef CISM_USE_EPETRA
 Teuchos::RCP<const Epetra_Vector>
 epetraVectorFromThyra(
@@ -625,6 +648,8 @@ void felix_driver_init(int argc, int exec_mode, FelixToGlimmer * ftg_ptr, const
       global_node_id_owned_map[i] = global_node_id_owned_map_Ptr[i];
     node_map = Teuchos::rcp(new Tpetra_Map(INVALID, global_node_id_owned_map, 0, reducedMpiCommT));
 #endif
+
+    buildCismToAlbanyNodeMaps();
  }
 
 
@@ -675,40 +700,24 @@ void felix_driver_run(FelixToGlimmer * ftg_ptr, double& cur_time_yr, double time
     else
       solutionField = Teuchos::rcp_dynamic_cast<Albany::OrdinarySTKFieldContainer<false> >(meshStruct->getFieldContainer())->getSolutionField();
 
-     //Create vector used to renumber nodes on each processor from the Albany convention (horizontal levels first) to the CISM convention (vertical layers first)
-     nNodes2D = (global_ewn + 1)*(global_nsn+1); //number global nodes in the domain in 2D 
-     nNodesProc2D = (nsn-2*nhalo+1)*(ewn-2*nhalo+1); //number of nodes on each processor in 2D  
-     cismToAlbanyNodeNumberMap.resize(upn*nNodesProc2D);
-     for (int j=0; j<nsn-2*nhalo+1;j++) { 
-       for (int i=0; i<ewn-2*nhalo+1; i++) {
-         for (int k=0; k<upn; k++) { 
-           int index = k+upn*i + j*(ewn-2*nhalo+1)*upn; 
-           cismToAlbanyNodeNumberMap[index] = k*nNodes2D + global_node_id_owned_map_Ptr[i+j*(ewn-2*nhalo+1)]; 
-           //if (mpiComm->MyPID() == 0) 
-           //  std::cout << "index: " << index << ", cismToAlbanyNodeNumberMap: " << cismToAlbanyNodeNumberMap[index] << std::endl; 
-          }
-        }
-      }
-
-     //The way it worked out, uVel_ptr and vVel_ptr have more nodes than the nodes in the mesh passed to Albany/CISM for the solve.  In particular, 
-     //there is 1 row of halo elements in uVel_ptr and vVel_ptr.  To account for this, we copy uVel_ptr and vVel_ptr into std::vectors, which do not have the halo elements. 
-     std::vector<double> uvel_vec(upn*nNodesProc2D); 
-     std::vector<double> vvel_vec(upn*nNodesProc2D); 
+     //Copy uvel and vvel from CISM into the Albany solution field to use as initial condition.  uVel_ptr and vVel_ptr 
+     //have 1 row of halo elements more than the mesh passed to Albany, which are skipped.  Nodes that are not part 
+     //of an active element are not in the mesh and are skipped as well. 
+     //IK, 3/18/14: added division by velScale to convert uvel and vvel from dimensionless to having units of m/year (the Albany units)  
+     double velScale = seconds_per_year*vel_scaling_param;  
      int counter1 = 0; 
      int counter2 = 0; 
-     int local_nodeID; 
      for (int j=0; j<nsn-1; j++) {
        for (int i=0; i<ewn-1; i++) { 
          for (int k=0; k<upn; k++) {
            if (j >= nhalo-1 & j < nsn-nhalo) {
              if (i >= nhalo-1 & i < ewn-nhalo) {
-#ifdef CISM_USE_EPETRA 
-               local_nodeID = node_map->LID(cismToAlbanyNodeNumberMap[counter1]); 
-#else
-               local_nodeID = node_map->getLocalElement(cismToAlbanyNodeNumberMap[counter1]);
-#endif
-               uvel_vec[counter1] = uVel_ptr[counter2]; 
-               vvel_vec[counter1] = vVel_ptr[counter2]; 
+               stk::mesh::Entity node = cismNodeEntities[counter1];
+               if (meshStruct->bulkData->is_valid(node)) {
+                 double* sol = stk::mesh::field_data(*solutionField, node);
+                 sol[0] = uVel_ptr[counter2]/velScale;
+                 sol[1] = vVel_ptr[counter2]/velScale;
+               }
                counter1++;
             }
             }
@@ -716,25 +725,6 @@ void felix_driver_run(FelixToGlimmer * ftg_ptr, double& cur_time_yr, double time
          }
         }
      }
-     //Loop over all the elements to find which nodes are active.  For the active nodes, copy uvel and vvel from CISM into Albany solution array to 
-     //use as initial condition.
-     //NOTE: there is some inefficiency here by looping over all the elements.  TO DO? pass only active nodes from Albany-CISM to improve this? 
-     double velScale = seconds_per_year*vel_scaling_param;  
-     for (int i=0; i<nElementsActive; i++) {
-       for (int j=0; j<8; j++) {
-        int node_GID =  global_element_conn_active_Ptr[i + nElementsActive*j]; //node_GID is 1-based
-#ifdef CISM_USE_EPETRA      
-        int node_LID =  node_map->LID(node_GID); //node_LID is 0-based
-#else
-        int node_LID =  node_map->getLocalElement(node_GID); //node_LID is 0-based
-#endif
-        stk::mesh::Entity node = meshStruct->bulkData->get_entity(stk::topology::NODE_RANK, node_GID);
-        double* sol = stk::mesh::field_data(*solutionField, node);
-        //IK, 3/18/14: added division by velScale to convert uvel and vvel from dimensionless to having units of m/year (the Albany units)  
-        sol[0] = uvel_vec[node_LID]/velScale;
-        sol[1] = vvel_vec[node_LID]/velScale;
-      }
-    }
     // ---------------------------------------------------------------------------------------------------
     // Solve 
     // ---------------------------------------------------------------------------------------------------
@@ -939,77 +929,34 @@ void felix_driver_run(FelixToGlimmer * ftg_ptr, double& cur_time_yr, double time
     //with the solution passed to the *.nc file not being copied from Albany to CISM 
     //correctly in parallel for all geometries/decompositions.
 
-    int numGlobalNodes;
-#ifdef CISM_USE_EPETRA
-    numGlobalNodes = node_map->NumGlobalElements();
-#else
-    numGlobalNodes = node_map->getGlobalNumElements();
-#endif
-
-    //IKT, 10/6/17: ensure size of *vel_local* and *vec_global* std::vecs 
-    //is large enough when reduced comm is used.
-#ifdef REDUCED_COMM
-    numGlobalNodes*=2; 
-#endif
-
-    std::vector<double> uvel_local_vec(numGlobalNodes, 0.0);
-    std::vector<double> vvel_local_vec(numGlobalNodes, 0.0);
-
-    int overlap_map_num_my_elts;
-    int global_dof;
-    double sol_value;  
+    //Look up the overlap dofs of the u and v velocities of each CISM node.  A node that is not in the 
+    //overlap map (i.e., not in an active element) gets a zero velocity. 
+    const int numCismNodes = cismToAlbanyNodeNumberMap.size(); 
+    std::vector<int> velocityLIDs(2*numCismNodes); 
     int numDofs;
 #ifdef CISM_USE_EPETRA
-    overlap_map_num_my_elts = overlapMap.NumMyElements(); 
+    numDofs = overlapMap.NumGlobalElements(); 
 #else
-    overlap_map_num_my_elts = overlapMap->getNodeNumElements(); 
+    numDofs = overlapMap->getGlobalNumElements();
 #endif
-
-    if (interleavedOrdering == true) { 
-      for (int i=0; i<overlap_map_num_my_elts; i++) { 
-#ifdef CISM_USE_EPETRA
-        global_dof = overlapMap.GID(i);
-        sol_value = solutionOverlap[i];
-#else
-        global_dof = overlapMap->getGlobalElement(i);
-        sol_value = solutionOverlap_constView[i];
-#endif  
-        int modulo = (global_dof % 2); //check if dof is for u or for v 
-        int vel_global_dof; 
-        if (modulo == 0) { //u dof 
-          vel_global_dof = global_dof/2+1; //add 1 because node_map is 1-based 
-          uvel_local_vec[vel_global_dof] = sol_value; 
-        }
-        else { // v dof 
-          vel_global_dof = (global_dof-1)/2+1; //add 1 because node_map is 1-based 
-          vvel_local_vec[vel_global_dof] = sol_value; 
-        }
+    for (int inode=0; inode<numCismNodes; inode++) { 
+      int node_GID = cismToAlbanyNodeNumberMap[inode] - 1; //subtract 1 because node_map is 1-based 
+      int u_dof, v_dof; 
+      if (interleavedOrdering == true) {
+        u_dof = 2*node_GID; 
+        v_dof = 2*node_GID+1; 
+      }
+      else { //note: the case with non-interleaved ordering has not been tested...
+        u_dof = node_GID; 
+        v_dof = node_GID+numDofs/2; 
       }
-    }
-    else { //note: the case with non-interleaved ordering has not been tested...
 #ifdef CISM_USE_EPETRA
-      numDofs = overlapMap.NumGlobalElements(); 
-#else
-      numDofs = overlapMap->getGlobalNumElements();
-#endif
-      for (int i=0; i<overlap_map_num_my_elts; i++) {
-#ifdef CISM_USE_EPETRA 
-        global_dof = overlapMap.GID(i);
-        sol_value = solutionOverlap[i];  
+      velocityLIDs[2*inode] = overlapMap.LID(u_dof); 
+      velocityLIDs[2*inode+1] = overlapMap.LID(v_dof); 
 #else
-        global_dof = overlapMap->getGlobalElement(i);
-        sol_value = solutionOverlap_constView[i];
+      velocityLIDs[2*inode] = overlapMap->getLocalElement(u_dof); 
+      velocityLIDs[2*inode+1] = overlapMap->getLocalElement(v_dof); 
 #endif
-        int vel_global_dof; 
-        if (global_dof < numDofs/2) { //u dof
-          vel_global_dof = global_dof+1; //add 1 because node_map is 1-based 
-          uvel_local_vec[vel_global_dof] = sol_value; 
-        }
-        else { //v dofs 
-          vel_global_dof = global_dof-numDofs/2+1; //add 1 because node_map is 1-based
-          vvel_local_vec[vel_global_dof] = sol_value; 
-        } 
-      }
     }
 
      //Copy uvel and vvel into uVel_ptr and vVel_ptr respectively (the arrays passed back to CISM) according to the numbering consistent w/ CISM. 
@@ -1020,9 +967,15 @@ void felix_driver_run(FelixToGlimmer * ftg_ptr, double& cur_time_yr, double time
          for (int k=0; k<upn; k++) {
            if (j >= nhalo-1 & j < nsn-nhalo) {
              if (i >= nhalo-1 & i < ewn-nhalo) {
-               auto global_nodeID = cismToAlbanyNodeNumberMap[counter1];
-               uVel_ptr[counter2] = uvel_local_vec[global_nodeID];  
-               vVel_ptr[counter2] = vvel_local_vec[global_nodeID];  
+               int u_lid = velocityLIDs[2*counter1]; 
+               int v_lid = velocityLIDs[2*counter1+1]; 
+#ifdef CISM_USE_EPETRA
+               uVel_ptr[counter2] = (u_lid < 0) ? 0.0 : solutionOverlap[u_lid];  
+               vVel_ptr[counter2] = (v_lid < 0) ? 0.0 : solutionOverlap[v_lid];  
+#else
+               uVel_ptr[counter2] = (u_lid < 0) ? 0.0 : solutionOverlap_constView[u_lid];  
+               vVel_ptr[counter2] = (v_lid < 0) ? 0.0 : solutionOverlap_constView[v_lid];  
+#endif
                counter1++;
             }
             }
@@ -1039,6 +992,7 @@ void felix_driver_run(FelixToGlimmer * ftg_ptr, double& cur_time_yr, double time
 
     first_time_step = false;
     meshStruct = Teuchos::null;
+    cismNodeEntities.clear();
     albanyApp = Teuchos::null;
     solver = Teuchos::null;
 #ifdef CISM_USE_EPETRA
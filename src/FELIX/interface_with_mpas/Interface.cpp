@@ -21,6 +21,8 @@
 #include "Piro_PerformSolve.hpp"
 #include "Albany_OrdinarySTKFieldContainer.hpp"
 #include "Albany_STKDiscretization.hpp"
+#include "Albany_ModelEvaluatorT.hpp"
+#include "Piro_StratimikosUtils.hpp"
 
 #ifdef ALBANY_SEACAS
 #include <stk_io/IossBridge.hpp>
@@ -48,6 +50,22 @@ bool MPAS_useGLP(true);
 #endif
 bool keptMesh =false;
 
+// Persistent solver mode: keep the solver, the Jacobian and the
+// preconditioner alive between calls while the mesh is kept.
+bool MPAS_persistentSolver(false);
+std::string MPAS_solverType;
+Teuchos::RCP<Tpetra_Import> MPAS_solutionImport;
+Teuchos::RCP<Tpetra_Vector> MPAS_overlapSolution;
+
+// Bulk field exchange: the STK node of each MPAS 3D vertex and the STK
+// element of each MPAS tetrahedron, both in MPAS local ordering, are
+// resolved once when the mesh is created. MPAS_velocityLIDs holds the
+// overlap LIDs of the two velocity components of each vertex, and is
+// refreshed whenever the solver (and with it the overlap map) is rebuilt.
+std::vector<stk::mesh::Entity> MPAS_nodeEntities;
+std::vector<stk::mesh::Entity> MPAS_elemEntities;
+std::vector<LO> MPAS_velocityLIDs;
+
 typedef struct TET_ {
   int verts[4];
   int neighbours[4];
@@ -56,6 +74,75 @@ typedef struct TET_ {
 
 /***********************************************************/
 
+namespace {
+
+void buildExchangeMaps(int nLayers, int nGlobalVertices, int nGlobalTriangles,
+    int ordering, const std::vector<int>& indexToVertexID,
+    const std::vector<int>& indexToTriangleID) {
+
+  int numVertices3D = (nLayers + 1) * indexToVertexID.size();
+  int numPrisms = nLayers * indexToTriangleID.size();
+  int vertexColumnShift = (ordering == 1) ? 1 : nGlobalVertices;
+  int lVertexColumnShift = (ordering == 1) ? 1 : indexToVertexID.size();
+  int vertexLayerShift = (ordering == 0) ? 1 : nLayers + 1;
+
+  int elemColumnShift = (ordering == 1) ? 3 : 3 * nGlobalTriangles;
+  int lElemColumnShift = (ordering == 1) ? 3 : 3 * indexToTriangleID.size();
+  int elemLayerShift = (ordering == 0) ? 3 : 3 * nLayers;
+
+  MPAS_nodeEntities.resize(numVertices3D);
+  for (UInt j = 0; j < numVertices3D; ++j) {
+    int ib = (ordering == 0) * (j % lVertexColumnShift)
+        + (ordering == 1) * (j / vertexLayerShift);
+    int il = (ordering == 0) * (j / lVertexColumnShift)
+        + (ordering == 1) * (j % vertexLayerShift);
+    int gId = il * vertexColumnShift + vertexLayerShift * indexToVertexID[ib];
+    MPAS_nodeEntities[j] = meshStruct->bulkData->get_entity(stk::topology::NODE_RANK, gId + 1);
+  }
+
+  MPAS_elemEntities.resize(3 * numPrisms);
+  for (UInt j = 0; j < numPrisms; ++j) {
+    int ib = (ordering == 0) * (j % (lElemColumnShift / 3))
+        + (ordering == 1) * (j / (elemLayerShift / 3));
+    int il = (ordering == 0) * (j / (lElemColumnShift / 3))
+        + (ordering == 1) * (j % (elemLayerShift / 3));
+    int gId = il * elemColumnShift + elemLayerShift * indexToTriangleID[ib];
+    int lId = il * lElemColumnShift + elemLayerShift * ib;
+    for (int iTetra = 0; iTetra < 3; iTetra++)
+      MPAS_elemEntities[lId++] = meshStruct->bulkData->get_entity(stk::topology::ELEMENT_RANK, ++gId);
+  }
+
+  MPAS_velocityLIDs.clear();
+}
+
+void buildVelocityLIDs(int nLayers, int nGlobalVertices, bool ordering,
+    const std::vector<int>& indexToVertexID, int neq, bool interleavedOrdering,
+    const Tpetra_Map& overlapMap) {
+
+  int numVertices3D = (nLayers + 1) * indexToVertexID.size();
+  int vertexColumnShift = (ordering == 1) ? 1 : nGlobalVertices;
+  int lVertexColumnShift = (ordering == 1) ? 1 : indexToVertexID.size();
+  int vertexLayerShift = (ordering == 0) ? 1 : nLayers + 1;
+
+  MPAS_velocityLIDs.resize(2 * numVertices3D);
+  for (UInt j = 0; j < numVertices3D; ++j) {
+    int ib = (ordering == 0) * (j % lVertexColumnShift)
+        + (ordering == 1) * (j / vertexLayerShift);
+    int il = (ordering == 0) * (j / lVertexColumnShift)
+        + (ordering == 1) * (j % vertexLayerShift);
+    int gId = il * vertexColumnShift + vertexLayerShift * indexToVertexID[ib];
+
+    if (interleavedOrdering) {
+      MPAS_velocityLIDs[2 * j] = overlapMap.getLocalElement(neq * gId);
+      MPAS_velocityLIDs[2 * j + 1] = MPAS_velocityLIDs[2 * j] + 1;
+    } else {
+      MPAS_velocityLIDs[2 * j] = overlapMap.getLocalElement(gId);
+      MPAS_velocityLIDs[2 * j + 1] = MPAS_velocityLIDs[2 * j] + numVertices3D;
+    }
+  }
+}
+
+} // namespace
 
 void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
     int nGlobalTriangles, bool ordering, bool first_time_step,
@@ -82,14 +169,9 @@ void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
 
   int numVertices3D = (nLayers + 1) * indexToVertexID.size();
   int numPrisms = nLayers * indexToTriangleID.size();
-  int vertexColumnShift = (ordering == 1) ? 1 : nGlobalVertices;
   int lVertexColumnShift = (ordering == 1) ? 1 : indexToVertexID.size();
   int vertexLayerShift = (ordering == 0) ? 1 : nLayers + 1;
 
-  int elemColumnShift = (ordering == 1) ? 3 : 3 * nGlobalTriangles;
-  int lElemColumnShift = (ordering == 1) ? 3 : 3 * indexToTriangleID.size();
-  int elemLayerShift = (ordering == 0) ? 3 : 3 * nLayers;
-
   int neq = meshStruct->neq;
 
   const bool interleavedOrdering = meshStruct->getInterleavedOrdering();
@@ -123,14 +205,15 @@ void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
   ScalarFieldType* basalFrictionField = meshStruct->metaData->get_field <ScalarFieldType> (stk::topology::NODE_RANK, "basal_friction");
   ScalarFieldType* stiffeningFactorField = meshStruct->metaData->get_field <ScalarFieldType> (stk::topology::NODE_RANK, "stiffening_factor");
 
+  VectorFieldType* coordinatesField = meshStruct->getCoordinatesField();
+
   for (UInt j = 0; j < numVertices3D; ++j) {
     int ib = (ordering == 0) * (j % lVertexColumnShift)
         + (ordering == 1) * (j / vertexLayerShift);
     int il = (ordering == 0) * (j / lVertexColumnShift)
         + (ordering == 1) * (j % vertexLayerShift);
-    int gId = il * vertexColumnShift + vertexLayerShift * indexToVertexID[ib];
-    stk::mesh::Entity node = meshStruct->bulkData->get_entity(stk::topology::NODE_RANK, gId + 1);
-    double* coord = stk::mesh::field_data(*meshStruct->getCoordinatesField(), node);
+    stk::mesh::Entity node = MPAS_nodeEntities[j];
+    double* coord = stk::mesh::field_data(*coordinatesField, node);
     coord[2] = elevationData[ib] - levelsNormalizedThickness[nLayers - il] * thicknessData[ib];
 
 
@@ -164,18 +247,9 @@ void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
 
   ScalarFieldType* temperature_field = meshStruct->metaData->get_field<ScalarFieldType>(stk::topology::ELEMENT_RANK, "temperature");
 
-  for (UInt j = 0; j < numPrisms; ++j) {
-    int ib = (ordering == 0) * (j % (lElemColumnShift / 3))
-        + (ordering == 1) * (j / (elemLayerShift / 3));
-    int il = (ordering == 0) * (j / (lElemColumnShift / 3))
-        + (ordering == 1) * (j % (elemLayerShift / 3));
-    int gId = il * elemColumnShift + elemLayerShift * indexToTriangleID[ib];
-    int lId = il * lElemColumnShift + elemLayerShift * ib;
-    for (int iTetra = 0; iTetra < 3; iTetra++) {
-      stk::mesh::Entity elem = meshStruct->bulkData->get_entity(stk::topology::ELEMENT_RANK, ++gId);
-      double* temperature = stk::mesh::field_data(*temperature_field, elem);
-      temperature[0] = temperatureOnTetra[lId++];
-    }
+  for (UInt lId = 0; lId < 3 * numPrisms; ++lId) {
+    double* temperature = stk::mesh::field_data(*temperature_field, MPAS_elemEntities[lId]);
+    temperature[0] = temperatureOnTetra[lId];
   }
 
   meshStruct->setHasRestartSolution(true);//!first_time_step);
@@ -194,24 +268,65 @@ void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
 
 
 
-  if(!keptMesh) {
-    albanyApp->createDiscretization();
+  // The solver can be reused only if the mesh is unchanged and Piro would
+  // build the same (steady NOX) solver again.
+  Teuchos::ParameterList& piroList = paramList->sublist("Piro");
+  const std::string solverType = piroList.isParameter("Solver Type") ?
+      piroList.get<std::string>("Solver Type") : "";
+#ifdef MPAS_USE_EPETRA
+  const bool reuseSolver = false;
+#else
+  const bool reuseSolver = MPAS_persistentSolver && keptMesh &&
+      Teuchos::nonnull(solver) && (solverType == "NOX") &&
+      (solverType == MPAS_solverType);
+#endif
+
+  if (!reuseSolver) {
+    if(!keptMesh) {
+      albanyApp->createDiscretization();
+    } else {
+      auto abs_disc = albanyApp->getDiscretization();
+      auto stk_disc = Teuchos::rcp_dynamic_cast<Albany::STKDiscretization>(abs_disc);
+      stk_disc->updateMesh();
+    }
+    albanyApp->finalSetUp(paramList);
   } else {
-    auto abs_disc = albanyApp->getDiscretization();
-    auto stk_disc = Teuchos::rcp_dynamic_cast<Albany::STKDiscretization>(abs_disc);
-    stk_disc->updateMesh();
+    // Geometry and fields have been written to the STK mesh above and are
+    // seen directly by the evaluators. Only the initial guess and the
+    // distributed parameters, which are copies, are reloaded from the mesh.
+    auto disc = albanyApp->getDiscretization();
+    albanyApp->getAdaptSolMgrT()->reloadSolutionFromDiscretization();
+
+    const Albany::StateInfoStruct& distParamSIS = disc->getNodalParameterSIS();
+    for (int is = 0; is < distParamSIS.size(); is++) {
+      const std::string& param_name = distParamSIS[is]->name;
+      if (!albanyApp->getDistParamLib()->has(param_name)) continue;
+      auto param = albanyApp->getDistParamLib()->get(param_name);
+      disc->getFieldT(*param->vector(), param_name);
+      param->scatter();
+    }
+
+    Teuchos::rcp_dynamic_cast<Albany::ModelEvaluatorT>(
+        slvrfctry->returnModelT(), true)->allocateVectors();
   }
-  albanyApp->finalSetUp(paramList);
 
   bool success = true;
   Teuchos::ArrayRCP<const ST> solution_constView;
-  Teuchos::RCP<const Tpetra_Map> overlapMap;
   try {
+  if (!reuseSolver) {
 #ifdef MPAS_USE_EPETRA
-  solver = slvrfctry->createThyraSolverAndGetAlbanyApp(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
+    solver = slvrfctry->createThyraSolverAndGetAlbanyApp(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
 #else
-   solver = slvrfctry->createAndGetAlbanyAppT(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
+    solver = slvrfctry->createAndGetAlbanyAppT(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
 #endif
+    MPAS_solverType = piroList.get<std::string>("Solver Type");
+
+    MPAS_solutionImport = Teuchos::rcp(new Tpetra_Import(albanyApp->getDiscretization()->getMapT(),
+        albanyApp->getDiscretization()->getOverlapMapT()));
+    MPAS_overlapSolution = Teuchos::rcp(new Tpetra_Vector(albanyApp->getDiscretization()->getOverlapMapT()));
+    buildVelocityLIDs(nLayers, nGlobalVertices, ordering, indexToVertexID, neq,
+        interleavedOrdering, *albanyApp->getDiscretization()->getOverlapMapT());
+  }
 
   Teuchos::ParameterList solveParams;
   solveParams.set("Compute Sensitivities", false);
@@ -222,11 +337,8 @@ void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
   Piro::PerformSolveBase(*solver, solveParams, thyraResponses,
       thyraSensitivities);
 
-  overlapMap = albanyApp->getDiscretization()->getOverlapMapT();
-  Teuchos::RCP<Tpetra_Import> import = Teuchos::rcp(new Tpetra_Import(albanyApp->getDiscretization()->getMapT(), overlapMap));
-  Teuchos::RCP<Tpetra_Vector> solution = Teuchos::rcp(new Tpetra_Vector(overlapMap));
-  solution->doImport(*albanyApp->getDiscretization()->getSolutionFieldT(), *import, Tpetra::INSERT);
-  solution_constView = solution->get1dView();
+  MPAS_overlapSolution->doImport(*albanyApp->getDiscretization()->getSolutionFieldT(), *MPAS_solutionImport, Tpetra::INSERT);
+  solution_constView = MPAS_overlapSolution->get1dView();
   }
   TEUCHOS_STANDARD_CATCH_STATEMENTS(true, std::cerr, success);
 
@@ -234,39 +346,15 @@ void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
 
 
   for (UInt j = 0; j < numVertices3D; ++j) {
-    int ib = (ordering == 0) * (j % lVertexColumnShift)
-        + (ordering == 1) * (j / vertexLayerShift);
-    int il = (ordering == 0) * (j / lVertexColumnShift)
-        + (ordering == 1) * (j % vertexLayerShift);
-    int gId = il * vertexColumnShift + vertexLayerShift * indexToVertexID[ib];
-
-    int lId0, lId1;
-
-    if (interleavedOrdering) {
-      lId0 = overlapMap->getLocalElement(neq * gId);
-      lId1 = lId0 + 1;
-    } else {
-      lId0 = overlapMap->getLocalElement(gId);
-      lId1 = lId0 + numVertices3D;
-    }
-    velocityOnVertices[j] = solution_constView[lId0];
-    velocityOnVertices[j + numVertices3D] = solution_constView[lId1];
+    velocityOnVertices[j] = solution_constView[MPAS_velocityLIDs[2 * j]];
+    velocityOnVertices[j + numVertices3D] = solution_constView[MPAS_velocityLIDs[2 * j + 1]];
   }
 
 
   ScalarFieldType* dissipationHeatField = meshStruct->metaData->get_field <ScalarFieldType> (stk::topology::ELEMENT_RANK, "dissipation_heat");
-  for (UInt j = 0; j < numPrisms; ++j) {
-    int ib = (ordering == 0) * (j % (lElemColumnShift / 3))
-        + (ordering == 1) * (j / (elemLayerShift / 3));
-    int il = (ordering == 0) * (j / (lElemColumnShift / 3))
-        + (ordering == 1) * (j % (elemLayerShift / 3));
-    int gId = il * elemColumnShift + elemLayerShift * indexToTriangleID[ib];
-    int lId = il * lElemColumnShift + elemLayerShift * ib;
-    for (int iTetra = 0; iTetra < 3; iTetra++) {
-      stk::mesh::Entity elem = meshStruct->bulkData->get_entity(stk::topology::ELEMENT_RANK, ++gId);
-      double* dissipationHeat = stk::mesh::field_data(*dissipationHeatField, elem);
-      dissipationHeatOnTetra[lId++] = dissipationHeat[0];
-    }
+  for (UInt lId = 0; lId < 3 * numPrisms; ++lId) {
+    double* dissipationHeat = stk::mesh::field_data(*dissipationHeatField, MPAS_elemEntities[lId]);
+    dissipationHeatOnTetra[lId] = dissipationHeat[0];
   }
 
   keptMesh = true;
@@ -482,6 +570,24 @@ void velocity_solver_extrude_3d_grid(int nLayers, int nGlobalTriangles,
 
   discParams = Teuchos::sublist(paramList, "Discretization", true);
 
+  //Persistent solver: the mesh topology does not change between MPAS steps,
+  //so the multigrid transfer operators are reused unless specified otherwise.
+  MPAS_persistentSolver = paramList->sublist("Piro").get("Persistent Solver", false);
+  if (MPAS_persistentSolver) {
+    Teuchos::RCP<Teuchos::ParameterList> stratList =
+        Piro::extractStratimikosParams(Teuchos::sublist(paramList, "Piro"));
+    if (Teuchos::nonnull(stratList) && stratList->isSublist("Preconditioner Types")) {
+      Teuchos::ParameterList& precTypesList = stratList->sublist("Preconditioner Types");
+      const char* mueluNames[] = {"MueLu", "MueLu-Tpetra"};
+      for (const char* name : mueluNames) {
+        if (precTypesList.isSublist(name)) {
+          Teuchos::ParameterList& mueluList = precTypesList.sublist(name);
+          mueluList.set("reuse: type", mueluList.get<std::string>("reuse: type", "RP"));
+        }
+      }
+    }
+  }
+
 
 /*  //discParams>setSublist("Side Set Discretizations");
   Teuchos::RCP<Teuchos::Array<std::string> > sideSetsArray = Teuchos::rcp(new Teuchos::Array<std::string> (1, "basalside"));
@@ -512,6 +618,9 @@ void velocity_solver_extrude_3d_grid(int nLayers, int nGlobalTriangles,
       verticesOnEdge, indexToEdgeID, nGlobalEdges, indexToTriangleGOID,
       dirichletNodesIds, floating2dEdgesIds,
       meshStruct->getMeshSpecs()[0]->worksetSize, nLayers, Ordering);
+
+  buildExchangeMaps(nLayers, nGlobalVertices, nGlobalTriangles, Ordering,
+      indexToVertexID, indexToTriangleID);
 }
 //}
 
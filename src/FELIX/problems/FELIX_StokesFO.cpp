@@ -54,6 +54,11 @@ StokesFO( const Teuchos::RCP<Teuchos::ParameterList>& params_,
                                      << numRBMs << " is not valid!  Valid values are 0, 2 and 3.");
   }
 
+  // Use the column structure of extruded meshes in MueLu (line smoothing and, optionally, semicoarsening)
+  bool useVerticalLines = params_->get<bool>("Vertical Line Preconditioning", false);
+  int numSemicoarsenLevels = params_->get<int>("Semicoarsening Levels", 0);
+  rigidBodyModes->setVerticalLinePreconditioning(useVerticalLines, numSemicoarsenLevels);
+
   // Need to allocate a fields in mesh database
   if (params->isParameter("Required Fields"))
   {
@@ -352,6 +357,8 @@ FELIX::StokesFO::getValidProblemParameters () const
   validPL->sublist("Parameter Fields", false, "Parameter Fields to be registered");
   validPL->set<bool>("Use Time Parameter", false, "Solely to use Solver Method = Continuation");
   validPL->set<bool>("Print Stress Tensor", false, "Whether to save stress tensor in the mesh");
+  validPL->set<bool>("Vertical Line Preconditioning", false, "Whether to set up MueLu line smoothing along the columns of extruded meshes");
+  validPL->set<int>("Semicoarsening Levels", 0, "Number of MueLu semicoarsening levels along the columns of extruded meshes (requires Vertical Line Preconditioning)");
 
   return validPL;
 }
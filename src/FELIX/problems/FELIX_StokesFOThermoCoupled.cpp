@@ -7,6 +7,7 @@
 #include <string>
 
 #include "Intrepid2_DefaultCubatureFactory.hpp"
+#include "Piro_StratimikosUtils.hpp"
 #include "Shards_CellTopology.hpp"
 #include "Teuchos_FancyOStream.hpp"
 
@@ -339,6 +340,58 @@ FELIX::StokesFOThermoCoupled::getValidProblemParameters () const
   validPL->sublist("Parameter Fields", false, "Parameter Fields to be registered");
   validPL->set<bool>("Use Time Parameter", false, "Solely to use Solver Method = Continuation");
   validPL->set<bool>("Print Stress Tensor", false, "Whether to save stress tensor in the mesh");
+  validPL->sublist("Segregated Solve", false, "Solve velocity and enthalpy with a block Gauss-Seidel preconditioner inside a fixed-point iteration");
 
   return validPL;
 }
+
+void FELIX::StokesFOThermoCoupled::
+applyProblemSpecificSolverSettings(Teuchos::RCP<Teuchos::ParameterList> params_)
+{
+  if (!params->isSublist("Segregated Solve"))
+    return;
+
+  Teuchos::ParameterList& segregatedList = params->sublist("Segregated Solve");
+  if (!segregatedList.get<bool>("Enable",true))
+    return;
+
+  Teuchos::RCP<Teuchos::ParameterList> piroParams = Teuchos::sublist(params_, "Piro");
+  Teuchos::RCP<Teuchos::ParameterList> stratList = Piro::extractStratimikosParams(piroParams);
+  TEUCHOS_TEST_FOR_EXCEPTION (stratList.is_null(), std::logic_error,
+                              "Error! The segregated solve requires a Stratimikos linear solver in the Piro list.\n");
+#ifndef ALBANY_TEKO
+  TEUCHOS_TEST_FOR_EXCEPTION (true, std::logic_error,
+                              "Error! The segregated solve uses a Teko block preconditioner, but Albany was built without Teko.\n");
+#else
+
+  const std::string velocityInverse = segregatedList.get<std::string>("Velocity Inverse","Ifpack2");
+  const std::string enthalpyInverse = segregatedList.get<std::string>("Enthalpy Inverse","Ifpack2");
+  const int storageDepth            = segregatedList.get<int>("Anderson Storage Depth",2);
+  const double mixingParameter      = segregatedList.get<double>("Anderson Mixing Parameter",1.0);
+  const int recomputeJacobian       = segregatedList.get<int>("Recompute Jacobian Iteration",5);
+
+  // Linear level: velocity (2 dofs) and enthalpy/w_z (2 dofs) are two blocks of a
+  // lower block Gauss-Seidel preconditioner, so each block keeps its own inverse
+  // and the stiff enthalpy block never enters the velocity multigrid.
+  stratList->set<std::string>("Preconditioner Type","Teko");
+  Teuchos::ParameterList& tekoList = stratList->sublist("Preconditioner Types").sublist("Teko");
+  tekoList.set<std::string>("Strided Blocking","2 2");
+  tekoList.set<std::string>("Inverse Type","Segregated Velocity-Enthalpy");
+  Teuchos::ParameterList& gsList = tekoList.sublist("Inverse Factory Library").sublist("Segregated Velocity-Enthalpy");
+  gsList.set<std::string>("Type","Block Gauss-Seidel");
+  gsList.set<bool>("Use Upper Triangle",false);
+  gsList.set<std::string>("Inverse Type 1",velocityInverse);
+  gsList.set<std::string>("Inverse Type 2",enthalpyInverse);
+
+  // Nonlinear level: Anderson accelerated fixed point (plain Picard with zero depth),
+  // preconditioned by the block solve above. The Jacobian, and therefore the block
+  // preconditioners, are only recomputed every few outer iterations.
+  Teuchos::ParameterList& noxList = piroParams->sublist("NOX");
+  noxList.set<std::string>("Nonlinear Solver","Anderson Accelerated Fixed-Point");
+  Teuchos::ParameterList& andersonList = noxList.sublist("Anderson Parameters");
+  andersonList.set<int>("Storage Depth",storageDepth);
+  andersonList.set<double>("Mixing Parameter",mixingParameter);
+  andersonList.sublist("Preconditioning").set<bool>("Precondition",true);
+  andersonList.sublist("Preconditioning").set<int>("Recompute Jacobian Iteration",recomputeJacobian);
+#endif
+}
@@ -119,6 +119,9 @@ namespace FELIX
     //! Each problem must generate it's list of valide parameters
     Teuchos::RCP<const Teuchos::ParameterList> getValidProblemParameters() const;
 
+    //! Set up the segregated (velocity/enthalpy) solve, if requested
+    void applyProblemSpecificSolverSettings(Teuchos::RCP<Teuchos::ParameterList> params);
+
   private:
 
     //! Private to prohibit copying
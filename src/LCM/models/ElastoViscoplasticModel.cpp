@@ -8,6 +8,15 @@
 
 #include "ElastoViscoplasticModel.hpp"
 #include "ElastoViscoplasticModel_Def.hpp"
+#include "ParallelConstitutiveModel_Def.hpp"
 
-PHAL_INSTANTIATE_TEMPLATE_CLASS(LCM::ElastoViscoplasticModel)
+template<typename EvalT, typename Traits>
+LCM::ElastoViscoplasticModel<EvalT, Traits>::ElastoViscoplasticModel(
+    Teuchos::ParameterList* p,
+    const Teuchos::RCP<Albany::Layouts>& dl) :
+  LCM::ParallelConstitutiveModel<EvalT, Traits,
+      ElastoViscoplasticKernel<EvalT, Traits>>(p, dl)
+{}
 
+PHAL_INSTANTIATE_TEMPLATE_CLASS(LCM::ElastoViscoplasticKernel)
+PHAL_INSTANTIATE_TEMPLATE_CLASS(LCM::ElastoViscoplasticModel)
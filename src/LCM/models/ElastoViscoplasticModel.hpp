@@ -8,161 +8,156 @@
 #define LCM_ElastoViscoplasticModel_hpp
 
 #include "ElastoViscoplasticCore.hpp"
-#include "ConstitutiveModel.hpp"
+#include "ParallelConstitutiveModel.hpp"
 
 namespace LCM
 {
 
-//! \brief Elasto Viscoplastic Constitutive Model
 template<typename EvalT, typename Traits>
-class ElastoViscoplasticModel: public LCM::ConstitutiveModel<EvalT, Traits>
+struct ElastoViscoplasticKernel : public ParallelKernel<EvalT, Traits>
 {
-public:
-
-  using Base = LCM::ConstitutiveModel<EvalT, Traits>;
-  using DepFieldMap = typename Base::DepFieldMap;
-  using FieldMap = typename Base::FieldMap;
-
-  typedef typename EvalT::ScalarT ScalarT;
-  typedef typename EvalT::MeshScalarT MeshScalarT;
-  typedef typename Sacado::Fad::DFad<ScalarT> Fad;
-
-  using ConstitutiveModel<EvalT, Traits>::num_dims_;
-  using ConstitutiveModel<EvalT, Traits>::num_pts_;
-  using ConstitutiveModel<EvalT, Traits>::field_name_map_;
-
-  // optional temperature support
-  using ConstitutiveModel<EvalT, Traits>::have_temperature_;
-  using ConstitutiveModel<EvalT, Traits>::expansion_coeff_;
-  using ConstitutiveModel<EvalT, Traits>::ref_temperature_;
-  using ConstitutiveModel<EvalT, Traits>::heat_capacity_;
-  using ConstitutiveModel<EvalT, Traits>::density_;
-  using ConstitutiveModel<EvalT, Traits>::temperature_;
-  using ConstitutiveModel<EvalT, Traits>::have_total_concentration_;
-  using ConstitutiveModel<EvalT, Traits>::have_total_bubble_density_;
-  using ConstitutiveModel<EvalT, Traits>::have_bubble_volume_fraction_;
-  using ConstitutiveModel<EvalT, Traits>::total_concentration_;
-  using ConstitutiveModel<EvalT, Traits>::total_bubble_density_;
-  using ConstitutiveModel<EvalT, Traits>::bubble_volume_fraction_;
-
   ///
   /// Constructor
   ///
-  ElastoViscoplasticModel(Teuchos::ParameterList* p,
-      const Teuchos::RCP<Albany::Layouts>& dl);
+  ElastoViscoplasticKernel(ConstitutiveModel<EvalT, Traits> & model,
+      Teuchos::ParameterList* p,
+      Teuchos::RCP<Albany::Layouts> const & dl);
 
   ///
-  /// Virtual Denstructor
+  /// No copy constructor
   ///
-  virtual
-  ~ElastoViscoplasticModel()
-  {};
+  ElastoViscoplasticKernel(ElastoViscoplasticKernel const &) = delete;
 
   ///
-  /// Method to compute the state (e.g. energy, stress, tangent)
+  /// No copy assignment
   ///
-  virtual
-  void
-  computeState(typename Traits::EvalData workset,
-      DepFieldMap dep_fields,
-      FieldMap eval_fields);
+  ElastoViscoplasticKernel &
+  operator=(ElastoViscoplasticKernel const &) = delete;
 
-  virtual
-  void
-  computeStateParallel(typename Traits::EvalData workset,
-      DepFieldMap dep_fields,
-      FieldMap eval_fields){
-         TEUCHOS_TEST_FOR_EXCEPTION(true, std::logic_error, "Not implemented.");
- }
-
-
-private:
-
-  ///
-  /// Private to prohibit copying
-  ///
-  ElastoViscoplasticModel(const ElastoViscoplasticModel&);
+  using ScalarT = typename EvalT::ScalarT;
+  using ScalarField = PHX::MDField<ScalarT>;
+  using ConstScalarField = PHX::MDField<ScalarT const>;
+  using BaseKernel = ParallelKernel<EvalT, Traits>;
+  using Workset = typename BaseKernel::Workset;
+  using Fad = typename Sacado::Fad::DFad<ScalarT>;
 
-  ///
-  /// Private to prohibit copying
-  ///
-  ElastoViscoplasticModel& operator=(const ElastoViscoplasticModel&);
+  using BaseKernel::num_dims_;
+  using BaseKernel::num_pts_;
+  using BaseKernel::field_name_map_;
 
-  ///
-  /// compute stresses
-  ///
-  // template<typename ArgT>
-  // void
-  // computeStress(minitensor::Tensor<ScalarT> const & F,
-  //     minitensor::Tensor<ArgT> const & Fp,
-  //     minitensor::Tensor<ArgT> & T,
-  //     minitensor::Tensor<ArgT> & S,
-  //     std::vector<ArgT> & shear) const;
+  // optional temperature support
+  using BaseKernel::have_temperature_;
+  using BaseKernel::expansion_coeff_;
+  using BaseKernel::ref_temperature_;
+  using BaseKernel::heat_capacity_;
+  using BaseKernel::density_;
+  using BaseKernel::temperature_;
+  using BaseKernel::have_total_concentration_;
+  using BaseKernel::have_total_bubble_density_;
+  using BaseKernel::have_bubble_volume_fraction_;
+  using BaseKernel::total_concentration_;
+  using BaseKernel::total_bubble_density_;
+  using BaseKernel::bubble_volume_fraction_;
+
+  using BaseKernel::setDependentField;
+  using BaseKernel::setEvaluatedField;
+  using BaseKernel::addStateVariable;
+  using BaseKernel::bindOptionalFields;
+
+  // Dependent MDFields
+  ConstScalarField def_grad_;
+  ConstScalarField J_;
+  ConstScalarField poissons_ratio_;
+  ConstScalarField elastic_modulus_;
+  ConstScalarField yield_strength_;
+  ConstScalarField hardening_modulus_;
+  ConstScalarField recovery_modulus_;
+  ConstScalarField flow_exp_;
+  ConstScalarField flow_coeff_;
+  ConstScalarField delta_time_;
+
+  // Evaluated MDFields
+  ScalarField stress_;
+  ScalarField Fp_;
+  ScalarField eqps_;
+  ScalarField eps_ss_;
+  ScalarField kappa_;
+  ScalarField void_volume_fraction_;
+  ScalarField source_;
+
+  // State variables
+  Albany::MDArray Fp_old_;
+  Albany::MDArray eqps_old_;
+  Albany::MDArray eps_ss_old_;
+  Albany::MDArray kappa_old_;
+  Albany::MDArray void_volume_fraction_old_;
 
   ///
   /// Initial Void Volume
-  ///xs
-  RealType f0_;
+  ///
+  RealType f0_{0.0};
 
   ///
   /// Shear Damage Parameter
   ///
-  RealType kw_;
+  RealType kw_{0.0};
 
   ///
   /// Void Nucleation Parameters
   ///
-  RealType eN_, sN_, fN_;
+  RealType eN_{0.0}, sN_{0.1}, fN_{0.0};
 
   ///
   /// Void Nucleation Parameters with H, He
   ///
-  RealType eHN_, eHN_coeff_, sHN_, fHeN_, fHeN_coeff_;
+  RealType eHN_{0.0}, eHN_coeff_{0.0}, sHN_{0.1}, fHeN_{0.0}, fHeN_coeff_{0.0};
 
   ///
   /// Critical Void Parameters
   ///
-  RealType fc_, ff_;
+  RealType fc_{1.0}, ff_{1.0};
 
   ///
   /// Gurson yield surface parameters
   ///
-  RealType q1_, q2_, q3_;
+  RealType q1_{1.0}, q2_{1.0}, q3_{1.0};
 
   ///
   /// Hydrogen and Helium yield surface parameters
   ///
-  RealType alpha1_, alpha2_, Ra_;
-
-  ///
-  /// Flow Rule Scale Factor
-  ///
-  RealType f_scale_;
+  RealType alpha1_{0.0}, alpha2_{0.0}, Ra_{0.0};
 
   ///
-  /// Solution options
+  /// flag to print convergence
   ///
-  bool apply_slip_predictor_;
-  minitensor::StepType step_type_;
-
-  RealType implicit_nonlinear_solver_relative_tolerance_;
-  RealType implicit_nonlinear_solver_absolute_tolerance_;
-  int implicit_nonlinear_solver_max_iterations_;
-  int implicit_nonlinear_solver_min_iterations_;
+  bool print_{false};
 
+  void
+  init(Workset & workset,
+      FieldMap<ScalarT const> & dep_fields,
+      FieldMap<ScalarT> & eval_fields);
 
-  ///
-  /// flag to print convergence
-  ///
-  bool print_;
+  KOKKOS_INLINE_FUNCTION
+  void
+  operator()(int cell, int pt) const;
 
   ///
   /// Compute effective void volume fraction
   ///
   template<typename T>
   T
-  compute_fstar(T f, RealType fc, RealType ff, RealType q1);
+  compute_fstar(T f, RealType fc, RealType ff, RealType q1) const;
+};
+
+//! \brief Elasto Viscoplastic Constitutive Model
+template<typename EvalT, typename Traits>
+class ElastoViscoplasticModel: public LCM::ParallelConstitutiveModel<EvalT,
+    Traits, ElastoViscoplasticKernel<EvalT, Traits>>
+{
+public:
 
+  ElastoViscoplasticModel(Teuchos::ParameterList* p,
+      const Teuchos::RCP<Albany::Layouts>& dl);
 };
 }
 
@@ -8,106 +8,104 @@
 #define GursonModel_hpp
 
 #include <MiniTensor.h>
-#include "Phalanx_config.hpp"
-#include "Phalanx_Evaluator_WithBaseImpl.hpp"
-#include "Phalanx_Evaluator_Derived.hpp"
-#include "Phalanx_MDField.hpp"
-#include "Albany_Layouts.hpp"
-#include "LCM/models/ConstitutiveModel.hpp"
+#include "ParallelConstitutiveModel.hpp"
 
 namespace LCM
 {
 
-//! \brief Gurson Finite Deformation Model
 template<typename EvalT, typename Traits>
-class GursonModel: public LCM::ConstitutiveModel<EvalT, Traits>
+struct GursonKernel : public ParallelKernel<EvalT, Traits>
 {
-public:
-
-  using Base = LCM::ConstitutiveModel<EvalT, Traits>;
-  using DepFieldMap = typename Base::DepFieldMap;
-  using FieldMap = typename Base::FieldMap;
-
-  typedef typename EvalT::ScalarT ScalarT;
-  typedef typename EvalT::MeshScalarT MeshScalarT;
-  typedef typename Sacado::mpl::apply<FadType, ScalarT>::type DFadType;
-
-  using ConstitutiveModel<EvalT, Traits>::num_dims_;
-  using ConstitutiveModel<EvalT, Traits>::num_pts_;
-  using ConstitutiveModel<EvalT, Traits>::field_name_map_;
-
   ///
   /// Constructor
   ///
-  GursonModel(Teuchos::ParameterList* p,
-      const Teuchos::RCP<Albany::Layouts>& dl);
+  GursonKernel(ConstitutiveModel<EvalT, Traits> & model,
+      Teuchos::ParameterList* p,
+      Teuchos::RCP<Albany::Layouts> const & dl);
 
   ///
-  /// Virtual Destructor
+  /// No copy constructor
   ///
-  virtual
-  ~GursonModel()
-  {};
+  GursonKernel(GursonKernel const &) = delete;
 
   ///
-  /// Method to compute the state (e.g. energy, stress, tangent)
+  /// No copy assignment
   ///
-  virtual
-  void
-  computeState(typename Traits::EvalData workset,
-      DepFieldMap dep_fields,
-      FieldMap eval_fields);
+  GursonKernel &
+  operator=(GursonKernel const &) = delete;
 
-  virtual
-  void
-  computeStateParallel(typename Traits::EvalData workset,
-      DepFieldMap dep_fields,
-      FieldMap eval_fields){
-         TEUCHOS_TEST_FOR_EXCEPTION(true, std::logic_error, "Not implemented.");
- }
+  using ScalarT = typename EvalT::ScalarT;
+  using ScalarField = PHX::MDField<ScalarT>;
+  using ConstScalarField = PHX::MDField<ScalarT const>;
+  using BaseKernel = ParallelKernel<EvalT, Traits>;
+  using Workset = typename BaseKernel::Workset;
+  using DFadType = typename Sacado::mpl::apply<FadType, ScalarT>::type;
 
+  using BaseKernel::num_dims_;
+  using BaseKernel::num_pts_;
+  using BaseKernel::field_name_map_;
 
-private:
+  using BaseKernel::setDependentField;
+  using BaseKernel::setEvaluatedField;
+  using BaseKernel::addStateVariable;
 
-  ///
-  /// Private to prohibit copying
-  ///
-  GursonModel(const GursonModel&);
+  // Dependent MDFields
+  ConstScalarField def_grad_;
+  ConstScalarField J_;
+  ConstScalarField poissons_ratio_;
+  ConstScalarField elastic_modulus_;
+  ConstScalarField yield_strength_;
+  ConstScalarField hardening_modulus_;
 
-  ///
-  /// Private to prohibit copying
-  ///
-  GursonModel& operator=(const GursonModel&);
+  // Evaluated MDFields
+  ScalarField stress_;
+  ScalarField Fp_;
+  ScalarField eqps_;
+  ScalarField void_volume_;
+
+  // State variables
+  Albany::MDArray Fp_old_;
+  Albany::MDArray eqps_old_;
+  Albany::MDArray void_volume_old_;
 
   ///
   /// Saturation hardening constants
   ///
-  RealType sat_mod_, sat_exp_;
+  RealType sat_mod_{0.0}, sat_exp_{0.0};
 
   ///
   /// Initial Void Volume
   ///
-  RealType f0_;
+  RealType f0_{0.0};
 
   ///
   /// Shear Damage Parameter
   ///
-  RealType kw_;
+  RealType kw_{0.0};
 
   ///
   /// Void Nucleation Parameters
   ///
-  RealType eN_, sN_, fN_;
+  RealType eN_{0.0}, sN_{0.1}, fN_{0.0};
 
   ///
   /// Critical Void Parameters
   ///
-  RealType fc_, ff_;
+  RealType fc_{1.0}, ff_{1.0};
 
   ///
   /// Yield Parameters
   ///
-  RealType q1_, q2_, q3_;
+  RealType q1_{1.0}, q2_{1.0}, q3_{1.0};
+
+  void
+  init(Workset & workset,
+      FieldMap<ScalarT const> & dep_fields,
+      FieldMap<ScalarT> & eval_fields);
+
+  KOKKOS_INLINE_FUNCTION
+  void
+  operator()(int cell, int pt) const;
 
   ///
   /// Compute Yield Function
@@ -115,7 +113,7 @@ private:
   ScalarT
   YieldFunction(minitensor::Tensor<ScalarT> const & s, ScalarT const & p,
       ScalarT const & fvoid, ScalarT const & eq, ScalarT const & K,
-      ScalarT const & Y, ScalarT const & jacobian, ScalarT const & E);
+      ScalarT const & Y, ScalarT const & jacobian, ScalarT const & E) const;
 
   ///
   /// Compute Residual and Local Jacobian
@@ -125,8 +123,18 @@ private:
       std::vector<ScalarT> & R, std::vector<ScalarT> & dRdX, const ScalarT & p,
       const ScalarT & fvoid, const ScalarT & eq, minitensor::Tensor<ScalarT> & s,
       const ScalarT & mu, const ScalarT & kappa, const ScalarT & K,
-      const ScalarT & Y, const ScalarT & jacobian);
+      const ScalarT & Y, const ScalarT & jacobian) const;
+};
 
+//! \brief Gurson Finite Deformation Model
+template<typename EvalT, typename Traits>
+class GursonModel: public LCM::ParallelConstitutiveModel<EvalT, Traits,
+    GursonKernel<EvalT, Traits>>
+{
+public:
+
+  GursonModel(Teuchos::ParameterList* p,
+      const Teuchos::RCP<Albany::Layouts>& dl);
 };
 }
 
@@ -8,6 +8,17 @@
 
 #include "J2Model.hpp"
 #include "J2Model_Def.hpp"
+#include "ParallelConstitutiveModel_Def.hpp"
 
-PHAL_INSTANTIATE_TEMPLATE_CLASS(LCM::J2Model)
+template <typename EvalT, typename Traits>
+LCM::J2Model<EvalT, Traits>::J2Model(
+    Teuchos::ParameterList*              p,
+    const Teuchos::RCP<Albany::Layouts>& dl)
+    : LCM::ParallelConstitutiveModel<EvalT, Traits, J2Kernel<EvalT, Traits>>(
+          p,
+          dl)
+{
+}
 
+PHAL_INSTANTIATE_TEMPLATE_CLASS(LCM::J2Kernel)
+PHAL_INSTANTIATE_TEMPLATE_CLASS(LCM::J2Model)
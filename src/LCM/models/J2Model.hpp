@@ -7,81 +7,98 @@
 #if !defined(LCM_J2Model_hpp)
 #define LCM_J2Model_hpp
 
-#include "Albany_Layouts.hpp"
-#include "LCM/models/ConstitutiveModel.hpp"
-#include "Phalanx_Evaluator_Derived.hpp"
-#include "Phalanx_Evaluator_WithBaseImpl.hpp"
-#include "Phalanx_MDField.hpp"
-#include "Phalanx_config.hpp"
+#include "ParallelConstitutiveModel.hpp"
 
 namespace LCM {
 
-//! \brief J2 Plasticity Constitutive Model
-template<typename EvalT, typename Traits>
-class J2Model : public LCM::ConstitutiveModel<EvalT, Traits> {
- public:
-  using Base        = LCM::ConstitutiveModel<EvalT, Traits>;
-  using DepFieldMap = typename Base::DepFieldMap;
-  using FieldMap    = typename Base::FieldMap;
-
-  typedef typename EvalT::ScalarT     ScalarT;
-  typedef typename EvalT::MeshScalarT MeshScalarT;
-
-  using ConstitutiveModel<EvalT, Traits>::num_dims_;
-  using ConstitutiveModel<EvalT, Traits>::num_pts_;
-  using ConstitutiveModel<EvalT, Traits>::field_name_map_;
-
-  // optional temperature support
-  using ConstitutiveModel<EvalT, Traits>::have_temperature_;
-  using ConstitutiveModel<EvalT, Traits>::expansion_coeff_;
-  using ConstitutiveModel<EvalT, Traits>::ref_temperature_;
-  using ConstitutiveModel<EvalT, Traits>::heat_capacity_;
-  using ConstitutiveModel<EvalT, Traits>::density_;
-  using ConstitutiveModel<EvalT, Traits>::temperature_;
-
+template <typename EvalT, typename Traits>
+struct J2Kernel : public ParallelKernel<EvalT, Traits>
+{
   ///
   /// Constructor
   ///
-  J2Model(Teuchos::ParameterList* p, const Teuchos::RCP<Albany::Layouts>& dl);
+  J2Kernel(
+      ConstitutiveModel<EvalT, Traits>&    model,
+      Teuchos::ParameterList*              p,
+      Teuchos::RCP<Albany::Layouts> const& dl);
 
   ///
-  /// Virtual Denstructor
+  /// No copy constructor
   ///
-  virtual ~J2Model(){};
+  J2Kernel(J2Kernel const&) = delete;
 
   ///
-  /// Method to compute the state (e.g. energy, stress, tangent)
+  /// No copy assignment
   ///
-  virtual void
-  computeState(
-      typename Traits::EvalData workset,
-      DepFieldMap               dep_fields,
-      FieldMap                  eval_fields);
+  J2Kernel&
+  operator=(J2Kernel const&) = delete;
 
- private:
-  ///
-  /// Private to prohibit copying
-  ///
-  J2Model(const J2Model&);
+  using ScalarT          = typename EvalT::ScalarT;
+  using ScalarField      = PHX::MDField<ScalarT>;
+  using ConstScalarField = PHX::MDField<ScalarT const>;
+  using BaseKernel       = ParallelKernel<EvalT, Traits>;
+  using Workset          = typename BaseKernel::Workset;
 
-  ///
-  /// Private to prohibit copying
-  ///
-  J2Model&
-  operator=(const J2Model&);
+  using BaseKernel::field_name_map_;
+  using BaseKernel::num_dims_;
+  using BaseKernel::num_pts_;
 
-  ///
-  /// Saturation hardening constants
-  ///
-  RealType sat_mod_, sat_exp_;
-
-  // Kokkos
-  virtual void
-  computeStateParallel(
-      typename Traits::EvalData workset,
-      DepFieldMap               dep_fields,
-      FieldMap                  eval_fields);
+  // optional temperature support
+  using BaseKernel::density_;
+  using BaseKernel::expansion_coeff_;
+  using BaseKernel::have_temperature_;
+  using BaseKernel::heat_capacity_;
+  using BaseKernel::ref_temperature_;
+  using BaseKernel::temperature_;
+
+  using BaseKernel::addStateVariable;
+  using BaseKernel::bindOptionalFields;
+  using BaseKernel::setDependentField;
+  using BaseKernel::setEvaluatedField;
+
+  // Dependent MDFields
+  ConstScalarField def_grad_;
+  ConstScalarField delta_time_;
+  ConstScalarField elastic_modulus_;
+  ConstScalarField hardening_modulus_;
+  ConstScalarField J_;
+  ConstScalarField poissons_ratio_;
+  ConstScalarField yield_strength_;
+
+  // Evaluated MDFields
+  ScalarField eqps_;
+  ScalarField Fp_;
+  ScalarField source_;
+  ScalarField stress_;
+  ScalarField yield_surf_;
+
+  // State variables
+  Albany::MDArray Fp_old_;
+  Albany::MDArray eqps_old_;
+
+  // Saturation hardening constants
+  RealType sat_mod_{0.0};
+  RealType sat_exp_{0.0};
+
+  void
+  init(
+      Workset&                 workset,
+      FieldMap<ScalarT const>& dep_fields,
+      FieldMap<ScalarT>&       eval_fields);
+
+  KOKKOS_INLINE_FUNCTION
+  void
+  operator()(int cell, int pt) const;
+};
+
+//! \brief J2 Plasticity Constitutive Model
+template <typename EvalT, typename Traits>
+class J2Model
+    : public LCM::ParallelConstitutiveModel<EvalT, Traits, J2Kernel<EvalT, Traits>>
+{
+ public:
+  J2Model(Teuchos::ParameterList* p, const Teuchos::RCP<Albany::Layouts>& dl);
 };
-}
+}  // namespace LCM
 
 #endif
@@ -103,6 +103,13 @@ protected:
                                   std::vector<Teuchos::RCP<ScalarField>> & state,
                                   FieldMap<ScalarT> & eval_fields);
 
+  ///
+  /// The optional fields (temperature, concentrations, ...) are bound
+  /// to the model in postRegistrationSetup, after the kernel has been
+  /// constructed. Kernels that read them refresh their copies in init().
+  ///
+  void bindOptionalFields();
+
   ConstitutiveModel<EvalT, Traits> &
   model_;
 
@@ -126,5 +126,21 @@ extractEvaluatedFieldArray(std::string const & field_name,
   }
 }
 
+
+template<typename EvalT, typename Traits>
+inline void
+ParallelKernel<EvalT, Traits>::
+bindOptionalFields()
+{
+  coord_vec_ = model_.coord_vec_;
+  temperature_ = model_.temperature_;
+  total_concentration_ = model_.total_concentration_;
+  total_bubble_density_ = model_.total_bubble_density_;
+  bubble_volume_fraction_ = model_.bubble_volume_fraction_;
+  damage_ = model_.damage_;
+  weights_ = model_.weights_;
+  j_ = model_.j_;
+}
+
 }
 
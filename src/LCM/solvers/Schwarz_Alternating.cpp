@@ -95,7 +95,6 @@ SchwarzAlternating(
   sub_outargs_.resize(num_subdomains_);
   curr_disp_.resize(num_subdomains_);
   prev_step_disp_.resize(num_subdomains_);
-  internal_states_.resize(num_subdomains_);
   //the following 9 arrays are for dynamics
   ics_disp_.resize(num_subdomains_);
   ics_velo_.resize(num_subdomains_);
@@ -598,107 +597,6 @@ printInternalElementStates(
   }
 }
 
-void
-toFrom(LCM::StateArrayVec & dst, Albany::StateArrayVec const & src)
-{
-  auto const
-  num_maps = src.size();
-
-  dst.resize(num_maps);
-
-  for (auto i = 0; i < num_maps; ++i) {
-    auto &&
-    src_map = src[i];
-
-    auto &&
-    dst_map = dst[i];
-
-    for (auto && kv : src_map) {
-
-      auto &&
-      state_name = kv.first;
-
-      auto &&
-      src_states = kv.second;
-
-      auto &&
-      dst_states = dst_map[state_name];
-
-      auto const
-      num_states = src_states.size();
-
-      dst_states.resize(num_states);
-
-      for (auto j = 0; j < num_states; ++j) {
-        dst_states[j] = src_states[j];
-      }
-
-    }
-  }
-  return;
-}
-
-void
-toFrom(Albany::StateArrayVec & dst, LCM::StateArrayVec const & src)
-{
-  auto const
-  num_maps = src.size();
-
-  ALBANY_ASSERT(num_maps == dst.size(),
-      "Inconsistent number of state maps from LCM to Albany");
-
-  for (auto i = 0; i < num_maps; ++i) {
-    auto &&
-    src_map = src[i];
-
-    auto &&
-    dst_map = dst[i];
-
-    for (auto && kv : src_map) {
-
-      auto &&
-      state_name = kv.first;
-
-      auto &&
-      src_states = kv.second;
-
-      ALBANY_ASSERT(dst_map.find(state_name) != dst_map.end(),
-          "Missing state name in transfer from LCM to Albany: " + state_name);
-
-      auto &&
-      dst_states = dst_map[state_name];
-
-      auto const
-      num_states = src_states.size();
-
-      ALBANY_ASSERT(num_states == dst_states.size(),
-          "Inconsistent number of state entries from LCM to Albany");
-
-      for (auto j = 0; j < num_states; ++j) {
-        dst_states[j] = src_states[j];
-      }
-
-    }
-  }
-  return;
-}
-
-void
-toFrom(LCM::StateArrays & dst, Albany::StateArrays const & src)
-{
-  toFrom(dst.element_state_arrays, src.elemStateArrays);
-  toFrom(dst.node_state_arrays, src.nodeStateArrays);
-  return;
-}
-
-void
-toFrom(Albany::StateArrays & dst, LCM::StateArrays const & src)
-{
-  toFrom(dst.elemStateArrays, src.element_state_arrays);
-  toFrom(dst.nodeStateArrays, src.node_state_arrays);
-  return;
-}
-
 } // anonymous
 
 //
@@ -845,10 +743,10 @@ SchwarzLoopDynamics() const
       fos << "DEBUG: Getting internal states subdomain = "
           << subdomain << "...\n";
 #endif
-      toFrom(internal_states_[subdomain], state_mgr.getStateArrays());
+      state_mgr.saveStates();
 #ifdef DEBUG
       printInternalElementStates(
-          internal_states_[subdomain], state_mgr.getStateInfoStruct());
+          state_mgr.getStateArrays(), state_mgr.getStateInfoStruct());
       fos << "DEBUG: ...done setting internal states subdomain = "
           << subdomain << ".\n";
 #endif
@@ -934,10 +832,11 @@ SchwarzLoopDynamics() const
         fos << "DEBUG: Setting internal states subdomain = "
             << subdomain << "...\n";
 #endif 
-        toFrom(state_mgr.getStateArrays(), internal_states_[subdomain]);
+        // Nothing to roll back before the first solve of the step.
+        if (num_iter_ > 0) state_mgr.restoreStates();
 #ifdef DEBUG
         printInternalElementStates(
-            internal_states_[subdomain], state_mgr.getStateInfoStruct());
+            state_mgr.getStateArrays(), state_mgr.getStateInfoStruct());
         fos << "DEBUG: ...done setting internal states subdomain = "
             << subdomain << ".\n";
 #endif
@@ -1231,8 +1130,9 @@ SchwarzLoopDynamics() const
         time_step = min_time_step_;
       }
 
-      // Restore previous solutions
+      // Restore previous solutions and internal states
       for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+        apps_[subdomain]->getStateMgr().restoreStates();
         Thyra::put_scalar(0.0, this_disp_[subdomain].ptr());
         Thyra::copy(*this_disp_[subdomain], prev_disp_[subdomain].ptr());
         Thyra::put_scalar(0.0, this_velo_[subdomain].ptr());
@@ -1488,7 +1388,7 @@ SchwarzLoopQuasistatics() const
       auto &
       state_mgr = app.getStateMgr();
 
-      toFrom(internal_states_[subdomain], state_mgr.getStateArrays());
+      state_mgr.saveStates();
 
     }
 
@@ -1526,7 +1426,8 @@ SchwarzLoopQuasistatics() const
         auto &
         state_mgr = app.getStateMgr();
 
-        toFrom(state_mgr.getStateArrays(), internal_states_[subdomain]);
+        // Nothing to roll back before the first solve of the step.
+        if (num_iter_ > 0) state_mgr.restoreStates();
 
         // Restore solution from previous time step
         auto
@@ -1682,8 +1583,9 @@ SchwarzLoopQuasistatics() const
         time_step = min_time_step_;
       }
 
-      // Restore previous solutions
+      // Restore previous solutions and internal states
       for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+        apps_[subdomain]->getStateMgr().restoreStates();
         curr_disp_[subdomain] = prev_step_disp_[subdomain];
       }
 
@@ -6,6 +6,9 @@
 #include "Albany_GenericSTKMeshStruct.hpp"
 #include "Albany_STKDiscretization.hpp"
 #include "Albany_Utils.hpp"
+#include "Intrepid2_CellTools.hpp"
+#include "Intrepid2_HGRAD_HEX_C1_FEM.hpp"
+#include "Intrepid2_HGRAD_TET_C1_FEM.hpp"
 #include "Schwarz_BoundaryJacobian.hpp"
 #include "Teuchos_ParameterListExceptions.hpp"
 #include "Teuchos_TestForException.hpp"
@@ -59,25 +62,318 @@ initialize()
 //
 // Returns explicit matrix representation of operator if available.
 //
+// The Schwarz BC residual at a coupled node set node is
+//
+//   f_i = x_i - sum_k N_k(xi) u_k
+//
+// where N_k are the shape functions of the coupled_app element that
+// contains the node and u_k the coupled_app nodal values. The operator is
+// the derivative of f with respect to u, and as the shape functions are
+// evaluated on the reference configuration it only depends on the meshes.
+// It is not scaled by the Jacobian coefficient, that is left to the caller.
+//
 Teuchos::RCP<Tpetra_CrsMatrix>
 Schwarz_BoundaryJacobian::
 getExplicitOperator() const
 {
+  if (explicit_operator_ != Teuchos::null) return explicit_operator_;
+
+  auto const
+  this_app_index = getThisAppIndex();
+
+  auto const
+  coupled_app_index = getCoupledAppIndex();
+
+  Albany::Application const &
+  this_app = getApplication(this_app_index);
+
+  Albany::Application const &
+  coupled_app = getApplication(coupled_app_index);
+
+  // No Schwarz BC couples this_app to coupled_app, the block is empty.
+  if (this_app_index == coupled_app_index ||
+      this_app.isCoupled(coupled_app_index) == false) {
+    explicit_operator_ = Teuchos::rcp(
+        new Tpetra_CrsMatrix(getRangeMap(), 1));
+    explicit_operator_->fillComplete(getDomainMap(), getRangeMap());
+    return explicit_operator_;
+  }
+
+  Teuchos::RCP<Albany::AbstractDiscretization>
+  this_disc = this_app.getDiscretization();
+
+  auto *
+  this_stk_disc = static_cast<Albany::STKDiscretization *>(this_disc.get());
+
+  Teuchos::RCP<Albany::AbstractDiscretization>
+  coupled_disc = coupled_app.getDiscretization();
+
+  auto *
+  coupled_stk_disc =
+      static_cast<Albany::STKDiscretization *>(coupled_disc.get());
+
+  auto &
+  coupled_gms = dynamic_cast<Albany::GenericSTKMeshStruct &>
+      (*(coupled_stk_disc->getSTKMeshStruct()));
+
+  auto const &
+  coupled_ws_eb_names = coupled_disc->getWsEBNames();
+
+  Teuchos::ArrayRCP<Teuchos::RCP<Albany::MeshSpecsStruct>>
+  coupled_mesh_specs = coupled_gms.getMeshSpecs();
+
+  std::string const
+  coupled_block_name = this_app.getCoupledBlockName(coupled_app_index);
+
+  bool const
+  use_block = coupled_block_name != "NONE";
+
+  std::map<std::string, int> const &
+  coupled_block_name_to_index = coupled_gms.ebNameToIndex;
+
+  auto
+  it = coupled_block_name_to_index.find(coupled_block_name);
+
+  ALBANY_ASSERT(
+      use_block == false || it != coupled_block_name_to_index.end(),
+      "Unknown coupled block: " << coupled_block_name);
+
+  auto const
+  coupled_block_index = use_block == true ? it->second : 0;
+
+  CellTopologyData const
+  coupled_cell_topology_data = coupled_mesh_specs[coupled_block_index]->ctd;
+
+  shards::CellTopology
+  coupled_cell_topology(&coupled_cell_topology_data);
+
+  auto const
+  coupled_dimension = coupled_cell_topology_data.dimension;
+
+  auto const
+  coupled_node_count = coupled_cell_topology_data.node_count;
+
+  auto const
+  coupled_vertex_count = coupled_cell_topology_data.vertex_count;
+
+  auto const
+  parametric_dimension = coupled_dimension;
+
+  // neq should be the same for this_app and coupled_app.
+  ALBANY_EXPECT(this_app.getNumEquations() == coupled_app.getNumEquations());
+
   auto const
-  max_num_cols = getDomainMap()->getNodeNumElements();
+  neq = this_app.getNumEquations();
 
-  Teuchos::RCP<Tpetra_CrsMatrix>
-  K = Teuchos::rcp(
-      new Tpetra_CrsMatrix(getRangeMap(), getDomainMap(), max_num_cols));
+  ALBANY_ASSERT(
+      neq >= coupled_dimension,
+      "Schwarz coupling requires at least one equation per dimension");
+
+  std::string const &
+  coupled_nodeset_name = this_app.getNodesetName(coupled_app_index);
+
+  std::vector<std::vector<int>> const &
+  ns_dof = this_stk_disc->getNodeSets().find(coupled_nodeset_name)->second;
+
+  std::vector<double *> const &
+  ns_coord =
+      this_stk_disc->getNodeSetCoords().find(coupled_nodeset_name)->second;
+
+  auto const &
+  ws_elem_to_node_id = coupled_stk_disc->getWsElNodeID();
+
+  Teuchos::ArrayRCP<double> const &
+  coupled_coordinates = coupled_stk_disc->getCoordinates();
+
+  Teuchos::RCP<Tpetra_Map const>
+  coupled_overlap_node_map = coupled_stk_disc->getOverlapNodeMapT();
+
+  // Same tolerance and parametric bounds as SchwarzBC::computeBCs so that
+  // the Jacobian is consistent with the residual.
+  double const
+  tolerance = 5.0e-2;
 
   auto const
-  zero = Teuchos::ScalarTraits<ST>::zero();
+  coupled_element_type =
+        minitensor::find_type(coupled_dimension, coupled_vertex_count);
+
+  minitensor::Vector<double>
+  lo(parametric_dimension, minitensor::Filler::ONES);
+
+  minitensor::Vector<double>
+  hi(parametric_dimension, minitensor::Filler::ONES);
+
+  hi = hi * (1.0 + tolerance);
+
+  Teuchos::RCP<Intrepid2::Basis<PHX::Device, RealType, RealType>>
+  basis;
+
+  switch (coupled_element_type) {
 
-  K->setAllToScalar(zero);
+  default:
+    MT_ERROR_EXIT("Unknown element type");
+    break;
 
-  K->fillComplete();
+  case minitensor::ELEMENT::TETRAHEDRAL:
+    basis = Teuchos::rcp(new Intrepid2::Basis_HGRAD_TET_C1_FEM<PHX::Device>());
+    lo = - tolerance * lo;
+    break;
 
-  return K;
+  case minitensor::ELEMENT::HEXAHEDRAL:
+    basis = Teuchos::rcp(new Intrepid2::Basis_HGRAD_HEX_C1_FEM<PHX::Device>());
+    lo = - lo * (1.0 + tolerance);
+    break;
+  }
+
+  auto const
+  number_cells = 1;
+
+  auto const
+  number_points = 1;
+
+  Kokkos::DynRankView<RealType, PHX::Device>
+  parametric_point(
+      "par_point",
+      number_cells,
+      number_points,
+      parametric_dimension);
+
+  Kokkos::DynRankView<RealType, PHX::Device>
+  physical_coordinates(
+      "phys_point",
+      number_cells,
+      number_points,
+      coupled_dimension);
+
+  Kokkos::DynRankView<RealType, PHX::Device>
+  nodal_coordinates(
+      "coords",
+      number_cells,
+      coupled_node_count,
+      coupled_dimension);
+
+  Kokkos::DynRankView<RealType, PHX::Device>
+  basis_values("basis", coupled_node_count, number_points);
+
+  Kokkos::DynRankView<RealType, PHX::Device>
+  pp_reduced("par_point", number_points, parametric_dimension);
+
+  // Each coupled row depends on the nodes of a single element.
+  explicit_operator_ = Teuchos::rcp(
+      new Tpetra_CrsMatrix(getRangeMap(), coupled_node_count));
+
+  Teuchos::RCP<Tpetra_Map const>
+  this_map = getRangeMap();
+
+  Teuchos::Array<Tpetra_GO>
+  column_indices(coupled_node_count);
+
+  Teuchos::Array<ST>
+  column_values(coupled_node_count);
+
+  std::vector<Tpetra_GO>
+  element_node_gids(coupled_node_count);
+
+  for (auto ns_node = 0; ns_node < ns_dof.size(); ++ns_node) {
+
+    double * const
+    coord = ns_coord[ns_node];
+
+    for (auto i = 0; i < coupled_dimension; ++i) {
+      physical_coordinates(0, 0, i) = coord[i];
+    }
+
+    bool
+    found = false;
+
+    for (auto workset = 0; workset < ws_elem_to_node_id.size(); ++workset) {
+
+      bool const
+      block_names_differ =
+          coupled_ws_eb_names[workset] != coupled_block_name;
+
+      if (use_block == true && block_names_differ == true) continue;
+
+      auto const
+      elements_per_workset = ws_elem_to_node_id[workset].size();
+
+      for (auto element = 0; element < elements_per_workset; ++element) {
+
+        for (auto node = 0; node < coupled_node_count; ++node) {
+
+          auto const
+          global_node_id = ws_elem_to_node_id[workset][element][node];
+
+          auto const
+          local_node_id =
+              coupled_overlap_node_map->getLocalElement(global_node_id);
+
+          element_node_gids[node] = global_node_id;
+
+          for (auto j = 0; j < coupled_dimension; ++j) {
+            nodal_coordinates(0, node, j) =
+                coupled_coordinates[coupled_dimension * local_node_id + j];
+          }
+        }
+
+        Intrepid2::CellTools<PHX::Device>::mapToReferenceFrame(
+            parametric_point,
+            physical_coordinates,
+            nodal_coordinates,
+            coupled_cell_topology);
+
+        bool
+        in_element = true;
+
+        for (auto i = 0; i < parametric_dimension; ++i) {
+          auto const
+          xi = parametric_point(0, 0, i);
+          in_element = in_element && lo(i) <= xi && xi <= hi(i);
+        }
+
+        if (in_element == true) {
+          found = true;
+          break;
+        }
+
+      } // element loop
+
+      if (found == true) break;
+
+    } // workset loop
+
+    ALBANY_EXPECT(found == true);
+
+    for (auto j = 0; j < parametric_dimension; ++j) {
+      pp_reduced(0, j) = parametric_point(0, 0, j);
+    }
+
+    basis->getValues(basis_values, pp_reduced, Intrepid2::OPERATOR_VALUE);
+
+    // One row per displacement component, coupling the same component
+    // of the nodes of the containing element.
+    for (auto i = 0; i < coupled_dimension; ++i) {
+
+      Tpetra_GO const
+      row = this_map->getGlobalElement(ns_dof[ns_node][i]);
+
+      for (auto node = 0; node < coupled_node_count; ++node) {
+        column_indices[node] =
+            coupled_stk_disc->getGlobalDOF(element_node_gids[node], i);
+        column_values[node] = - basis_values(node, 0);
+      }
+
+      explicit_operator_->insertGlobalValues(
+          row,
+          column_indices(),
+          column_values());
+    }
+
+  } // node set node loop
+
+  explicit_operator_->fillComplete(getDomainMap(), getRangeMap());
+
+  return explicit_operator_;
 }
 
 //
@@ -93,10 +389,7 @@ apply(
     ST alpha,
     ST beta) const
 {
-  auto const
-  zero = Teuchos::ScalarTraits<ST>::zero();
-
-  Y.putScalar(zero);
+  getExplicitOperator()->apply(X, Y, mode, alpha, beta);
 }
 
 } //namespace LCM
@@ -56,7 +56,8 @@ public:
       ST alpha = Teuchos::ScalarTraits<ST>::one(),
       ST beta = Teuchos::ScalarTraits<ST>::zero()) const;
 
-  /// Returns explicit matrix representation of operator if available.
+  /// Returns explicit matrix representation of operator. It is assembled
+  /// from the Schwarz interpolation weights on first use and then reused.
   Teuchos::RCP<Tpetra_CrsMatrix>
   getExplicitOperator() const;
 
@@ -143,6 +144,9 @@ private:
   Teuchos::RCP<Tpetra_Map const>
   range_map_;
 
+  mutable Teuchos::RCP<Tpetra_CrsMatrix>
+  explicit_operator_;
+
   Teuchos::RCP<Teuchos_Comm const>
   comm_;
 
@@ -105,6 +105,12 @@ SchwarzCoupled(
     ALBANY_ASSERT(false, "Unknown Matrix-Free Preconditioner type.");
   }
 
+  // Assemble the off-diagonal blocks of the coupled Jacobian from the
+  // Schwarz interpolation weights. Without them the coupled Jacobian is
+  // block diagonal, which is all that is needed for matrix-free runs.
+  assemble_off_diagonal_ =
+      coupled_system_params.get<bool>("Off-Diagonal Coupling", false);
+
   // If using matrix-free, get NOX sublist and set "Preconditioner Type" to
   // "None" regardless  of what is specified in the input file.
   // Currently preconditioners for matrix-free  are implemented in this
@@ -767,7 +773,20 @@ SchwarzCoupled::create_W_op() const
   Schwarz_CoupledJacobian
   jac(comm_);
 
-  return jac.getThyraCoupledJacobian(jacs_, apps_);
+  return jac.getThyraCoupledJacobian(jacs_, apps_, getCouplingBlocks());
+}
+
+Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> const &
+SchwarzCoupled::getCouplingBlocks() const
+{
+  if (assemble_off_diagonal_ == true && coupling_blocks_.size() == 0) {
+    Schwarz_CoupledJacobian
+    jac(comm_);
+
+    coupling_blocks_ = jac.getCouplingBlocks(jacs_, apps_);
+  }
+
+  return coupling_blocks_;
 }
 
 Teuchos::RCP<Thyra::PreconditionerBase<ST>>
@@ -1064,9 +1083,10 @@ evalModelImpl(
           sacado_param_vecs_[m], fTs_out[m].get(), *jacs_[m]);
       fs_already_computed[m] = true;
     }
-    // FIXME: create coupled W matrix from array of model W matrices
+    // The Schwarz BC scales its rows by beta, so scale the coupling too.
     Schwarz_CoupledJacobian jac(comm_);
-    W_op_outT = jac.getThyraCoupledJacobian(jacs_, apps_);
+    W_op_outT =
+        jac.getThyraCoupledJacobian(jacs_, apps_, getCouplingBlocks(), beta);
   }
 
   for (auto m = 0; m < num_models_; ++m) {
@@ -1331,6 +1351,10 @@ getValidAppParameters() const
       "Matrix-Free Preconditioner",
       "",
       "Matrix-Free Preconditioner Type");
+  list->set<bool>(
+      "Off-Diagonal Coupling",
+      false,
+      "Assemble the off-diagonal Schwarz coupling blocks of the Jacobian");
 
   return list;
 }
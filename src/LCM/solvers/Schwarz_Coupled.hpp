@@ -147,6 +147,11 @@ private:
   Thyra::ModelEvaluatorBase::InArgs<ST>
   createInArgsImpl() const;
 
+  /// Off-diagonal Schwarz coupling blocks, assembled on first use.
+  /// Empty if "Off-Diagonal Coupling" is not enabled.
+  Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> const &
+  getCouplingBlocks() const;
+
   /// List of free parameter names
   Teuchos::Array<Teuchos::RCP<Teuchos::Array<std::string>>>
   param_names_;
@@ -216,6 +221,13 @@ private:
 
   bool supports_xdot_;
 
+  /// Whether the Jacobian includes the off-diagonal coupling blocks
+  bool assemble_off_diagonal_;
+
+  /// Cached off-diagonal blocks, block (i, j) at i * num_models_ + j
+  mutable Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>>
+  coupling_blocks_;
+
   enum MF_PREC_TYPE {NONE, JACOBI, ABS_ROW_SUM, ID};
 
   MF_PREC_TYPE mf_prec_type_;
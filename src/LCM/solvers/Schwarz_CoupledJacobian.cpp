@@ -10,6 +10,7 @@
 #include "Teuchos_TestForException.hpp"
 #include "Teuchos_VerboseObject.hpp"
 #include "Thyra_DefaultBlockedLinearOp.hpp"
+#include "Thyra_DefaultScaledAdjointLinearOp.hpp"
 
 //#define WRITE_TO_MATRIX_MARKET
 
@@ -35,8 +36,37 @@ Schwarz_CoupledJacobian::
   return;
 }
 
-//#define USE_OFF_DIAGONAL
-//#define EXPLICIT_OFF_DIAGONAL
+//
+// Assemble the sparse coupling blocks for every pair of applications
+// related by a Schwarz BC. Block (i, j) is stored at i * block_dim + j and
+// is null when application i is not coupled to application j.
+//
+Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>>
+Schwarz_CoupledJacobian::
+getCouplingBlocks(
+    Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> jacs,
+    Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca)
+const
+{
+  auto const
+  block_dim = jacs.size();
+
+  Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>>
+  coupling_blocks(block_dim * block_dim);
+
+  for (std::size_t i = 0; i < block_dim; i++) {
+    for (std::size_t j = 0; j < block_dim; j++) {
+      if (i == j || ca[i]->isCoupled(j) == false) continue;
+
+      Schwarz_BoundaryJacobian
+      jac_boundary(comm_, ca, jacs, i, j);
+
+      coupling_blocks[i * block_dim + j] = jac_boundary.getExplicitOperator();
+    }
+  }
+
+  return coupling_blocks;
+}
 
 // getThyraCoupledJacobian method is similar to getThyraMatrix in panzer
 //(Panzer_BlockedTpetraLinearObjFactory_impl.hpp).
@@ -44,12 +74,17 @@ Teuchos::RCP<Thyra::LinearOpBase<ST>>
 Schwarz_CoupledJacobian::
 getThyraCoupledJacobian(
     Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> jacs,
-    Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca)
+    Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca,
+    Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> const & coupling_blocks,
+    ST const j_coeff)
 const
 {
   auto const
   block_dim = jacs.size();
 
+  bool const
+  use_off_diagonal = coupling_blocks.size() == block_dim * block_dim;
+
 #ifdef WRITE_TO_MATRIX_MARKET
   char name[100];  //create string for file name
 
@@ -75,35 +110,21 @@ const
         Teuchos::RCP<Thyra::LinearOpBase<ST>>
         block = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(jacs[i]);
         blocked_op->setNonconstBlock(i, j, block);
-      } else { // Off-diagonal blocks
-#if defined(USE_OFF_DIAGONAL)
-#if defined(EXPLICIT_OFF_DIAGONAL)
+      } else if (use_off_diagonal == true) { // Off-diagonal blocks
+        Teuchos::RCP<Tpetra_CrsMatrix> const &
+        coupling = coupling_blocks[i * block_dim + j];
 
-        Teuchos::RCP<Schwarz_BoundaryJacobian>
-        jac_boundary =
-            Teuchos::rcp(
-                new Schwarz_BoundaryJacobian(comm_, ca, jacs, i, j));
-
-        Teuchos::RCP<Tpetra_CrsMatrix>
-        exp_jac = jac_boundary->getExplicitOperator();
-
-        Teuchos::RCP<Thyra::LinearOpBase<ST>>
-        block = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(exp_jac);
-
-#else
-
-        Teuchos::RCP<Tpetra_Operator>
-        jac_boundary =
-            Teuchos::rcp(
-                new Schwarz_BoundaryJacobian(comm_, ca, jacs, i, j));
+        if (coupling == Teuchos::null) continue;
 
+        // The Schwarz BC scales its rows by the Jacobian coefficient,
+        // do the same for the coupling terms without touching the
+        // cached matrix.
         Teuchos::RCP<Thyra::LinearOpBase<ST>>
-        block = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(jac_boundary);
-
-#endif // EXPLICIT_OFF_DIAGONAL
+        block = Thyra::nonconstScale<ST>(
+            j_coeff,
+            Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(coupling));
 
         blocked_op->setNonconstBlock(i, j, block);
-#endif // USE_OFF_DIAGONAL
       }
     }
   }
@@ -31,10 +31,25 @@ public:
 
   ~Schwarz_CoupledJacobian();
 
+  /// Assemble the off-diagonal blocks that couple each application to
+  /// the ones given by its Schwarz BCs. These only depend on the meshes,
+  /// so callers are expected to build them once and reuse them.
+  Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>>
+  getCouplingBlocks(
+      Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> jacs,
+      Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca) const;
+
+  /// Block operator with the application Jacobians on the diagonal.
+  /// If coupling blocks are given, they are added scaled by j_coeff as
+  /// off-diagonal blocks, which yields the monolithic Schwarz Jacobian
+  /// that block preconditioners (e.g. Teko Gauss-Seidel) can exploit.
   Teuchos::RCP<Thyra::LinearOpBase<ST>>
   getThyraCoupledJacobian(
       Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> jacs,
-      Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca) const;
+      Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca,
+      Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> const & coupling_blocks =
+          Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>>(),
+      ST const j_coeff = 1.0) const;
 
 private:
 
@@ -9,12 +9,15 @@
 #include <fstream>
 #include <iomanip>
 #include <iterator>
+#include <limits>
 #include <sstream>
 #include <string>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/connected_components.hpp>
 
+#include <Kokkos_Core.hpp>
+
 #include "Albany_Utils.hpp"
 #include "LCMPartition.h"
 
@@ -96,54 +99,6 @@ void PrintPartitionInfo(
   return;
 }
 
-//
-// Given a vector of points and a set of indices to this vector:
-// 1) Find the bounding box of the indexed points.
-// 2) Compute the vector sum of the indexed points.
-//
-boost::tuple<
-  minitensor::Vector<double>,
-  minitensor::Vector<double>,
-  minitensor::Vector<double>>
-bounds_and_sum_subset(
-    std::vector<minitensor::Vector<double>> const & points,
-    std::set<minitensor::Index> const & indices)
-{
-  ALBANY_EXPECT(points.size() > 0);
-  ALBANY_EXPECT(indices.size() > 0);
-
-  minitensor::Index const
-  first = *indices.begin();
-
-  minitensor::Vector<double>
-  sum = points[first];
-
-  minitensor::Vector<double>
-  lower_corner = sum;
-
-  minitensor::Vector<double>
-  upper_corner = sum;
-
-  minitensor::Index const
-  N = sum.get_dimension();
-
-  for (auto index : indices) {
-
-    minitensor::Vector<double> const &
-    p = points[index];
-
-    sum += p;
-
-    for (minitensor::Index i = 0; i < N; ++i) {
-      lower_corner(i) = std::min(lower_corner(i), p(i));
-      upper_corner(i) = std::max(upper_corner(i), p(i));
-    }
-
-  }
-
-  return boost::make_tuple(lower_corner, upper_corner, sum);
-}
-
 //
 // Given point, a vector of centers and a set of indices into this vector:
 // Return the index of the center closest to the point among the
@@ -185,368 +140,413 @@ closest_subset(
   return index_minimum;
 }
 
+} // anonymous namespace
+
 //
-// Given a vector of points and a set of indices:
-// 1) Find the bounding box of the indexed points.
-// 2) Divide the bounding box along its largest dimension, using median.
-// 3) Assign points to one side or the other, and return index sets.
+// KD tree constructor with list of points.
 //
-std::pair<std::set<minitensor::Index>, std::set<minitensor::Index>>
-split_box(
+KDTree::KDTree(
     std::vector<minitensor::Vector<double>> const & points,
-    std::set<minitensor::Index> const & indices)
+    minitensor::Index const leaf_size)
 {
   ALBANY_EXPECT(points.size() > 0);
-  ALBANY_EXPECT(indices.size() > 0);
 
-  //
-  // Compute bounding box
-  //
-  minitensor::Index const
-  first = *indices.begin();
-
-  minitensor::Vector<double>
-  lower_corner = points[first];
-
-  minitensor::Vector<double>
-  upper_corner = lower_corner;
+  using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
 
   minitensor::Index const
-  N = lower_corner.get_dimension();
+  number_points = points.size();
 
-  for (auto index : indices) {
+  minitensor::Index const
+  N = points[0].get_dimension();
 
-    minitensor::Vector<double> const &
-    p = points[index];
+  dimension_ = N;
 
-    for (minitensor::Index i = 0; i < N; ++i) {
-      lower_corner(i) = std::min(lower_corner(i), p(i));
-      upper_corner(i) = std::max(upper_corner(i), p(i));
-    }
+  coordinates_.resize(number_points * N);
+  permutation_.resize(number_points);
 
-  }
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, number_points),
+      [&](int const i) {
+        for (minitensor::Index j = 0; j < N; ++j) {
+          coordinates_[i * N + j] = points[i](j);
+        }
+        permutation_[i] = i;
+      });
 
   //
-  // Find largest dimension
+  // The cells are split at the median position, so the topology
+  // depends only on the counts and is laid out level by level first.
   //
-  minitensor::Vector<double> const
-  span = upper_corner - lower_corner;
+  minitensor::Index const
+  maximum_leaf_size = std::max(leaf_size, minitensor::Index(1));
 
-  ALBANY_EXPECT(norm_square(span) > 0.0);
+  std::vector<minitensor::Index>
+  level_offsets;
 
-  double
-  maximum_span = span(0);
+  left_.push_back(-1);
+  begin_.push_back(0);
+  end_.push_back(number_points);
 
   minitensor::Index
-  largest_dimension = 0;
+  level_begin = 0;
 
-  for (minitensor::Index i = 1; i < N; ++i) {
+  while (level_begin < left_.size()) {
 
-    double const
-    s = span(i);
-
-    if (s > maximum_span) {
-      maximum_span = s;
-      largest_dimension = i;
-    }
+    level_offsets.push_back(level_begin);
 
-  }
+    minitensor::Index const
+    level_end = left_.size();
 
-  //
-  // Find median coordinate along largest dimension
-  //
-  std::vector<double>
-  coordinates;
+    for (minitensor::Index node = level_begin; node < level_end; ++node) {
 
-  for (auto index : indices) {
+      minitensor::Index const
+      begin = begin_[node];
 
-    minitensor::Vector<double> const &
-    p = points[index];
+      minitensor::Index const
+      end = end_[node];
 
-    coordinates.push_back(p(largest_dimension));
+      if (end - begin <= maximum_leaf_size) continue;
 
-  }
+      minitensor::Index const
+      middle = begin + (end - begin) / 2;
 
-  std::sort(coordinates.begin(), coordinates.end());
+      left_[node] = static_cast<int>(left_.size());
 
-  double
-  split_coordinate =
-      minitensor::median<double>(coordinates.begin(), coordinates.end());
+      left_.push_back(-1);
+      begin_.push_back(begin);
+      end_.push_back(middle);
 
-  //
-  // Check whether splitting the box will result in one box of
-  // the same volume as the original and another one of zero volume.
-  // If so, split the original box into two of equal volume.
-  //
-  bool const
-  box_unchanged =
-      split_coordinate == lower_corner(largest_dimension) ||
-          split_coordinate == upper_corner(largest_dimension);
+      left_.push_back(-1);
+      begin_.push_back(middle);
+      end_.push_back(end);
+    }
 
-  if (box_unchanged == true) {
+    level_begin = level_end;
+  }
 
-    std::sort(coordinates.begin(), coordinates.end());
+  level_offsets.push_back(left_.size());
 
-    split_coordinate =
-        0.5 * (coordinates[0] + coordinates[coordinates.size() - 1]);
+  minitensor::Index const
+  number_nodes = left_.size();
 
-  }
+  minitensor::Index const
+  number_levels = level_offsets.size() - 1;
 
   //
-  // Assign points to lower or upper half.
+  // Top down: split each cell at the median along its largest dimension.
+  // Cells of the same level own disjoint ranges of the permutation.
   //
-  std::set<minitensor::Index>
-  indices_lower;
+  std::vector<double>
+  cell_lower(number_nodes * N);
 
-  std::set<minitensor::Index>
-  indices_upper;
+  std::vector<double>
+  cell_upper(number_nodes * N);
 
-  minitensor::Vector<double>
-  split_limit = upper_corner;
+  for (minitensor::Index j = 0; j < N; ++j) {
+    cell_lower[j] = coordinates_[j];
+    cell_upper[j] = coordinates_[j];
+  }
 
-  split_limit(largest_dimension) = split_coordinate;
+  for (minitensor::Index i = 1; i < number_points; ++i) {
+    for (minitensor::Index j = 0; j < N; ++j) {
+      cell_lower[j] = std::min(cell_lower[j], coordinates_[i * N + j]);
+      cell_upper[j] = std::max(cell_upper[j], coordinates_[i * N + j]);
+    }
+  }
 
-  for (auto index : indices) {
+  for (minitensor::Index level = 0; level < number_levels; ++level) {
 
-    minitensor::Vector<double> const &
-    p = points[index];
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<ExecutionSpace>(
+            level_offsets[level], level_offsets[level + 1]),
+        [&](int const node) {
 
-    if (in_box(p, lower_corner, split_limit) == true) {
-      indices_lower.insert(index);
-    } else {
-      indices_upper.insert(index);
-    }
+          if (isLeaf(node) == true) return;
 
-  }
+          minitensor::Index
+          largest_dimension = 0;
 
-  return std::make_pair(indices_lower, indices_upper);
-}
+          for (minitensor::Index j = 1; j < N; ++j) {
+            double const
+            span = cell_upper[node * N + j] - cell_lower[node * N + j];
 
-} // anonymous namespace
+            double const
+            maximum_span =
+                cell_upper[node * N + largest_dimension] -
+                cell_lower[node * N + largest_dimension];
 
-//
-// Build KD tree of list of points.
-// \param point list
-// \return Boost shared pointer to root node of tree.
-//
-template<typename Node>
-std::shared_ptr<Node>
-buildKDTree(std::vector<minitensor::Vector<double>> const & points)
-{
+            if (span > maximum_span) largest_dimension = j;
+          }
 
-  //
-  // Initially all points are in the index set.
-  //
-  minitensor::Index const
-  number_points = points.size();
+          minitensor::Index const
+          middle = end_[getLeft(node)];
 
-  std::set<minitensor::Index>
-  points_indices;
+          std::nth_element(
+              permutation_.begin() + begin_[node],
+              permutation_.begin() + middle,
+              permutation_.begin() + end_[node],
+              [&](minitensor::Index const a, minitensor::Index const b) {
+                return coordinates_[a * N + largest_dimension] <
+                    coordinates_[b * N + largest_dimension];
+              });
 
-  for (minitensor::Index i = 0; i < number_points; ++i) {
-    points_indices.insert(i);
-  }
+          double const
+          split_coordinate =
+              coordinates_[permutation_[middle] * N + largest_dimension];
 
-  std::shared_ptr<Node>
-  dummy;
+          minitensor::Index const
+          left = getLeft(node);
 
-  std::string
-  name = "0";
+          minitensor::Index const
+          right = getRight(node);
 
-  std::shared_ptr<Node>
-  root = createKDTreeNode(name, dummy, points, points_indices);
+          for (minitensor::Index j = 0; j < N; ++j) {
+            cell_lower[left * N + j] = cell_lower[node * N + j];
+            cell_upper[left * N + j] = cell_upper[node * N + j];
+            cell_lower[right * N + j] = cell_lower[node * N + j];
+            cell_upper[right * N + j] = cell_upper[node * N + j];
+          }
 
-  return root;
-}
+          cell_upper[left * N + largest_dimension] = split_coordinate;
+          cell_lower[right * N + largest_dimension] = split_coordinate;
+        });
 
-//
-// Create KD tree node.
-// \param point list
-// \return Boost shared pointer to node of tree if created, 0 otherwise.
-//
-template<typename Node>
-std::shared_ptr<Node>
-createKDTreeNode(
-    std::string const & name,
-    std::shared_ptr<Node> parent,
-    std::vector<minitensor::Vector<double>> const & points,
-    std::set<minitensor::Index> const & points_indices)
-{
-  if (name.length() >= 64) {
-    std::cout << "Name is too long: " << name << '\n';
   }
 
   //
-  // Create and fill in node.
+  // Bottom up: tight bounding boxes and coordinate sums.
   //
-  std::shared_ptr<Node>
-  node(new Node);
+  lower_.resize(number_nodes * N);
+  upper_.resize(number_nodes * N);
+  sum_.resize(number_nodes * N);
 
-  node->name = name;
+  for (minitensor::Index level = number_levels; level-- > 0;) {
 
-  node->parent = parent;
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<ExecutionSpace>(
+            level_offsets[level], level_offsets[level + 1]),
+        [&](int const node) {
 
-  minitensor::Index const
-  count = points_indices.size();
+          double * const
+          lower = &lower_[node * N];
 
-  node->count = count;
-  node->cell_points = points_indices;
+          double * const
+          upper = &upper_[node * N];
 
-  switch (count) {
+          double * const
+          sum = &sum_[node * N];
 
-  // Empty node
-  case 0:
-    break;
+          if (isLeaf(node) == true) {
 
-    // Leaf node
-  case 1:
-    {
-      minitensor::Vector<double> const &
-      p = points[*points_indices.begin()];
-      node->lower_corner = p;
-      node->upper_corner = p;
-      node->weighted_centroid = p;
-    }
-    break;
+            double const * const
+            first = &coordinates_[permutation_[begin_[node]] * N];
 
-  default:
-    {
-      boost::tie(
-          node->lower_corner,
-          node->upper_corner,
-          node->weighted_centroid) =
-          bounds_and_sum_subset(points, points_indices);
+            for (minitensor::Index j = 0; j < N; ++j) {
+              lower[j] = first[j];
+              upper[j] = first[j];
+              sum[j] = 0.0;
+            }
 
-      std::set<minitensor::Index>
-      indices_left;
+            for (minitensor::Index k = begin_[node]; k < end_[node]; ++k) {
 
-      std::set<minitensor::Index>
-      indices_right;
+              double const * const
+              p = &coordinates_[permutation_[k] * N];
 
-      boost::tie(indices_left, indices_right) =
-          split_box(points, points_indices);
+              for (minitensor::Index j = 0; j < N; ++j) {
+                lower[j] = std::min(lower[j], p[j]);
+                upper[j] = std::max(upper[j], p[j]);
+                sum[j] += p[j];
+              }
+            }
 
-      std::string
-      name_left = name + "0";
+            return;
+          }
 
-      std::string
-      name_right = name + "1";
+          minitensor::Index const
+          left = getLeft(node);
 
-      node->left = createKDTreeNode(name_left, node, points, indices_left);
+          minitensor::Index const
+          right = getRight(node);
 
-      node->right = createKDTreeNode(name_right, node, points, indices_right);
-    }
-    break;
+          for (minitensor::Index j = 0; j < N; ++j) {
+            lower[j] = std::min(lower_[left * N + j], lower_[right * N + j]);
+            upper[j] = std::max(upper_[left * N + j], upper_[right * N + j]);
+            sum[j] = sum_[left * N + j] + sum_[right * N + j];
+          }
+        });
 
   }
 
-  return node;
+  return;
 }
 
 //
-// KdTree constructor with list of points.
+// Bounding box and coordinate sum of the points of a node
 //
-template<typename Node>
-KDTree<Node>::KDTree(
-    std::vector<minitensor::Vector<double>> const & points,
-    minitensor::Index const number_centers)
+minitensor::Vector<double>
+KDTree::getLowerCorner(minitensor::Index const node) const
 {
-  root_ = buildKDTree<Node>(points);
-
-  // Set candidate centers to all
-  std::set<minitensor::Index>
-  candidate_centers;
-
-  for (minitensor::Index i = 0; i < number_centers; ++i) {
-    candidate_centers.insert(i);
-  }
+  return minitensor::Vector<double>(dimension_, &lower_[node * dimension_]);
+}
 
-  root_->candidate_centers = candidate_centers;
+minitensor::Vector<double>
+KDTree::getUpperCorner(minitensor::Index const node) const
+{
+  return minitensor::Vector<double>(dimension_, &upper_[node * dimension_]);
+}
 
-  return;
+minitensor::Vector<double>
+KDTree::getWeightedCentroid(minitensor::Index const node) const
+{
+  return minitensor::Vector<double>(dimension_, &sum_[node * dimension_]);
 }
 
 //
-// Visit Tree nodes recursively and
-// perform the action defined by the Visitor object.
+// Index of the stored point closest to the given one
 //
-template<typename Node, typename Visitor>
-void
-visitTreeNode(Node & node, Visitor const & visitor)
+minitensor::Index
+KDTree::closest(minitensor::Vector<double> const & point) const
 {
-  if (visitor.pre_stop(node) == true) return;
+  ALBANY_EXPECT(point.get_dimension() == dimension_);
 
-  visitor(node);
+  minitensor::Index
+  index_closest = permutation_.size();
 
-  if (visitor.post_stop(node) == true) return;
+  double
+  minimum = std::numeric_limits<double>::max();
 
-  visitTreeNode(node->left, visitor);
-  visitTreeNode(node->right, visitor);
+  closestRecursive(0, point, index_closest, minimum);
 
-  return;
+  return index_closest;
 }
 
 //
-// Traverse a Tree and perform the action defined by the Visitor object.
+// Closest stored point for a batch of points
 //
-template<typename Tree, typename Visitor>
-void
-traverseTree(Tree & tree, Visitor const & visitor)
+std::vector<minitensor::Index>
+KDTree::closest(std::vector<minitensor::Vector<double>> const & points) const
 {
-  visitTreeNode(tree.get_root(), visitor);
-  return;
+  minitensor::Index const
+  number_points = points.size();
+
+  std::vector<minitensor::Index>
+  indices(number_points);
+
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, number_points),
+      [&](int const i) {
+        indices[i] = closest(points[i]);
+      });
+
+  return indices;
 }
 
 //
-// Output visitor for KDTree node.
+// Nearest neighbor search. Nodes whose box is farther than the
+// current minimum are pruned, the nearer child is visited first.
 //
-template<typename Node>
 void
-OutputVisitor<Node>::operator()(Node const & node) const
+KDTree::closestRecursive(
+    minitensor::Index const node,
+    minitensor::Vector<double> const & point,
+    minitensor::Index & index_closest,
+    double & minimum) const
 {
-  std::cout << "Node        : " << node->name << '\n';
-  std::cout << "Count       : " << node->count << '\n';
-  std::cout << "Lower corner: " << node->lower_corner << '\n';
-  std::cout << "Upper corner: " << node->upper_corner << '\n';
+  minitensor::Index const
+  N = dimension_;
 
-  minitensor::Vector<double>
-  centroid = node->weighted_centroid / node->count;
+  if (isLeaf(node) == true) {
+
+    for (minitensor::Index k = begin_[node]; k < end_[node]; ++k) {
 
-  std::cout << "Centroid    : " << centroid << '\n';
+      minitensor::Index const
+      index = permutation_[k];
+
+      double
+      s = 0.0;
+
+      for (minitensor::Index j = 0; j < N; ++j) {
+        double const
+        d = coordinates_[index * N + j] - point(j);
+
+        s += d * d;
+      }
+
+      if (s < minimum || (s == minimum && index < index_closest)) {
+        minimum = s;
+        index_closest = index;
+      }
+
+    }
+
+    return;
+  }
+
+  minitensor::Index
+  children[2] = {getLeft(node), getRight(node)};
+
+  double
+  box_distance[2] = {0.0, 0.0};
+
+  for (minitensor::Index c = 0; c < 2; ++c) {
+
+    minitensor::Index const
+    child = children[c];
+
+    for (minitensor::Index j = 0; j < N; ++j) {
+
+      double const
+      x = point(j);
+
+      double const
+      d = std::max(
+          std::max(lower_[child * N + j] - x, x - upper_[child * N + j]),
+          0.0);
+
+      box_distance[c] += d * d;
+    }
+
+  }
+
+  if (box_distance[1] < box_distance[0]) {
+    std::swap(children[0], children[1]);
+    std::swap(box_distance[0], box_distance[1]);
+  }
+
+  for (minitensor::Index c = 0; c < 2; ++c) {
+
+    // Ties may still hold a point with a lower index, do not prune them.
+    if (box_distance[c] > minimum) continue;
+
+    closestRecursive(children[c], point, index_closest, minimum);
+  }
 
   return;
 }
 
 //
-// Pre-visit stopping criterion for traversing the tree.
+// Print the nodes of the tree
 //
-template<typename Node>
-bool
-OutputVisitor<Node>::pre_stop(Node const & node) const
+void
+KDTree::print(std::ostream & os) const
 {
-  return node.get() == nullptr;
-}
+  for (minitensor::Index node = 0; node < getNumberNodes(); ++node) {
 
-//
-// Post-visit stopping criterion for traversing the tree.
-//
-template<typename Node>
-bool
-OutputVisitor<Node>::post_stop(Node const & node) const
-{
-  return false;
-}
+    minitensor::Index const
+    count = getCount(node);
 
-//
-// Constructor for filtering visitor
-//
-template<typename Node, typename Center>
-FilterVisitor<Node, Center>::FilterVisitor(
-    std::vector<minitensor::Vector<double>> & p,
-    std::vector<Center> & c) :
-    points(p),
-    centers(c)
-{
+    os << "Node        : " << node << '\n';
+    os << "Count       : " << count << '\n';
+    os << "Lower corner: " << getLowerCorner(node) << '\n';
+    os << "Upper corner: " << getUpperCorner(node) << '\n';
+
+    minitensor::Vector<double>
+    centroid = getWeightedCentroid(node) / count;
+
+    os << "Centroid    : " << centroid << '\n';
+  }
+
+  return;
 }
 
 namespace {
@@ -596,12 +596,12 @@ closest_center_from_subset(
 // where the closest center to the midcell lies as well.
 //
 template<typename Center>
-std::pair<minitensor::Index, std::set<minitensor::Index>>
+std::pair<minitensor::Index, std::vector<minitensor::Index>>
 box_proximity_to_centers(
     minitensor::Vector<double> const & lower_corner,
     minitensor::Vector<double> const & upper_corner,
     std::vector<Center> const & centers,
-    std::set<minitensor::Index> const & index_subset)
+    std::vector<minitensor::Index> const & index_subset)
 {
   ALBANY_EXPECT(centers.size() > 0);
   ALBANY_EXPECT(index_subset.size() > 0);
@@ -632,14 +632,14 @@ box_proximity_to_centers(
   minitensor::Vector<double> const &
   closest_to_midcell = centers[index_closest].position;
 
-  std::set<minitensor::Index>
+  std::vector<minitensor::Index>
   indices_candidates;
 
   // Determine where the box lies
   for (auto&& i : index_subset) {
 
     if (i == index_closest) {
-      indices_candidates.insert(i);
+      indices_candidates.push_back(i);
       continue;
     }
 
@@ -662,7 +662,7 @@ box_proximity_to_centers(
     }
 
     if (norm_square(p - v) < norm_square(closest_to_midcell - v)) {
-      indices_candidates.insert(i);
+      indices_candidates.push_back(i);
     }
 
   }
@@ -670,121 +670,101 @@ box_proximity_to_centers(
   return std::make_pair(index_closest, indices_candidates);
 }
 
-} // anonymous namespace
-
 //
-// Filtering visitor for KDTree node
+// Filter the candidate centers through a node of the tree
 //
-template<typename Node, typename Center>
 void
-FilterVisitor<Node, Center>::operator()(Node const & node) const
+filter_node(
+    KDTree const & tree,
+    minitensor::Index const node,
+    std::vector<minitensor::Vector<double>> const & points,
+    std::vector<ClusterCenter> & centers,
+    std::vector<minitensor::Index> const & candidate_centers)
 {
-  bool const
-  node_is_empty = node->count == 0;
-
-  if (node_is_empty == true) {
-    return;
-  }
-
-  bool const
-  node_is_leaf = node->count == 1;
-
-  if (node_is_leaf == true) {
-
-    // Get point
-    minitensor::Index const
-    point_index = *(node->cell_points.begin());
+  if (tree.getCount(node) == 0) return;
 
-    minitensor::Vector<double> const &
-    point = points[point_index];
-
-    // Find closest center to it
-    minitensor::Index
-    index_closest =
-        closest_center_from_subset(
-            point,
-            centers,
-            node->candidate_centers.begin(),
-            node->candidate_centers.end());
-
-    // Update closest center
-    Center &
-    closest_center = centers[index_closest];
-
-    closest_center.weighted_centroid += point;
-    ++closest_center.count;
+  if (tree.isLeaf(node) == true) {
 
-    node->closest_center_to_midcell = index_closest;
+    for (minitensor::Index k = tree.getBegin(node); k < tree.getEnd(node);
+        ++k) {
 
-  } else { // node_is_leaf == false
+      minitensor::Vector<double> const &
+      point = points[tree.getPointIndex(k)];
 
-    // Get midpoint of cell
-    minitensor::Index
-    index_closest_midcell = 0;
+      // Find closest center to it
+      minitensor::Index const
+      index_closest =
+          closest_center_from_subset(
+              point,
+              centers,
+              candidate_centers.begin(),
+              candidate_centers.end());
+
+      // Update closest center
+      ClusterCenter &
+      closest_center = centers[index_closest];
 
-    std::set<minitensor::Index>
-    candidate_indices;
+      closest_center.weighted_centroid += point;
+      ++closest_center.count;
+    }
 
-    boost::tie(index_closest_midcell, candidate_indices) =
-        box_proximity_to_centers(
-            node->lower_corner,
-            node->upper_corner,
-            centers,
-            node->candidate_centers);
+    return;
+  }
 
-    node->candidate_centers = candidate_indices;
+  minitensor::Index
+  index_closest_midcell = 0;
 
-    if (candidate_indices.size() == 1) {
+  std::vector<minitensor::Index>
+  candidate_indices;
 
-      Center &
-      center = centers[index_closest_midcell];
+  boost::tie(index_closest_midcell, candidate_indices) =
+      box_proximity_to_centers(
+          tree.getLowerCorner(node),
+          tree.getUpperCorner(node),
+          centers,
+          candidate_centers);
 
-      center.weighted_centroid += node->weighted_centroid;
-      center.count += node->count;
-    } else {
+  if (candidate_indices.size() == 1) {
 
-      // Update children
-      node->left->candidate_centers = candidate_indices;
-      node->right->candidate_centers = candidate_indices;
-    }
+    ClusterCenter &
+    center = centers[index_closest_midcell];
 
-    node->closest_center_to_midcell = index_closest_midcell;
+    center.weighted_centroid += tree.getWeightedCentroid(node);
+    center.count += tree.getCount(node);
 
+    return;
   }
 
+  filter_node(tree, tree.getLeft(node), points, centers, candidate_indices);
+  filter_node(tree, tree.getRight(node), points, centers, candidate_indices);
+
   return;
 }
 
-//
-// Pre-visit stopping criterion for traversing the tree.
-//
-template<typename Node, typename Center>
-bool
-FilterVisitor<Node, Center>::pre_stop(Node const & node) const
-{
-  bool const
-  has_no_centers = node->candidate_centers.size() == 0;
-
-  return has_no_centers == true;
-}
+} // anonymous namespace
 
 //
-// Post-visit stopping criterion for traversing the tree.
+// One iteration of the K-means filtering algorithm
 //
-template<typename Node, typename Center>
-bool
-FilterVisitor<Node, Center>::post_stop(Node const & node) const
+void
+filterCenters(
+    KDTree const & tree,
+    std::vector<minitensor::Vector<double>> const & points,
+    std::vector<ClusterCenter> & centers)
 {
-  bool const
-  node_is_leaf = node->count <= 1;
+  if (centers.size() == 0) return;
+
+  // Initially all centers are candidates.
+  std::vector<minitensor::Index>
+  candidate_centers(centers.size());
 
-  bool const
-  has_single_center = node->candidate_centers.size() == 1;
+  for (minitensor::Index i = 0; i < centers.size(); ++i) {
+    candidate_centers[i] = i;
+  }
 
-  bool const
-  stop_traversal = node_is_leaf || has_single_center;
+  filter_node(tree, 0, points, centers, candidate_centers);
 
-  return stop_traversal == true;
+  return;
 }
 
 //
@@ -2146,6 +2126,15 @@ ConnectivityArray::partitionByCenters(
 
   centroids_ofs << "X,Y,Z" << '\n';
 
+  std::vector<int>
+  elements;
+
+  std::vector<minitensor::Vector<double>>
+  element_centroids;
+
+  elements.reserve(connectivity_.size());
+  element_centroids.reserve(connectivity_.size());
+
   for (auto&& element_conn : connectivity_) {
 
     int const &
@@ -2173,8 +2162,25 @@ ConnectivityArray::partitionByCenters(
 
     centroids_ofs << element_centroid << '\n';
 
+    elements.push_back(element);
+    element_centroids.push_back(element_centroid);
+
+  }
+
+  // Find the closest centers for all elements at once.
+  KDTree
+  center_tree(centers);
+
+  std::vector<minitensor::Index> const
+  element_partitions = center_tree.closest(element_centroids);
+
+  for (minitensor::Index i = 0; i < elements.size(); ++i) {
+
+    int const
+    element = elements[i];
+
     minitensor::Index const
-    partition = closest_point(element_centroid, centers);
+    partition = element_partitions[i];
 
     partitions[element] = partition;
 
@@ -2518,18 +2524,14 @@ ConnectivityArray::partitionKMeans(double const length_scale)
     steps[i] = diagonal_distance;
   }
 
-  minitensor::Index const
-  number_points = domain_points_.size();
-
   while (step_norm >= tolerance && number_iterations < max_iterations) {
 
     // Assign points to closest generators
-    std::vector<minitensor::Index>
-    point_to_generator(number_points);
+    KDTree
+    generator_tree(centers);
 
-    for (minitensor::Index i = 0; i < domain_points_.size(); ++i) {
-      point_to_generator[i] = closest_point(domain_points_[i], centers);
-    }
+    std::vector<minitensor::Index> const
+    point_to_generator = generator_tree.closest(domain_points_);
 
     // Determine cluster of points for each generator
     std::vector<std::vector<minitensor::Vector<double>>>
@@ -2641,13 +2643,11 @@ ConnectivityArray::partitionKDTree(double const length_scale)
   createGrid();
 
   //
-  // Create KDTree
+  // Create KDTree. Leaves hold several points to keep the tree small
+  // for large meshes, the filtering result does not depend on it.
   //
-  KDTree<KDTreeNode>
-  kdtree(domain_points_, number_partitions);
-
-  FilterVisitor<std::shared_ptr<KDTreeNode>, ClusterCenter>
-  filter_visitor(domain_points_, centers);
+  KDTree
+  kdtree(domain_points_, 16);
 
   //
   // K-means iteration
@@ -2685,7 +2685,7 @@ ConnectivityArray::partitionKDTree(double const length_scale)
       center.count = 0;
     }
 
-    traverseTree(kdtree, filter_visitor);
+    filterCenters(kdtree, domain_points_, centers);
 
     // Update centers
     for (minitensor::Index i = 0; i < centers.size(); ++i) {
@@ -73,7 +73,6 @@ enum class Scheme {
 class ConnectivityArray;
 class DualGraph;
 class ZoltanHyperGraph;
-struct KDTreeNode;
 
 ///
 /// Cluster center for K-means filtering algorithm. See
@@ -94,154 +93,174 @@ struct ClusterCenter {
 };
 
 ///
-/// Binary tree node for K-means filtering algorithm. See
+/// Binary tree for K-means filtering algorithm. See
 /// An Efficient K-means Clustering Algorithm: Analysis and Implementation
 /// T. Kanungo et al.
 /// IEEE Transactions on Pattern Analysis and Machine Intelligence
 /// 24(7) July 2002
 ///
-struct KDTreeNode {
-  std::string
-  name;
-
-  std::shared_ptr<KDTreeNode>
-  parent;
-
-  // Children
-  std::shared_ptr<KDTreeNode>
-  left;
+/// The tree is stored in flat arrays. Nodes are numbered level by level
+/// starting at the root, and each node owns a contiguous range of a
+/// permutation of the points. Cells are split at the median along their
+/// largest dimension, so the shape of the tree depends only on the number
+/// of points and the levels are built concurrently.
+///
+class KDTree {
+public:
 
-  std::shared_ptr<KDTreeNode>
-  right;
+  ///
+  /// Build the tree for a list of points
+  /// \param points Points to store in the tree
+  /// \param leaf_size Maximum number of points in a leaf
+  ///
+  KDTree(
+      std::vector<minitensor::Vector<double>> const & points,
+      minitensor::Index const leaf_size = 1);
 
-  // Bounding box of cell
-  minitensor::Vector<double>
-  lower_corner;
+  minitensor::Index
+  getNumberNodes() const
+  {
+    return left_.size();
+  }
 
-  minitensor::Vector<double>
-  upper_corner;
+  minitensor::Index
+  getDimension() const
+  {
+    return dimension_;
+  }
 
-  // Weighted centroid and count
-  minitensor::Vector<double>
-  weighted_centroid;
+  bool
+  isLeaf(minitensor::Index const node) const
+  {
+    return left_[node] < 0;
+  }
 
   minitensor::Index
-  count;
-
-  std::set<minitensor::Index>
-  cell_points;
+  getLeft(minitensor::Index const node) const
+  {
+    return left_[node];
+  }
 
-  std::set<minitensor::Index>
-  candidate_centers;
+  minitensor::Index
+  getRight(minitensor::Index const node) const
+  {
+    return left_[node] + 1;
+  }
 
   minitensor::Index
-  closest_center_to_midcell;
-};
+  getCount(minitensor::Index const node) const
+  {
+    return end_[node] - begin_[node];
+  }
 
-///
-/// Binary tree for K-means filtering algorithm. See
-/// An Efficient K-means Clustering Algorithm: Analysis and Implementation
-/// T. Kanungo et al.
-/// IEEE Transactions on Pattern Analysis and Machine Intelligence
-/// 24(7) July 2002
-///
-template<typename Node>
-class KDTree {
-public:
+  ///
+  /// Range of positions in the permutation owned by a node
+  ///
+  minitensor::Index
+  getBegin(minitensor::Index const node) const
+  {
+    return begin_[node];
+  }
 
-  KDTree(
-      std::vector<minitensor::Vector<double>> const & points,
-      minitensor::Index const number_centers);
+  minitensor::Index
+  getEnd(minitensor::Index const node) const
+  {
+    return end_[node];
+  }
 
-  std::shared_ptr<Node> &
-  get_root()
+  ///
+  /// Index into the original point list of the point stored at
+  /// a position of the permutation
+  ///
+  minitensor::Index
+  getPointIndex(minitensor::Index const position) const
   {
-    return root_;
+    return permutation_[position];
   }
 
-private:
+  ///
+  /// Tight bounding box and coordinate sum of the points of a node
+  ///
+  minitensor::Vector<double>
+  getLowerCorner(minitensor::Index const node) const;
 
-  std::shared_ptr<Node>
-  root_;
-};
+  minitensor::Vector<double>
+  getUpperCorner(minitensor::Index const node) const;
 
-///
-/// Build KD tree of list of points.
-/// \param point list
-/// \return Boost shared pointer to root node of tree.
-///
-template<typename Node>
-std::shared_ptr<Node>
-buildKDTree(std::vector<minitensor::Vector<double>> const & points);
+  minitensor::Vector<double>
+  getWeightedCentroid(minitensor::Index const node) const;
 
-///
-/// Create KD tree node.
-/// \param point list
-/// \return Boost shared pointer to node of tree if created, 0 otherwise.
-///
-template<typename Node>
-std::shared_ptr<Node>
-createKDTreeNode(
-    std::string const & name,
-    std::shared_ptr<Node> parent,
-    std::vector<minitensor::Vector<double>> const & points,
-    std::set<minitensor::Index> const & points_indices);
+  ///
+  /// \return Index of the stored point closest to the given one.
+  /// Ties are resolved in favor of the lowest index, as closest_point().
+  ///
+  minitensor::Index
+  closest(minitensor::Vector<double> const & point) const;
 
-///
-/// Visit Tree nodes recursively and
-/// perform the action defined by the Visitor object.
-///
-template<typename Node, typename Visitor>
-void
-visitTreeNode(Node & node, Visitor const & visitor);
+  ///
+  /// Closest stored point for each of a batch of points.
+  /// The queries are independent and are run in parallel.
+  ///
+  std::vector<minitensor::Index>
+  closest(std::vector<minitensor::Vector<double>> const & points) const;
 
-///
-/// Traverse a Tree and perform the action defined by the Visitor object.
-///
-template<typename Tree, typename Visitor>
-void
-traverseTree(Tree & tree, Visitor const & visitor);
+  ///
+  /// Print the nodes of the tree
+  ///
+  void
+  print(std::ostream & os) const;
+
+private:
 
-///
-/// Output visitor for KDTree node.
-///
-template<typename Node>
-struct OutputVisitor {
   void
-  operator()(Node const & node) const;
+  closestRecursive(
+      minitensor::Index const node,
+      minitensor::Vector<double> const & point,
+      minitensor::Index & index_closest,
+      double & minimum) const;
 
-  bool
-  pre_stop(Node const & node) const;
+  minitensor::Index
+  dimension_{0};
 
-  bool
-  post_stop(Node const & node) const;
-};
+  // Point coordinates, dimension_ per point
+  std::vector<double>
+  coordinates_;
 
-///
-/// Filtering visitor for K-means algorithm.
-///
-template<typename Node, typename Center>
-struct FilterVisitor {
-  FilterVisitor(
-      std::vector<minitensor::Vector<double>> & p,
-      std::vector<Center> & c);
+  std::vector<minitensor::Index>
+  permutation_;
 
-  void
-  operator()(Node const & node) const;
+  // Left child, -1 for leaves. The right child is left + 1.
+  std::vector<int>
+  left_;
 
-  bool
-  pre_stop(Node const & node) const;
+  std::vector<minitensor::Index>
+  begin_;
 
-  bool
-  post_stop(Node const & node) const;
+  std::vector<minitensor::Index>
+  end_;
 
-  std::vector<minitensor::Vector<double>> &
-  points;
+  // Bounding boxes and coordinate sums, dimension_ per node
+  std::vector<double>
+  lower_;
 
-  std::vector<Center> &
-  centers;
+  std::vector<double>
+  upper_;
+
+  std::vector<double>
+  sum_;
 };
 
+///
+/// One iteration of the K-means filtering algorithm. Assigns the
+/// points in the tree to the closest centers and accumulates
+/// their weighted centroids and counts.
+///
+void
+filterCenters(
+    KDTree const & tree,
+    std::vector<minitensor::Vector<double>> const & points,
+    std::vector<ClusterCenter> & centers);
+
 ///
 /// Simple connectivity array.
 /// Holds coordinate array as well.
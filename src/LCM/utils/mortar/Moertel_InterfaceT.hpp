@@ -14,6 +14,7 @@
 
 #include "Teuchos_ParameterList.hpp"
 #include "Teuchos_Comm.hpp"
+#include "Teuchos_Time.hpp"
 
 #include "Tpetra_CrsMatrix.hpp"
 
@@ -21,6 +22,7 @@
 #include "Moertel_SegmentT.hpp"
 #include "Moertel_NodeT.hpp"
 #include "Moertel_ProjectorT.hpp"
+#include "Moertel_SegmentBVH.hpp"
 
 /*!
 \brief MoertelT: namespace of the Moertel package
@@ -765,6 +767,16 @@ public:
   
   */
   bool SetFunctionsFromFunctionTypes();
+
+  /*!
+  \brief Set the timers accumulating the time spent in the segment search
+
+  \param search : timer for the bounding volume broad phase
+  \param overlap : timer for the overlap computation and integration of the candidate pairs
+  */
+  void SetSearchTimers(const Teuchos::RCP<Teuchos::Time>& search,
+                       const Teuchos::RCP<Teuchos::Time>& overlap)
+  { searchTime_ = search; overlapTime_ = overlap; }
   
   //@}
 
@@ -835,6 +847,19 @@ private:
   bool QuickOverlapTest_2D(MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)& sseg, 
        MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)& mseg);
 
+  // Axis aligned box around a segment, padded so that any segment pair that
+  // can pass the quick overlap tests has overlapping boxes
+  static void SegmentSearchBox(MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)& seg,
+       double* box);
+
+  // Broad phase of the integration: collect the slave segments with a node
+  // owned by this proc and, for each of them, the indices into msegs of the
+  // master segments that may overlap it
+  void FindCandidateSegments(
+       std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >& ssegs,
+       std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >& msegs,
+       std::vector<std::vector<int> >& candidates);
+
 
 
 
@@ -861,6 +886,10 @@ private:
   
   MoertelT::MOERTEL_TEMPLATE_CLASS(FunctionT)::FunctionType         primal_;    // the type of functions to be set as trace space function
   MoertelT::MOERTEL_TEMPLATE_CLASS(FunctionT)::FunctionType         dual_;      // the type of functions to be set as LM space function
+
+  MoertelT::SegmentBVH                 mbvh_;         // hierarchy over the master segments, refitted each integration
+  Teuchos::RCP<Teuchos::Time>          searchTime_;   // time spent in the broad phase
+  Teuchos::RCP<Teuchos::Time>          overlapTime_;  // time spent integrating candidate pairs
   
 };
 
@@ -15,6 +15,8 @@
 #include "Moertel_ProjectorT.hpp"
 #include "Moertel_OverlapT.hpp"
 
+#include "Teuchos_TimeMonitor.hpp"
+
 const double CONSTRAINT_MATRIX_ZERO = 1.0e-11;
 
 /*----------------------------------------------------------------------*
@@ -137,56 +139,31 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_3D() {
   int sside = OtherSide(mside);
 
 
-  // loop over all segments of slave side
-  std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >::iterator scurr;
-
-  for(scurr = rseg_[sside].begin(); scurr != rseg_[sside].end(); ++scurr) {
-    // the segment to be integrated
-    Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > actsseg = scurr->second;
-
-#if 0
-    std::cout << "\n\nActive sseg id " << actsseg->Id() << "\n";
-#endif
-
-    // check whether I own at least one of the nodes on this slave segment
-    const int nnode = actsseg->Nnode();
-    MoertelT::MOERTEL_TEMPLATE_CLASS(NodeT)** nodes = actsseg->Nodes();
-    bool foundone = false;
+  // find the master segments that may overlap each of my slave segments
+  std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > > ssegs;
+  std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > > msegs;
+  std::vector<std::vector<int> > candidates;
 
-    for (int i=0; i<nnode; ++i)
-      if(NodePID(nodes[i]->Id()) == lcomm_->getRank()) {
-        foundone = true;
-        break;
-      }
+  FindCandidateSegments(ssegs, msegs, candidates);
 
-    // if none of the nodes belongs to me, do nothing on this segment
-    if (!foundone) continue;
+  Teuchos::TimeMonitor overlapmonitor(*overlapTime_);
 
-    // time this process
-    //Teuchos::Time time(*lComm());
-    //time.ResetStartTime();
-
-    // loop over all segments on the master side
-    std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >::iterator mcurr;
-
-
-    for(mcurr = rseg_[mside].begin(); mcurr != rseg_[mside].end(); ++mcurr) {
-      Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > actmseg = mcurr->second;
-#if 0
-      std::cout << "Active mseg id " << actmseg->Id() << std::endl;
-#endif
+  // loop over all my segments of slave side
+  for(int s = 0; s < (int)ssegs.size(); ++s) {
+    // the segment to be integrated
+    Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > actsseg = ssegs[s];
 
+    // loop over the candidate segments on the master side
+    for(int m = 0; m < (int)candidates[s].size(); ++m) {
+      Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > actmseg = msegs[candidates[s][m]];
 
       // if there is an overlap, integrate the pair
       // (whether there is an overlap or not will be checked inside)
       Integrate_3D_Section(*actsseg,*actmseg);
 
-    } // for (mcurr=rseg_[mside].begin(); mcurr!=rseg_[mside].end(); ++mcurr)
-
-
-    //std::cout << "time for this slave segment: " << time.ElapsedTime() << std::endl;
+    } // for (int m=0; m<candidates[s].size(); ++m)
 
-  } // for (scurr=rseg_[sside].begin(); scurr!=rseg_[sside].end(); ++scurr)
+  } // for (int s=0; s<ssegs.size(); ++s)
 
   return true;
 }
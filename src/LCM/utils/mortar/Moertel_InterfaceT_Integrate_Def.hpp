@@ -17,6 +17,7 @@
 
 #include "Teuchos_SerialDenseMatrix.hpp"
 #include "Teuchos_Time.hpp"
+#include "Teuchos_TimeMonitor.hpp"
 
 /*----------------------------------------------------------------------*
   |  assemble values from integration                                    |
@@ -284,39 +285,26 @@ MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_2D()
   int sside = OtherSide(mside);
 
 
-  // loop over all segments of slave side
-  std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >::iterator scurr;
-  for (scurr=rseg_[sside].begin(); scurr!=rseg_[sside].end(); ++scurr)
-  {
-    // the segment to be integrated
-    Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > actsseg = scurr->second;
+  // find the master segments that may overlap each of my slave segments
+  std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > > ssegs;
+  std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > > msegs;
+  std::vector<std::vector<int> > candidates;
 
-#if 0
-    std::cout << "\nActive sseg id " << actsseg->Id() << "\n\n";
-#endif
+  FindCandidateSegments(ssegs, msegs, candidates);
 
-    // check whether I own at least one of the nodes on this slave segment
-    int nnode = actsseg->Nnode();
-    MoertelT::MOERTEL_TEMPLATE_CLASS(NodeT)** nodes = actsseg->Nodes();
-    bool foundone = false;
-    for (int i=0; i<nnode; ++i)
-      if (NodePID(nodes[i]->Id()) == lcomm_->getRank())
-      {
-        foundone = true;
-        break;
-      }
-    // if none of the nodes belongs to me, do nothing on this segment
-    if (!foundone) continue;
+  Teuchos::TimeMonitor overlapmonitor(*overlapTime_);
 
-    // loop over all segments on the master side
-    std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >::iterator mcurr;
-    for (mcurr=rseg_[mside].begin(); mcurr!=rseg_[mside].end(); ++mcurr)
+  // loop over all my segments of slave side
+  for (int s=0; s<(int)ssegs.size(); ++s)
+  {
+    // the segment to be integrated
+    Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > actsseg = ssegs[s];
+
+    // loop over the candidate segments on the master side
+    for (int m=0; m<(int)candidates[s].size(); ++m)
     {
-      Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > actmseg = mcurr->second;
+      Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > actmseg = msegs[candidates[s][m]];
 
-#if 0
-      std::cout << "Active mseg id " << actmseg->Id() << std::endl;
-#endif
       // if there is an overlap, integrate the pair
       // (whether there is an overlap or not will be checked inside)
       try {
@@ -326,8 +314,8 @@ MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_2D()
         // overlap case found" error. Don't treat this as fatal.
       }
 
-    } // for (mcurr=rseg_[mside].begin(); mcurr!=rseg_[mside].end(); ++mcurr)
-  } // for (scurr=rseg_[sside].begin(); scurr!=rseg_[sside].end(); ++scurr)
+    } // for (int m=0; m<candidates[s].size(); ++m)
+  } // for (int s=0; s<ssegs.size(); ++s)
 
   return true;
 }
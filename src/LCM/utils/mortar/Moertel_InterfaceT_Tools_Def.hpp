@@ -9,6 +9,13 @@
 #include "Moertel_UtilsT.hpp"
 #include "Moertel_PnodeT.hpp"
 #include "Moertel_Segment_bilineartri.H"
+#include "Moertel_Tolerances.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "Kokkos_Core.hpp"
+#include "Teuchos_TimeMonitor.hpp"
 
 
 /*----------------------------------------------------------------------*
@@ -27,7 +34,9 @@ lcomm_(Teuchos::null),
 mortarside_(-1),
 ptype_(MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::proj_continousnormalfield),
 primal_(MoertelT::MOERTEL_TEMPLATE_CLASS(FunctionT)::func_none),
-dual_(MoertelT::MOERTEL_TEMPLATE_CLASS(FunctionT)::func_none)
+dual_(MoertelT::MOERTEL_TEMPLATE_CLASS(FunctionT)::func_none),
+searchTime_(Teuchos::rcp(new Teuchos::Time("Moertel: Segment Search"))),
+overlapTime_(Teuchos::rcp(new Teuchos::Time("Moertel: Segment Overlap")))
 {
   return;
 }
@@ -46,7 +55,9 @@ gcomm_(old.gcomm_),
 mortarside_(old.mortarside_),
 ptype_(old.ptype_),
 primal_(old.primal_),
-dual_(old.dual_)
+dual_(old.dual_),
+searchTime_(old.searchTime_),
+overlapTime_(old.overlapTime_)
 {
   // copy the nodes and segments
   for (int i=0; i<2; ++i)
@@ -89,6 +100,106 @@ dual_(old.dual_)
   BuildNodeSegmentTopology(); 
 }
 
+/*----------------------------------------------------------------------*
+ |  search box of a segment (private)                                   |
+ *----------------------------------------------------------------------*/
+MOERTEL_TEMPLATE_STATEMENT
+void MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::SegmentSearchBox(
+       MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)& seg, double* box)
+{
+  MoertelT::MOERTEL_TEMPLATE_CLASS(NodeT)** nodes = seg.Nodes();
+  const int nnode = seg.Nnode();
+
+  for (int k=0; k<3; ++k)
+  {
+    box[k]   =  std::numeric_limits<double>::max();
+    box[k+3] = -std::numeric_limits<double>::max();
+  }
+  for (int i=0; i<nnode; ++i)
+  {
+    const auto x = nodes[i]->XCoords();
+    for (int k=0; k<3; ++k)
+    {
+      const double xk = k < (int)x.size() ? x[k] : 0.0;
+      box[k]   = std::min(box[k], xk);
+      box[k+3] = std::max(box[k+3], xk);
+    }
+  }
+
+  // Both quick overlap tests accept a pair if the distance between a point
+  // of each segment is below Rough_Search_Radius * (sdiam + mdiam), with
+  // the diameters bounded by the box diagonals. Padding each box by its own
+  // share of that distance keeps every such pair.
+  double diag[3];
+  for (int k=0; k<3; ++k) diag[k] = box[k+3] - box[k];
+  const double pad = MoertelT::Rough_Search_Radius * MoertelT::length(diag,3);
+  for (int k=0; k<3; ++k)
+  {
+    box[k]   -= pad;
+    box[k+3] += pad;
+  }
+  return;
+}
+
+/*----------------------------------------------------------------------*
+ |  broad phase of the segment search (private)                         |
+ *----------------------------------------------------------------------*/
+MOERTEL_TEMPLATE_STATEMENT
+void MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::FindCandidateSegments(
+       std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >& ssegs,
+       std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >& msegs,
+       std::vector<std::vector<int> >& candidates)
+{
+  Teuchos::TimeMonitor searchmonitor(*searchTime_);
+
+  const int mside = MortarSide();
+  const int sside = OtherSide(mside);
+
+  // master segments in the order of rseg_ so that candidate pairs are
+  // integrated in the same order as by an exhaustive search
+  msegs.clear();
+  std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >::iterator curr;
+  for (curr=rseg_[mside].begin(); curr!=rseg_[mside].end(); ++curr)
+    msegs.push_back(curr->second);
+
+  // slave segments with at least one node on this proc
+  ssegs.clear();
+  for (curr=rseg_[sside].begin(); curr!=rseg_[sside].end(); ++curr)
+  {
+    const int nnode = curr->second->Nnode();
+    MoertelT::MOERTEL_TEMPLATE_CLASS(NodeT)** nodes = curr->second->Nodes();
+    for (int i=0; i<nnode; ++i)
+      if (NodePID(nodes[i]->Id()) == lcomm_->getRank())
+      {
+        ssegs.push_back(curr->second);
+        break;
+      }
+  }
+
+  // The segment topology does not change between integrations, only the
+  // node coordinates do, so the hierarchy is refitted and only rebuilt by
+  // Refit() if the number of master segments changed.
+  const int nmseg = msegs.size();
+  std::vector<double> mboxes(6 * nmseg);
+  for (int i=0; i<nmseg; ++i)
+    SegmentSearchBox(*msegs[i], &mboxes[6*i]);
+  mbvh_.Refit(mboxes);
+
+  // the queries are independent, run them in parallel
+  const int nsseg = ssegs.size();
+  candidates.assign(nsseg, std::vector<int>());
+  const MoertelT::SegmentBVH& mbvh = mbvh_;
+  Kokkos::parallel_for(
+    Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, nsseg),
+    [&](const int s) {
+      double box[6];
+      SegmentSearchBox(*ssegs[s], box);
+      mbvh.Query(box, candidates[s]);
+      std::sort(candidates[s].begin(), candidates[s].end());
+    });
+  return;
+}
+
 /*----------------------------------------------------------------------*
  |  dtor (public)                                            mwgee 06/05|
  *----------------------------------------------------------------------*/
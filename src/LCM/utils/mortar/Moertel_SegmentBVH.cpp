@@ -0,0 +1,205 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Moertel_SegmentBVH.hpp"
+
+#include <algorithm>
+#include <limits>
+
+/*----------------------------------------------------------------------*
+ |  ctor (public)                                                       |
+ *----------------------------------------------------------------------*/
+MoertelT::SegmentBVH::SegmentBVH(int leafsize) :
+leafsize_(std::max(leafsize, 1))
+{
+  return;
+}
+
+/*----------------------------------------------------------------------*
+ |  build tree (public)                                                 |
+ *----------------------------------------------------------------------*/
+void MoertelT::SegmentBVH::Build(const std::vector<double>& boxes)
+{
+  const int nitem = static_cast<int>(boxes.size() / 6);
+
+  boxes_ = boxes;
+  nodes_.clear();
+  perm_.resize(nitem);
+  for (int i=0; i<nitem; ++i) perm_[i] = i;
+
+  if (nitem == 0) return;
+
+  // a binary tree with leaves of at least one item has < 2*nitem nodes
+  nodes_.reserve(2 * nitem);
+  BuildRecursive(0, nitem);
+  return;
+}
+
+/*----------------------------------------------------------------------*
+ |  top down build, median split along the largest centroid extent      |
+ *----------------------------------------------------------------------*/
+int MoertelT::SegmentBVH::BuildRecursive(int begin, int end)
+{
+  const std::vector<double>& boxes = boxes_;
+
+  const int index = static_cast<int>(nodes_.size());
+  nodes_.push_back(Node());
+  nodes_[index].right = -1;
+  nodes_[index].begin = begin;
+  nodes_[index].end   = end;
+
+  if (end - begin <= leafsize_)
+  {
+    SetLeafBox(nodes_[index]);
+    return index;
+  }
+
+  // bounds of the box centroids
+  double lo[3], hi[3];
+  for (int k=0; k<3; ++k)
+  {
+    lo[k] =  std::numeric_limits<double>::max();
+    hi[k] = -std::numeric_limits<double>::max();
+  }
+  for (int i=begin; i<end; ++i)
+  {
+    const double* b = &boxes[6 * perm_[i]];
+    for (int k=0; k<3; ++k)
+    {
+      const double c = 0.5 * (b[k] + b[k+3]);
+      lo[k] = std::min(lo[k], c);
+      hi[k] = std::max(hi[k], c);
+    }
+  }
+
+  int axis = 0;
+  for (int k=1; k<3; ++k)
+    if (hi[k] - lo[k] > hi[axis] - lo[axis]) axis = k;
+
+  const int mid = begin + (end - begin) / 2;
+  std::nth_element(perm_.begin() + begin, perm_.begin() + mid,
+      perm_.begin() + end,
+      [&boxes, axis](int a, int b) {
+        return boxes[6*a + axis] + boxes[6*a + axis + 3] <
+               boxes[6*b + axis] + boxes[6*b + axis + 3];
+      });
+
+  // left child is always index + 1
+  const int left  = BuildRecursive(begin, mid);
+  const int right = BuildRecursive(mid, end);
+
+  // nodes_ may have been reallocated, do not hold references across calls
+  Node& node = nodes_[index];
+  node.right = right;
+  for (int k=0; k<3; ++k)
+  {
+    node.box[k]   = std::min(nodes_[left].box[k],   nodes_[right].box[k]);
+    node.box[k+3] = std::max(nodes_[left].box[k+3], nodes_[right].box[k+3]);
+  }
+  return index;
+}
+
+/*----------------------------------------------------------------------*
+ |  union of the boxes of the items in a leaf                           |
+ *----------------------------------------------------------------------*/
+void MoertelT::SegmentBVH::SetLeafBox(Node& node) const
+{
+  for (int k=0; k<3; ++k)
+  {
+    node.box[k]   =  std::numeric_limits<double>::max();
+    node.box[k+3] = -std::numeric_limits<double>::max();
+  }
+  for (int i=node.begin; i<node.end; ++i)
+  {
+    const double* b = &boxes_[6 * perm_[i]];
+    for (int k=0; k<3; ++k)
+    {
+      node.box[k]   = std::min(node.box[k],   b[k]);
+      node.box[k+3] = std::max(node.box[k+3], b[k+3]);
+    }
+  }
+  return;
+}
+
+/*----------------------------------------------------------------------*
+ |  refit boxes bottom up (public)                                      |
+ *----------------------------------------------------------------------*/
+void MoertelT::SegmentBVH::Refit(const std::vector<double>& boxes)
+{
+  if (static_cast<int>(boxes.size() / 6) != Nitem())
+  {
+    Build(boxes);
+    return;
+  }
+
+  boxes_ = boxes;
+
+  // children are stored after their parent, so a reverse sweep visits
+  // both children of a node before the node itself
+  for (int n=static_cast<int>(nodes_.size())-1; n>=0; --n)
+  {
+    Node& node = nodes_[n];
+    if (node.right < 0)
+    {
+      SetLeafBox(node);
+      continue;
+    }
+    const Node& left  = nodes_[n+1];
+    const Node& right = nodes_[node.right];
+    for (int k=0; k<3; ++k)
+    {
+      node.box[k]   = std::min(left.box[k],   right.box[k]);
+      node.box[k+3] = std::max(left.box[k+3], right.box[k+3]);
+    }
+  }
+  return;
+}
+
+/*----------------------------------------------------------------------*
+ |  box overlap test                                                    |
+ *----------------------------------------------------------------------*/
+bool MoertelT::SegmentBVH::Overlap(const double* a, const double* b)
+{
+  for (int k=0; k<3; ++k)
+    if (a[k] > b[k+3] || b[k] > a[k+3]) return false;
+  return true;
+}
+
+/*----------------------------------------------------------------------*
+ |  find items overlapping a box (public)                               |
+ *----------------------------------------------------------------------*/
+void MoertelT::SegmentBVH::Query(const double* box,
+                                 std::vector<int>& hits) const
+{
+  if (nodes_.empty()) return;
+
+  // the depth of the tree is O(log n), a small stack suffices
+  int stack[64];
+  int top = 0;
+  stack[top++] = 0;
+
+  while (top > 0)
+  {
+    const Node& node = nodes_[stack[--top]];
+    if (!Overlap(box, node.box)) continue;
+
+    if (node.right < 0)
+    {
+      for (int i=node.begin; i<node.end; ++i)
+      {
+        const int item = perm_[i];
+        if (Overlap(box, &boxes_[6 * item]))
+          hits.push_back(item);
+      }
+      continue;
+    }
+
+    const int index = static_cast<int>(&node - &nodes_[0]);
+    stack[top++] = node.right;
+    stack[top++] = index + 1;
+  }
+  return;
+}
@@ -0,0 +1,76 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef MOERTEL_SEGMENTBVH_HPP
+#define MOERTEL_SEGMENTBVH_HPP
+
+#include <vector>
+
+namespace MoertelT
+{
+
+/*!
+\class SegmentBVH
+
+\brief <b> A bounding volume hierarchy over interface segments</b>
+
+Used as the broad phase of the mortar segment search. The hierarchy is
+stored in flat arrays, nodes in depth first order so that every child
+comes after its parent. Boxes are given as 6 doubles per item
+(xmin, ymin, zmin, xmax, ymax, zmax).
+
+When the segments move, \ref Refit() recomputes the node boxes bottom up
+without changing the tree topology, which is much cheaper than
+\ref Build(). The tree only needs to be rebuilt if the number of items
+changes or if the motion degrades the search too much.
+
+*/
+class SegmentBVH
+{
+public:
+
+  explicit SegmentBVH(int leafsize = 4);
+
+  //! Build the tree topology and boxes for the given item boxes
+  void Build(const std::vector<double>& boxes);
+
+  //! Recompute the node boxes for moved items, keeping the topology
+  void Refit(const std::vector<double>& boxes);
+
+  //! Append to hits the indices of all items whose box overlaps box
+  void Query(const double* box, std::vector<int>& hits) const;
+
+  //! Number of items in the tree
+  int Nitem() const { return static_cast<int>(perm_.size()); }
+
+  //! True if \ref Build() has been called
+  bool IsBuilt() const { return !nodes_.empty(); }
+
+private:
+
+  struct Node
+  {
+    double box[6];
+    int    right;  // index of the right child, -1 for a leaf
+    int    begin;  // first entry of perm_ in this node
+    int    end;    // one past the last entry of perm_ in this node
+  };
+
+  int BuildRecursive(int begin, int end);
+
+  void SetLeafBox(Node& node) const;
+
+  static bool Overlap(const double* a, const double* b);
+
+  int                 leafsize_;
+  std::vector<Node>   nodes_;
+  std::vector<int>    perm_;   // item indices, grouped by leaf
+  std::vector<double> boxes_;  // item boxes, 6 per item
+};
+
+} // namespace MoertelT
+
+#endif // MOERTEL_SEGMENTBVH_HPP
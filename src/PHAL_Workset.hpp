@@ -111,6 +111,7 @@ struct Workset {
   Teuchos::RCP<const Albany::NodeSetCoordList> nodeSetCoords;
 
   Teuchos::RCP<const Albany::SideSetList> sideSets;
+  Teuchos::RCP<const Albany::LocalSideSetInfoList> localSideSets;
 
   // jacobian and mass matrix coefficients for matrix fill
   double j_coeff;
@@ -1,46 +1,29 @@
-//*****************************************************************//
-//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
-//    This Software is released under the BSD license detailed     //
-//    in the file "license.txt" in the top-level Albany directory  //
-//*****************************************************************//
-
 #include "QCADT_CoupledPSJacobian.hpp"
-#include "QCADT_ImplicitPSJacobian.hpp"
 #include "Teuchos_ParameterListExceptions.hpp"
 #include "Teuchos_TestForException.hpp"
-#include "Teuchos_VerboseObject.hpp"
-#include "Albany_Utils.hpp"
 #include "Thyra_DefaultBlockedLinearOp.hpp"
-#include "TpetraExt_MatrixMatrix.hpp"
-
-using Teuchos::getFancyOStream;
-using Teuchos::rcpFromRef;
-
-//#define WRITE_TO_MATRIX_MARKET
-
-#ifdef WRITE_TO_MATRIX_MARKET
-static int
-mm_counter = 0;
-#endif // WRITE_TO_MATRIX_MARKET
-
-#define OUTPUT_TO_SCREEN
+#include "Thyra_TpetraThyraWrappers.hpp"
 
 using Thyra::PhysicallyBlockedLinearOpBase;
 
 QCADT::CoupledPSJacobian::CoupledPSJacobian(int nEigenvals,
                                             const Teuchos::RCP<const Tpetra_Map>& discretizationMap,
+                                            const Teuchos::RCP<const Tpetra_Map>& distEigenvalMap,
+                                            Teuchos::RCP<Teuchos_Comm const> const & commT,
                                             int dim, int valleyDegen, double temp,
                                             double lengthUnitInMeters, double energyUnitInElectronVolts,
                                             double effMass, double conductionBandOffset,
-                                            Teuchos::RCP<Tpetra_Vector> neg_eigenvals,
-                                            Teuchos::RCP<const Tpetra_MultiVector> eigenvecs, 
-                                            Teuchos::RCP<Teuchos_Comm const> const & commT): 
-    num_models_(nEigenvals+1), 
-    nEigenvals_(nEigenvals),
+                                            const Teuchos::RCP<Tpetra_CrsMatrix>& Jac_Poisson,
+                                            const Teuchos::RCP<Tpetra_CrsMatrix>& Hamiltonian,
+                                            const Teuchos::RCP<Tpetra_CrsMatrix>& Mass): 
     commT_(commT), 
-    neg_eigenvalues(neg_eigenvals), 
-    psiVectors(eigenvecs),
+    num_models_(nEigenvals+2), 
+    nEigenvals_(nEigenvals),
     discMap(discretizationMap),
+    dist_evalMap(distEigenvalMap),
+    poissonJacobian(Jac_Poisson),
+    hamiltonian(Hamiltonian),
+    massMatrix(Mass),
     numDims(dim),
     valleyDegenFactor(valleyDegen),
     temperature(temp),
@@ -49,62 +32,62 @@ QCADT::CoupledPSJacobian::CoupledPSJacobian(int nEigenvals,
     effmass(effMass),
     offset_to_CB(conductionBandOffset) 
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << __PRETTY_FUNCTION__ << "\n";
-#endif
-   int num_discMap_myEls = discMap->getNodeNumElements();
-   // dn_dPsi : vectors of dn/dPsi[i] values
-   dn_dPsi = Teuchos::rcp(new Tpetra_MultiVector(*psiVectors)); 
+  Tpetra::LocalGlobal lg = Tpetra::LocallyReplicated;
+  local_evalMap = Teuchos::rcp(new Tpetra_Map(nEigenvals_, 0, commT_, lg));
+  eval_importer = Teuchos::rcp(new Tpetra_Import(dist_evalMap, local_evalMap));
+
+  // Allocated once: the blocks keep references to these, and initialize() updates them in place
+  neg_eigenvalues = Teuchos::rcp(new Tpetra_Vector(local_evalMap));
+  psiVectors = Teuchos::rcp(new Tpetra_MultiVector(discMap, nEigenvals_));
+  dn_dPsi = Teuchos::rcp(new Tpetra_MultiVector(discMap, nEigenvals_));
+  M_dn_dEval = Teuchos::rcp(new Tpetra_MultiVector(discMap, nEigenvals_));
+  M_Psi = Teuchos::rcp(new Tpetra_MultiVector(discMap, nEigenvals_));
+  MT_Psi = Teuchos::rcp(new Tpetra_MultiVector(discMap, nEigenvals_));
+}
+
+QCADT::CoupledPSJacobian::~CoupledPSJacobian()
+{
+}
+
+
+void
+QCADT::CoupledPSJacobian::initialize(const Teuchos::RCP<const Tpetra_Vector>& neg_eigenvals,
+                                     const Teuchos::RCP<const Tpetra_MultiVector>& eigenvecs)
+{
+   neg_eigenvalues->assign(*neg_eigenvals);
+   psiVectors->assign(*eigenvecs);
+
+   // Fill vectors that will be needed in apply(), but do so here so 
+   //   it is only done once per evalModel call, not each time apply() is called
+   const double prefactor = n_prefactor(numDims, valleyDegenFactor, temperature, length_unit_in_m, energy_unit_in_eV, effmass);
    const Teuchos::ArrayRCP<const ST> neg_eigenvalues_constView = neg_eigenvalues->get1dView(); 
-   for (int i=0; i<nEigenvals; i++) {
-     Teuchos::RCP<Tpetra_Vector> dn_dPsi_i = dn_dPsi->getVectorNonConst(i); 
+   Tpetra_MultiVector dn_dEval(discMap, nEigenvals_);
+   for (int i=0; i<nEigenvals_; i++) {
      Teuchos::RCP<const Tpetra_Vector> psiVectors_i = psiVectors->getVector(i); 
-     dn_dPsi_i->scale( n_prefactor(numDims, valleyDegenFactor, temperature, length_unit_in_m, energy_unit_in_eV, effmass)
-                          * 2 * n_weight_factor( -neg_eigenvalues_constView[i], numDims, temperature, energy_unit_in_eV), 
-                          *psiVectors_i); 
-   }
-   // dn_dEval : vectors of dn/dEval[i]
-   dn_dEval = Teuchos::rcp(new Tpetra_MultiVector( discMap, nEigenvals ));
-   for (int i=0; i<nEigenvals; i++) {
-     double prefactor = n_prefactor(numDims, valleyDegenFactor, temperature, length_unit_in_m, energy_unit_in_eV, effmass);
+
+     // dn_dPsi : vectors of dn/dPsi[i] values
+     dn_dPsi->getVectorNonConst(i)->scale(
+         prefactor * 2 * n_weight_factor( -neg_eigenvalues_constView[i], numDims, temperature, energy_unit_in_eV), 
+         *psiVectors_i); 
+
+     // dn_dEval : vectors of dn/dEval[i]
      double dweight = dn_weight_factor(-neg_eigenvalues_constView[i], numDims, temperature, energy_unit_in_eV);
-     //DEBUG
-     //double eps = 1e-7;
-     //double dweight = (n_weight_factor( -(*neg_eigenvalues)[i] + eps, numDims, temperature, energy_unit_in_eV) - 
-     //n_weight_factor( -(*neg_eigenvalues)[i], numDims, temperature, energy_unit_in_eV)) / eps; 
-     //const double kbBoltz = 8.617343e-05;
-     //std::cout << "DEBUG: dn_dEval["<<i<<"] dweight arg = " <<  (*neg_eigenvalues)[i]/(kbBoltz*temperature) << std::endl;  
-     //in [eV]
-     //std::cout << "DEBUG: dn_dEval["<<i<<"] factor = " <<  prefactor * dweight << std::endl;  // in [eV]
-     //DEBUG
-     Teuchos::RCP<Tpetra_Vector> dn_dEval_i = dn_dEval->getVectorNonConst(i); 
-     Teuchos::RCP<const Tpetra_Vector> psiVectors_i = psiVectors->getVector(i); 
-     for (int k=0; k<num_discMap_myEls; k++) {
-        const Teuchos::ArrayRCP<ST> dn_dEval_i_nonconstView = dn_dEval_i->get1dViewNonConst();
-        const Teuchos::ArrayRCP<const ST> psiVectors_i_constView = psiVectors_i->get1dView();
-        dn_dEval_i_nonconstView[k] =  prefactor * pow( psiVectors_i_constView[k], 2.0 ) * dweight;
-    //(*dn_dEval)(i)->Print( std::cout << "DEBUG: dn_dEval["<<i<<"]:" << std::endl );
-     }
+     Teuchos::RCP<Tpetra_Vector> dn_dEval_i = dn_dEval.getVectorNonConst(i); 
+     dn_dEval_i->elementWiseMultiply(prefactor * dweight, *psiVectors_i, *psiVectors_i, 0.0);
    }
-}
 
-QCADT::CoupledPSJacobian::~CoupledPSJacobian()
-{
+   // mass matrix multiplied by dn/dEval, Psi and transpose(mass matrix) multiplied by Psi
+   massMatrix->apply(dn_dEval, *M_dn_dEval, Teuchos::NO_TRANS, 1.0, 0.0);
+   massMatrix->apply(*psiVectors, *M_Psi, Teuchos::NO_TRANS, 1.0, 0.0);
+   massMatrix->apply(*psiVectors, *MT_Psi, Teuchos::TRANS, 1.0, 0.0);
 }
 
 
 // getThyraCoupledJacobian method is similar to getThyraMatrix in panzer
 //(Panzer_BlockedTpetraLinearObjFactory_impl.hpp).
 Teuchos::RCP<Thyra::LinearOpBase<ST>>
-QCADT::CoupledPSJacobian::getThyraCoupledJacobian(Teuchos::RCP<Tpetra_CrsMatrix> Jac_Poisson, 
-                                                  Teuchos::RCP<Tpetra_CrsMatrix> Jac_Schrodinger,
-                                                  Teuchos::RCP<Tpetra_CrsMatrix> Mass) const
+QCADT::CoupledPSJacobian::getThyraCoupledJacobian() const
 {
-//FIXME: pass necessary variables for Jacobian blocks
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << __PRETTY_FUNCTION__ << "\n";
-#endif
-    
     // Jacobian Matrix is:
     //
     //                   Phi                    Psi[i]                            -Eval[i]
@@ -125,162 +108,133 @@ QCADT::CoupledPSJacobian::getThyraCoupledJacobian(Teuchos::RCP<Tpetra_CrsMatrix>
     //
     //   Where:
     //       n = quantum density function which depends on dimension
+    //
+    //   All the eigenvalues form a single block, so the last block row and
+    //   column each hold the nEigenvals normalization equations and eigenvalues.
    
   int block_dim = num_models_; 
+  int eval_block = block_dim-1;
 
   // this operator will be square
   Teuchos::RCP<Thyra::PhysicallyBlockedLinearOpBase<ST>>blocked_op = Thyra::defaultBlockedLinearOp<ST>();
   blocked_op->beginBlockFill(block_dim, block_dim);
 
   //populate (Poisson,Poisson) block with Jac_Poisson
-  Teuchos::RCP<Thyra::LinearOpBase<ST>> blockPP = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(Jac_Poisson);
-  blocked_op->setNonconstBlock(0, 0, blockPP);
-
-  Teuchos::Array<ST> matrixEntriesT;
-  Teuchos::Array<LO> matrixIndicesT; 
-  size_t numEntriesT;  
-  ST val;
-  //create graph for matrix with nEigenvals columns
-  Teuchos::RCP<Tpetra_CrsGraph> graphEvalsCols = Teuchos::rcp(new Tpetra_CrsGraph(Mass->getMap(), nEigenvals_)); 
-  graphEvalsCols->fillComplete();  
-  //create graph for diagonal 
-  Teuchos::RCP<Tpetra_CrsGraph> graphDiag = Teuchos::rcp(new Tpetra_CrsGraph(Mass->getMap(), 1));
-  graphDiag->fillComplete(); 
- 
-  //populate (Poisson, Schrodinger) blocks with M*diag(dn_dPsi[j])
-  //fillComplete() Mass matrix -- necessary for Multiply command below
-  //Why is Mass not passed in fillCompleted? 
-  Mass->fillComplete(); 
-  for (int j=1; j<block_dim-1; j++) {
-    Teuchos::RCP<Tpetra_CrsMatrix> blockPS_crs = Teuchos::rcp(new Tpetra_CrsMatrix(Mass->getMap(), Mass->getGlobalMaxNumRowEntries()));
-    //Get (j-1)st entry of dn_dPsi
-    Teuchos::RCP<const Tpetra_Vector> dn_dPsi_j = dn_dPsi->getVector(j-1);
-    const Teuchos::ArrayRCP<const ST> dn_dPsi_j_constView = dn_dPsi_j->get1dView(); 
-    //Create CrsMatrix whose diagonal is dn_dPsi_j
-    //IKT: Is there a Tpetra command to create diagonal CrsMatrix from Vector??
-    Teuchos::RCP<Tpetra_CrsMatrix> dn_dPsi_j_crs = Teuchos::rcp(new Tpetra_CrsMatrix(graphDiag));
-    for (LO row = 0; row < dn_dPsi_j_crs->getNodeNumRows(); row++){
-      val = dn_dPsi_j_constView[row]; 
-      dn_dPsi_j_crs->replaceLocalValues(row, Teuchos::arrayView(&row,1), Teuchos::arrayView(&val,1)); 
-    }
-    dn_dPsi_j_crs->fillComplete(); 
-    //blockPS_crs = M*diag(dn_dPsi[j]) 
-    Tpetra::MatrixMatrix::Multiply(*Mass, false, *dn_dPsi_j_crs, false, *blockPS_crs, true); 
-    Teuchos::RCP<Thyra::LinearOpBase<ST>> blockPS = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(blockPS_crs);
-    blocked_op->setNonconstBlock(0, j, blockPS); 
-  }
-  //FIXME, IKT, 6/22/15: check with Erik what does col mean.
-  //populate (Poisson, eigenvalue) block with -M*col(dn/dEval[i]) -- 1 matrix with nEigenvals columns
-  Teuchos::RCP<Tpetra_CrsMatrix> blockPE_crs = Teuchos::rcp(new Tpetra_CrsMatrix(graphEvalsCols));
+  blocked_op->setNonconstBlock(0, 0, Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(poissonJacobian));
+
+  //populate (Poisson, eigenvalue) block with -M*col(dn/dEval[i])
+  blocked_op->setNonconstBlock(0, eval_block, Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(
+      Teuchos::rcp(new CoupledPSJacobianBlock(*this, CoupledPSJacobianBlock::POISSON_EIGENVALUE, 0))));
+
   for (int i=0; i<nEigenvals_; i++) {
-    if (dn_dEval != Teuchos::null) {
-      //get ith dn_dEval vector
-      Teuchos::RCP<const Tpetra_Vector> dn_dEval_i = dn_dEval->getVector(i); 
-      const Teuchos::ArrayRCP<const ST> dn_dEval_i_constView = dn_dEval_i->get1dView(); 
-      //loop over rows of Mass Matrix
-      for (LO row = 0; row<Mass->getNodeNumRows(); row++) {
-        val = 0.0;
-        //get number of entries in tow 
-        numEntriesT = Mass->getNumEntriesInLocalRow(row);
-        matrixEntriesT.resize(numEntriesT);
-        matrixIndicesT.resize(numEntriesT);
-        //get copy of row  
-        Mass->getLocalRowCopy(row, matrixIndicesT(), matrixEntriesT(), numEntriesT); 
-        //loop over columns of mass and calculate -Mass*dn_dEval[i]
-        for (LO col=0; col<numEntriesT; col++) {
-          val += -1.0*matrixEntriesT[col]*dn_dEval_i_constView[matrixIndicesT[col]]; 
-        }
-        //Sum into ith column of blockPE_crs
-        blockPE_crs->sumIntoLocalValues(row, Teuchos::arrayView(&i,1), Teuchos::arrayView(&val,1)); 
-      }
-    }
-  }
-  blockPE_crs->fillComplete();  
-  Teuchos::RCP<Thyra::LinearOpBase<ST>> blockPE = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(blockPE_crs);
-  blocked_op->setNonconstBlock(0, block_dim-1, blockPE); 
-
-  //populate (Schrodinger, Poisson) blocks with -M*diag(psiVectors[i]) 
-  for (int i=1; i<block_dim-1; i++) {
-    Teuchos::RCP<Tpetra_CrsMatrix> blockSP_crs = Teuchos::rcp(new Tpetra_CrsMatrix(Mass->getMap(), Mass->getGlobalMaxNumRowEntries()));
-    //Get (i-1)st entry of psiVectors
-    Teuchos::RCP<const Tpetra_Vector> psiVectors_i = psiVectors->getVector(i-1); 
-    const Teuchos::ArrayRCP<const ST> psiVectors_i_constView = psiVectors_i->get1dView(); 
-    //Create CrsMatrix whose diagonal -psiVectors_i
-    //IKT: Is there a Tpetra command to create diagonal CrsMatrix from Vector??
-    Teuchos::RCP<Tpetra_CrsMatrix> psiVectors_i_crs = Teuchos::rcp(new Tpetra_CrsMatrix(graphDiag));
-    for (LO row = 0; row < psiVectors_i_crs->getNodeNumRows(); row++){
-      val = -1.0*psiVectors_i_constView[row]; 
-      psiVectors_i_crs->replaceLocalValues(row, Teuchos::arrayView(&row,1), Teuchos::arrayView(&val,1)); 
-    }
-    psiVectors_i_crs->fillComplete(); 
-    //blockSP_crs = =M*diag(psiVectors[i]) 
-    Tpetra::MatrixMatrix::Multiply(*Mass, false, *psiVectors_i_crs, false, *blockSP_crs, true); 
-    Teuchos::RCP<Thyra::LinearOpBase<ST>> blockSP = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(blockSP_crs);
-    blocked_op->setNonconstBlock(i, 0, blockSP); 
-  }
-  //Populate (Schrodinger, Schrodinger) block with delta(i,j)*(H-eval[j]*M)
-  //Call fill complete on Jac_Schrodinger
-  //Jac_Schrodinger->fillComplete();  
-  const Teuchos::ArrayRCP<const ST> neg_eigenvalues_constView = neg_eigenvalues->get1dView();
-  for (int i=1; i<block_dim-1; i++) {
-    for (int j=1; j<block_dim-1; j++) {
-      //Create CrsMatrix to hold SS block
-      Teuchos::RCP<Tpetra_CrsMatrix> blockSS_crs = Teuchos::rcp(new Tpetra_CrsMatrix(Jac_Schrodinger->getMap(), 
-                                                                    Jac_Schrodinger->getGlobalMaxNumRowEntries()));
-      //blockSS_crs = H-eval[j]*M
-      Tpetra::MatrixMatrix::Add(*Jac_Schrodinger, false, 1.0, *Mass, false, neg_eigenvalues_constView[j-1], blockSS_crs); 
-      blockSS_crs->fillComplete(); 
-      Teuchos::RCP<Thyra::LinearOpBase<ST>> blockSS = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(blockSS_crs);
-      blocked_op->setNonconstBlock(i, j, blockSS); 
-    }
-  } 
-  //
-  //Populate (Schrodinger, eigenvalue) block with delta(i,j)*M*Psi[j] 
-  for (int i=1; i<block_dim-1; i++) {
-    Teuchos::RCP<Tpetra_CrsMatrix> blockSE_crs = Teuchos::rcp(new Tpetra_CrsMatrix(graphEvalsCols));
-    for (int j=0; j<nEigenvals_; j++) {
-      if (dn_dEval != Teuchos::null) {
-        //get jth psiVectors vector
-        Teuchos::RCP<const Tpetra_Vector> psiVectors_j = psiVectors->getVector(j); 
-        const Teuchos::ArrayRCP<const ST> psiVectors_j_constView = psiVectors_j->get1dView(); 
-        //loop over rows of Mass Matrix
-        for (LO row = 0; row<Mass->getNodeNumRows(); row++) {
-          val = 0.0;
-          //get number of entries in tow 
-          numEntriesT = Mass->getNumEntriesInLocalRow(row);
-          matrixEntriesT.resize(numEntriesT);
-          matrixIndicesT.resize(numEntriesT);
-          //get copy of row  
-          Mass->getLocalRowCopy(row, matrixIndicesT(), matrixEntriesT(), numEntriesT); 
-          //loop over columns of mass and calculate Mass*psiVectors[j]
-          for (LO col=0; col<numEntriesT; col++) {
-            val += matrixEntriesT[col]*psiVectors_j_constView[matrixIndicesT[col]]; 
-          }
-         //Sum into jth column of blockPE_crs
-         blockSE_crs->sumIntoLocalValues(row, Teuchos::arrayView(&j,1), Teuchos::arrayView(&val,1)); 
-        }
-      }
-    }
-    blockSE_crs->fillComplete();  
-    Teuchos::RCP<Thyra::LinearOpBase<ST>> blockSE = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(blockSE_crs);
-    blocked_op->setNonconstBlock(i, 0, blockSE);
+    int schro_block = 1+i;
+
+    //populate (Poisson, Schrodinger) blocks with M*diag(dn_dPsi[i])
+    blocked_op->setNonconstBlock(0, schro_block, Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(
+        Teuchos::rcp(new CoupledPSJacobianBlock(*this, CoupledPSJacobianBlock::POISSON_SCHRODINGER, i))));
+
+    //populate (Schrodinger, Poisson) blocks with M*diag(-Psi[i])
+    blocked_op->setNonconstBlock(schro_block, 0, Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(
+        Teuchos::rcp(new CoupledPSJacobianBlock(*this, CoupledPSJacobianBlock::SCHRODINGER_POISSON, i))));
+
+    //populate (Schrodinger, Schrodinger) diagonal blocks with H-Eval[i]*M
+    blocked_op->setNonconstBlock(schro_block, schro_block, Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(
+        Teuchos::rcp(new CoupledPSJacobianBlock(*this, CoupledPSJacobianBlock::SCHRODINGER_SCHRODINGER, i))));
+
+    //populate (Schrodinger, eigenvalue) blocks with M*Psi[i] in column i
+    blocked_op->setNonconstBlock(schro_block, eval_block, Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(
+        Teuchos::rcp(new CoupledPSJacobianBlock(*this, CoupledPSJacobianBlock::SCHRODINGER_EIGENVALUE, i))));
+
+    //populate (eigenvalue, Schrodinger) blocks with -(M+M^T)*Psi[i] in row i
+    blocked_op->setNonconstBlock(eval_block, schro_block, Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(
+        Teuchos::rcp(new CoupledPSJacobianBlock(*this, CoupledPSJacobianBlock::EIGENVALUE_SCHRODINGER, i))));
   }
-  //Populate (eigenvalue, Schrodinger) block
-  //FIXME, IKT, 6/22/15: ask Erik what this block should be! 
-  //FIXME: This is temporary to debug other parts of the code!  Need to populate Jacobian correctly. 
-   blocked_op->setNonconstBlock(2,1, blockPP); 
 
   // all done
   blocked_op->endBlockFill();
-#ifdef OUTPUT_TO_SCREEN
-  Teuchos::RCP<Teuchos::FancyOStream> out = fancyOStream(rcpFromRef(std::cout));
-  std::cout << "blocked_op: " << std::endl;
-  blocked_op->describe(*out, Teuchos::VERB_HIGH);
-#endif
   return blocked_op;
 }
 
 
+QCADT::CoupledPSJacobianBlock::CoupledPSJacobianBlock(const CoupledPSJacobian& jac, BlockType type, int index):
+  type_(type),
+  index_(index),
+  domainMap(jac.discMap),
+  rangeMap(jac.discMap),
+  eval_importer(jac.eval_importer),
+  hamiltonian(jac.hamiltonian),
+  massMatrix(jac.massMatrix),
+  neg_eigenvalues(jac.neg_eigenvalues),
+  psiVectors(jac.psiVectors),
+  dn_dPsi(jac.dn_dPsi),
+  M_dn_dEval(jac.M_dn_dEval),
+  M_Psi(jac.M_Psi),
+  MT_Psi(jac.MT_Psi)
+{
+  if (type_ == POISSON_EIGENVALUE || type_ == SCHRODINGER_EIGENVALUE)
+    domainMap = jac.dist_evalMap;
+  if (type_ == EIGENVALUE_SCHRODINGER)
+    rangeMap = jac.dist_evalMap;
+
+  tempVec = Teuchos::rcp(new Tpetra_Vector(rangeMap));
+  tempVec2 = Teuchos::rcp(new Tpetra_Vector(jac.discMap));
+  x_neg_evals_local = Teuchos::rcp(new Tpetra_Vector(jac.local_evalMap));
+}
+
+
+//! Returns the result of a Tpetra_Operator applied to a Tpetra_MultiVector X in Y.
+void QCADT::CoupledPSJacobianBlock::apply(Tpetra_MultiVector const & X,
+                                         Tpetra_MultiVector & Y,
+                                         Teuchos::ETransp mode,
+                                         ST alpha,
+                                         ST beta) const
+{ 
+  TEUCHOS_TEST_FOR_EXCEPTION(mode != Teuchos::NO_TRANS, std::logic_error,
+      "Error!  QCADT::CoupledPSJacobianBlock does not support transpose apply" << std::endl);
+
+  for (std::size_t c=0; c < X.getNumVectors(); c++) {
+    Teuchos::RCP<const Tpetra_Vector> x = X.getVector(c);
+
+    // tempVec = block * x, computed block-wise as in QCAD::CoupledPSJacobian::Apply
+    switch (type_) {
+      case POISSON_SCHRODINGER:
+        tempVec2->elementWiseMultiply(1.0, *dn_dPsi->getVector(index_), *x, 0.0); // tempVec2 = dn_dPsi[i] @ x   (@ = el-wise product)
+        massMatrix->apply(*tempVec2, *tempVec);                                 // tempVec = M * (dn_dPsi[i] @ x)
+        break;
+      case POISSON_EIGENVALUE:
+        // Communicate all the x_evals to every processor, since all parts of the mesh need them
+        x_neg_evals_local->doImport(*x, *eval_importer, Tpetra::INSERT);
+        tempVec->multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, -1.0, *M_dn_dEval, *x_neg_evals_local, 0.0); // tempVec = sum_i M * (-dn_dEval[i] * x_neg_eval[i])
+        break;
+      case SCHRODINGER_POISSON:
+        tempVec2->elementWiseMultiply(-1.0, *psiVectors->getVector(index_), *x, 0.0); // tempVec2 = (-Psi[j]) @ x
+        massMatrix->apply(*tempVec2, *tempVec);                                    // tempVec = M * ( (-Psi[j]) @ x )
+        break;
+      case SCHRODINGER_SCHRODINGER:
+        hamiltonian->apply(*x, *tempVec);                                                   // tempVec = H * x
+        massMatrix->apply(*x, *tempVec, Teuchos::NO_TRANS, neg_eigenvalues->get1dView()[index_], 1.0); // tempVec += -eval[j] * M * x
+        break;
+      case SCHRODINGER_EIGENVALUE:
+        x_neg_evals_local->doImport(*x, *eval_importer, Tpetra::INSERT);
+        tempVec->update(x_neg_evals_local->get1dView()[index_], *M_Psi->getVector(index_), 0.0); // tempVec = M*Psi[j] * x_neg_eval[j]
+        break;
+      case EIGENVALUE_SCHRODINGER:
+      {
+        tempVec2->update(-1.0, *M_Psi->getVector(index_), -1.0, *MT_Psi->getVector(index_), 0.0); // tempVec2 = -(M+M^T)*Psi[j]
+        ST y_neg_eval = tempVec2->dot(*x);
+        // Only the processor owning eigenvalue j gets a nonzero entry
+        tempVec->putScalar(0.0);
+        LO local_index = rangeMap->getLocalElement(index_);
+        if (local_index != Teuchos::OrdinalTraits<LO>::invalid())
+          tempVec->replaceLocalValue(local_index, y_neg_eval);
+        break;
+      }
+    }
+
+    Y.getVectorNonConst(c)->update(alpha, *tempVec, beta);
+  }
+}
+
 
 
 // *****************************************************************************
@@ -39,34 +39,54 @@ namespace QCADT {
 /** 
  *  \brief A class that evaluates the Jacobian of a
  *  QCAD coupled Poisson-Schrodinger problem
+ *
+ *  The Jacobian is assembled as a Thyra blocked operator over the
+ *  (Phi, Psi[0..n-1], -Eval) blocks of the coupled solution.  The Poisson
+ *  Jacobian, Hamiltonian and mass matrices are owned by the caller and
+ *  refilled in place, and initialize() updates the eigenpair-dependent
+ *  vectors in place, so an operator returned by getThyraCoupledJacobian()
+ *  stays valid for the lifetime of this object.
  */
 
 class CoupledPSJacobian {
 public:
   CoupledPSJacobian(int nEigenvals,
                     const Teuchos::RCP<const Tpetra_Map>& discretizationMap,
+                    const Teuchos::RCP<const Tpetra_Map>& distEigenvalMap,
+                    Teuchos::RCP<Teuchos_Comm const> const & commT,
                     int dim, int valleyDegen, double temp,
                     double lengthUnitInMeters, double energyUnitInElectronVolts,
-                    double effMass, double conductionBandOffset, 
-                    Teuchos::RCP<Tpetra_Vector> neg_eigenvals,
-                    Teuchos::RCP<const Tpetra_MultiVector> eigenvecs,
-                    Teuchos::RCP<Teuchos_Comm const> const & commT);
+                    double effMass, double conductionBandOffset,
+                    const Teuchos::RCP<Tpetra_CrsMatrix>& Jac_Poisson,
+                    const Teuchos::RCP<Tpetra_CrsMatrix>& Hamiltonian,
+                    const Teuchos::RCP<Tpetra_CrsMatrix>& Mass);
 
   ~CoupledPSJacobian();
 
-  Teuchos::RCP<Thyra::LinearOpBase<ST>> getThyraCoupledJacobian(Teuchos::RCP<Tpetra_CrsMatrix> Jac_Poisson,
-                                                  Teuchos::RCP<Tpetra_CrsMatrix> Jac_Schrodinger,
-                                                  Teuchos::RCP<Tpetra_CrsMatrix> Mass) const; 
+  //! Update the eigenpair-dependent parts of the Jacobian; neg_eigenvals is locally replicated
+  void initialize(const Teuchos::RCP<const Tpetra_Vector>& neg_eigenvals,
+                  const Teuchos::RCP<const Tpetra_MultiVector>& eigenvecs);
+
+  Teuchos::RCP<Thyra::LinearOpBase<ST>> getThyraCoupledJacobian() const; 
 
 private:
 
+  friend class CoupledPSJacobianBlock;
+
   Teuchos::RCP<Teuchos_Comm const> commT_;
   int num_models_; 
   int nEigenvals_; 
-  Teuchos::RCP<Tpetra_MultiVector> dn_dPsi, dn_dEval;
-  Teuchos::RCP<Tpetra_Vector> neg_eigenvalues;
-  Teuchos::RCP<const Tpetra_MultiVector> psiVectors;
   Teuchos::RCP<const Tpetra_Map> discMap;
+  Teuchos::RCP<const Tpetra_Map> dist_evalMap, local_evalMap;
+  Teuchos::RCP<const Tpetra_Import> eval_importer;
+
+  Teuchos::RCP<Tpetra_CrsMatrix> poissonJacobian, hamiltonian, massMatrix;
+
+  // Intermediate quantities computed in initialize() to speed up apply()
+  Teuchos::RCP<Tpetra_Vector> neg_eigenvalues;
+  Teuchos::RCP<Tpetra_MultiVector> psiVectors;
+  Teuchos::RCP<Tpetra_MultiVector> dn_dPsi, M_dn_dEval;
+  Teuchos::RCP<Tpetra_MultiVector> M_Psi, MT_Psi;
 
   // Values for computing the quantum density
   int numDims;
@@ -79,5 +99,45 @@ private:
 
 };
 
+/** 
+ *  \brief A Tpetra operator that applies one block of a CoupledPSJacobian
+ */
+
+class CoupledPSJacobianBlock : public Tpetra_Operator {
+public:
+  enum BlockType { POISSON_SCHRODINGER, POISSON_EIGENVALUE,
+                   SCHRODINGER_POISSON, SCHRODINGER_SCHRODINGER,
+                   SCHRODINGER_EIGENVALUE, EIGENVALUE_SCHRODINGER };
+
+  CoupledPSJacobianBlock(const CoupledPSJacobian& jac, BlockType type, int index);
+
+  //! Returns the result of a Tpetra_Operator applied to a Tpetra_MultiVector X in Y.
+  virtual void apply(
+    Tpetra_MultiVector const & X,
+    Tpetra_MultiVector & Y,
+    Teuchos::ETransp mode = Teuchos::NO_TRANS,
+    ST alpha = Teuchos::ScalarTraits<ST>::one(),
+    ST beta = Teuchos::ScalarTraits<ST>::zero()) const;
+
+  virtual bool hasTransposeApply() const { return false; }
+
+  virtual Teuchos::RCP<Tpetra_Map const> getDomainMap() const { return domainMap; }
+
+  virtual Teuchos::RCP<Tpetra_Map const> getRangeMap() const { return rangeMap; }
+
+private:
+  BlockType type_;
+  int index_;
+  Teuchos::RCP<const Tpetra_Map> domainMap, rangeMap;
+  Teuchos::RCP<const Tpetra_Import> eval_importer;
+
+  Teuchos::RCP<Tpetra_CrsMatrix> hamiltonian, massMatrix;
+  Teuchos::RCP<const Tpetra_Vector> neg_eigenvalues;
+  Teuchos::RCP<const Tpetra_MultiVector> psiVectors, dn_dPsi, M_dn_dEval, M_Psi, MT_Psi;
+
+  // Scratch space for apply()
+  Teuchos::RCP<Tpetra_Vector> tempVec, tempVec2, x_neg_evals_local;
+};
+
 }
 #endif  
@@ -0,0 +1,90 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "QCADT_CoupledPSPreconditioner.hpp"
+#include "Thyra_DefaultBlockedLinearOp.hpp"
+#include "Thyra_DefaultIdentityLinearOp.hpp"
+#include "Thyra_TpetraThyraWrappers.hpp"
+
+
+QCADT::CoupledPSPreconditioner::CoupledPSPreconditioner(int nEigenvals,
+                                                        const Teuchos::RCP<const Tpetra_Map>& distEigenvalMap,
+                                                        const Teuchos::RCP<Tpetra_CrsMatrix>& poissonJac,
+                                                        const Teuchos::RCP<Tpetra_CrsMatrix>& schrodingerJac):
+  nEigenvals_(nEigenvals),
+  dist_evalMap(distEigenvalMap),
+  bInitialized(false)
+{
+  // Same incomplete LU settings the Epetra coupled solver uses with Ifpack
+  Teuchos::ParameterList pl;
+  pl.set<int>("fact: iluk level-of-fill", 1);
+  pl.set<double>("fact: drop tolerance", 1e-9);
+
+  poissonPreconditioner = Teuchos::rcp(new Ifpack2::RILUK<Tpetra_RowMatrix>(poissonJac));
+  poissonPreconditioner->setParameters(pl);
+
+  schrodingerPreconditioner = Teuchos::rcp(new Ifpack2::RILUK<Tpetra_RowMatrix>(schrodingerJac));
+  schrodingerPreconditioner->setParameters(pl);
+}
+
+QCADT::CoupledPSPreconditioner::~CoupledPSPreconditioner()
+{
+}
+
+
+void QCADT::CoupledPSPreconditioner::compute()
+{
+  // The graphs of the Jacobians never change, so the symbolic factorization is done once
+  if (!bInitialized) {
+    poissonPreconditioner->initialize();
+    schrodingerPreconditioner->initialize();
+    bInitialized = true;
+  }
+  poissonPreconditioner->compute();
+  schrodingerPreconditioner->compute();
+}
+
+
+Teuchos::RCP<Thyra::LinearOpBase<ST>>
+QCADT::CoupledPSPreconditioner::getThyraCoupledPreconditioner() const
+{
+    // Preconditioner Matrix is:
+    //
+    //                   Phi                    Psi[i]                            -Eval[i]
+    //          | ---------------------------------------------------------------------------------|
+    //          |                      |                             |                             |
+    // Poisson  |    Precond_poisson   |           0                 |               0             |
+    //          |                      |                             |                             |
+    //          | ---------------------------------------------------------------------------------|
+    //          |                      |                             |                             |
+    // Schro[j] |          0           |     Precond_schrodinger     |               0             |    
+    //          |                      |                             |                             |
+    //          | ---------------------------------------------------------------------------------|
+    //          |                      |                             |                             |
+    // Norm[j]  |          0           |            0                |           Identity          |
+    //          |                      |                             |                             |
+    //          | ---------------------------------------------------------------------------------|
+
+  int block_dim = nEigenvals_+2;
+
+  Teuchos::RCP<Thyra::PhysicallyBlockedLinearOpBase<ST>>blocked_op = Thyra::defaultBlockedLinearOp<ST>();
+  blocked_op->beginBlockFill(block_dim, block_dim);
+
+  blocked_op->setNonconstBlock(0, 0, Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(
+      Teuchos::rcp_implicit_cast<Tpetra_Operator>(poissonPreconditioner)));
+
+  // Every eigenvector sees the same (linear) Schrodinger Jacobian, so the factorization is shared
+  Teuchos::RCP<Thyra::LinearOpBase<ST>> schrodingerBlock = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(
+      Teuchos::rcp_implicit_cast<Tpetra_Operator>(schrodingerPreconditioner));
+  for (int i=1; i<block_dim-1; i++)
+    blocked_op->setNonconstBlock(i, i, schrodingerBlock);
+
+  blocked_op->setBlock(block_dim-1, block_dim-1,
+      Thyra::identity<ST>(Thyra::createVectorSpace<ST, LO, Tpetra_GO, KokkosNode>(dist_evalMap)));
+
+  blocked_op->endBlockFill();
+  return blocked_op;
+}
@@ -0,0 +1,51 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef QCADT_COUPLEDPSPRECOND_H
+#define QCADT_COUPLEDPSPRECOND_H
+
+#include "Teuchos_RCP.hpp"
+#include "Tpetra_CrsMatrix.hpp"
+#include "Tpetra_Map.hpp"
+
+#include "Albany_DataTypes.hpp"
+
+#include "Thyra_LinearOpBase.hpp"
+
+#include <Ifpack2_RILUK.hpp>
+
+namespace QCADT {
+
+/** 
+ *  \brief A block diagonal preconditioner for the Jacobian of a QCAD coupled
+ *  Poisson-Schrodinger problem: ILU of the Poisson Jacobian, ILU of the
+ *  Schrodinger Jacobian for every eigenvector and identity on the eigenvalues
+ */
+
+class CoupledPSPreconditioner {
+public:
+  CoupledPSPreconditioner(int nEigenvals,
+                          const Teuchos::RCP<const Tpetra_Map>& distEigenvalMap,
+                          const Teuchos::RCP<Tpetra_CrsMatrix>& poissonJac,
+                          const Teuchos::RCP<Tpetra_CrsMatrix>& schrodingerJac);
+
+  ~CoupledPSPreconditioner();
+
+  //! Recompute the factorizations after the Jacobians have been refilled
+  void compute();
+
+  Teuchos::RCP<Thyra::LinearOpBase<ST>> getThyraCoupledPreconditioner() const;
+
+private:
+  int nEigenvals_;
+  Teuchos::RCP<const Tpetra_Map> dist_evalMap;
+  Teuchos::RCP< Ifpack2::RILUK<Tpetra_RowMatrix> > poissonPreconditioner;
+  Teuchos::RCP< Ifpack2::RILUK<Tpetra_RowMatrix> > schrodingerPreconditioner;
+  bool bInitialized;
+};
+
+}
+#endif
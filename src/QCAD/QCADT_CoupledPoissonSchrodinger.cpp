@@ -34,11 +34,10 @@ Please remove when issue is resolved
 #include "Albany_AbstractFieldContainer.hpp"
 #include "Albany_NullSpaceUtils.hpp"
 
-//Ifpack includes
-#include "Ifpack_ConfigDefs.h"
-#include "Ifpack.h"
+#include "Thyra_DefaultPreconditioner.hpp"
+#include "Thyra_ProductMultiVectorBase.hpp"
+#include "Thyra_MultiVectorStdOps.hpp"
 
-#define OUTPUT_TO_SCREEN
 
 std::string QCADT::strdim(const std::string s, const int dim) {
   std::ostringstream ss;
@@ -54,7 +53,6 @@ CoupledPoissonSchrodinger(const Teuchos::RCP<Teuchos::ParameterList>& appParams_
                           Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<ST> const> const &solver_factory):
   solver_factory_(solver_factory)
 {
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
   using std::string;
   myComm = comm;  
   // make a copy of the appParams, since we modify them below (e.g. discretization list)
@@ -278,15 +276,11 @@ CoupledPoissonSchrodinger(const Teuchos::RCP<Teuchos::ParameterList>& appParams_
   Albany::ModelFactory schrodingerModelFactory(schro_appParams, schrodingerApp);
   schrodingerModel = schrodingerModelFactory.createT();
   
-  //Get Schrodinger Jacobian 
-  Teuchos::RCP<Tpetra_Operator> const Jac_Schrodinger_temp =
-        Teuchos::nonnull(poissonModel->create_W_op()) ?
-            ConverterT::getTpetraOperator(schrodingerModel->create_W_op()) :
-            Teuchos::null;
-  Jac_Schrodinger =
-        Teuchos::nonnull(Jac_Schrodinger_temp) ?
-            Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(Jac_Schrodinger_temp, true) :
-            Teuchos::null;
+  //Get Schrodinger Jacobian (the Hamiltonian) and mass matrix -- both are refilled in place by evalModel
+  Jac_Schrodinger = Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(
+        ConverterT::getTpetraOperator(schrodingerModel->create_W_op()), true);
+  Mass_Schrodinger = Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(
+        ConverterT::getTpetraOperator(schrodingerModel->create_W_op()), true);
 
   //Save the discretization's maps for convenience (should be the same for Poisson and Schrodinger apps)
   disc_map = poissonApp->getMapT();
@@ -310,6 +304,12 @@ CoupledPoissonSchrodinger(const Teuchos::RCP<Teuchos::ParameterList>& appParams_
   // Create sacado parameter vectors of appropriate size for use in evalModel
   poisson_sacado_param_vec.resize(num_poisson_param_vecs);
   schrodinger_sacado_param_vec.resize(num_schrodinger_param_vecs);
+  for (int l = 0; l < num_poisson_param_vecs; ++l)
+    poissonApp->getParamLib()->fillVector<PHAL::AlbanyTraits::Residual>(
+        *poissonModel->get_p_names(l), poisson_sacado_param_vec[l]);
+  for (int l = 0; l < num_schrodinger_param_vecs; ++l)
+    schrodingerApp->getParamLib()->fillVector<PHAL::AlbanyTraits::Residual>(
+        *schrodingerModel->get_p_names(l), schrodinger_sacado_param_vec[l]);
 
   // Response vectors:  Response vectors of coupled PS model evaluator are just the response vectors
   //   of the Poisson then Schrodinger model evaluators (in order).
@@ -317,6 +317,7 @@ CoupledPoissonSchrodinger(const Teuchos::RCP<Teuchos::ParameterList>& appParams_
 
 
   // Set member variables based on parameters from the main list
+  bVerbose = problemParams.get<bool>("Verbose Output", false);
   temperature = Temp;
   length_unit_in_m  = lenUnit;
   energy_unit_in_eV = energyUnit;
@@ -446,6 +447,16 @@ CoupledPoissonSchrodinger(const Teuchos::RCP<Teuchos::ParameterList>& appParams_
   quantumMtrlName = materialDB->getParam<std::string>("Quantum Material");
   valleyDegeneracyFactor = materialDB->getMaterialParam<int>(quantumMtrlName,"Number of conduction band min",2);
   effMass = materialDB->getMaterialParam<double>(quantumMtrlName,"Transverse Electron Effective Mass");
+
+  // Coupled Jacobian and preconditioner -- built once around the persistent matrices
+  psJacobian = Teuchos::rcp(new QCADT::CoupledPSJacobian(nEigenvals, disc_map, dist_eigenval_map, myComm,
+                          numDims, valleyDegeneracyFactor, temperature,
+                          length_unit_in_m, energy_unit_in_eV, effMass, offset_to_CB,
+                          Jac_Poisson, Jac_Schrodinger, Mass_Schrodinger));
+#ifdef ALBANY_IFPACK2
+  psPreconditioner = Teuchos::rcp(new QCADT::CoupledPSPreconditioner(nEigenvals, dist_eigenval_map,
+                          Jac_Poisson, Jac_Schrodinger));
+#endif
 }
 
 QCADT::CoupledPoissonSchrodinger::~CoupledPoissonSchrodinger()
@@ -455,9 +466,6 @@ QCADT::CoupledPoissonSchrodinger::~CoupledPoissonSchrodinger()
 void
 QCADT::CoupledPoissonSchrodinger::allocateVectors()
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   Teuchos::Array<Teuchos::RCP<Thyra::VectorSpaceBase<ST> const>> spaces(num_models_); 
   
   //Poisson and Schrodinger have same disc_map
@@ -516,22 +524,17 @@ QCADT::CoupledPoissonSchrodinger::allocateVectors()
 
 Teuchos::RCP<const Thyra::VectorSpaceBase<ST>> QCADT::CoupledPoissonSchrodinger::get_x_space() const
 {
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
   return createCombinedRangeSpace(); 
 }
 
 Teuchos::RCP<const Thyra::VectorSpaceBase<ST>> QCADT::CoupledPoissonSchrodinger::get_f_space() const
 {
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
   return createCombinedRangeSpace(); 
 }
 
 Teuchos::RCP<Thyra::VectorSpaceBase<ST> const>
 QCADT::CoupledPoissonSchrodinger::createCombinedRangeSpace() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   Teuchos::RCP<Thyra::ProductVectorSpaceBase<ST> > range_space; 
   // loop over all vectors and build the vector space
   std::vector<Teuchos::RCP<Thyra::VectorSpaceBase<ST> const>> vs_array;
@@ -549,9 +552,6 @@ QCADT::CoupledPoissonSchrodinger::createCombinedRangeSpace() const
 
 Teuchos::RCP<const Thyra::VectorSpaceBase<ST>> QCADT::CoupledPoissonSchrodinger::get_p_space(int l) const
 {
-  #ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   TEUCHOS_TEST_FOR_EXCEPTION(l >= num_param_vecs || l < 0, Teuchos::Exceptions::InvalidParameter,
                      std::endl <<
                      "Error in QCADT::CoupledPoissonSchrodinger::get_p_space():  " <<
@@ -572,33 +572,25 @@ Teuchos::RCP<const Thyra::VectorSpaceBase<ST>> QCADT::CoupledPoissonSchrodinger:
 
 Teuchos::RCP<const Thyra::VectorSpaceBase<ST>> QCADT::CoupledPoissonSchrodinger::get_g_space(int j) const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
-  TEUCHOS_TEST_FOR_EXCEPTION(j > num_response_vecs || j < 0, Teuchos::Exceptions::InvalidParameter,
+  TEUCHOS_TEST_FOR_EXCEPTION(j >= num_response_vecs || j < 0, Teuchos::Exceptions::InvalidParameter,
                      std::endl <<
                      "Error in QCADT::CoupledPoissonSchrodinger::get_g_space():  " <<
                      "Invalid response index j = " << j << std::endl);
   
-  std::vector<Teuchos::RCP<Thyra::VectorSpaceBase<ST> const>> vs_array;
   if(j < poissonApp->getNumResponses()) {
     //Poisson model: 
-    vs_array.push_back(Thyra::createVectorSpace<ST, LO, Tpetra_GO, KokkosNode>(
-                poissonApp->getResponse(j)->responseMapT())); 
+    return Thyra::createVectorSpace<ST, LO, Tpetra_GO, KokkosNode>(
+                poissonApp->getResponse(j)->responseMapT()); 
   }
   else {
     //Schrodinger model:  
-    vs_array.push_back(Thyra::createVectorSpace<ST, LO, Tpetra_GO, KokkosNode>(
-                schrodingerApp->getResponse(j - poissonApp->getNumResponses())->responseMapT())); 
+    return Thyra::createVectorSpace<ST, LO, Tpetra_GO, KokkosNode>(
+                schrodingerApp->getResponse(j - poissonApp->getNumResponses())->responseMapT()); 
   }
-  return Thyra::productVectorSpace<ST>(vs_array);
 }
 
 Teuchos::RCP<const Teuchos::Array<std::string> > QCADT::CoupledPoissonSchrodinger::get_p_names(int l) const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   TEUCHOS_TEST_FOR_EXCEPTION(l >= num_param_vecs || l < 0, 
 		     Teuchos::Exceptions::InvalidParameter,
                      std::endl << 
@@ -614,27 +606,18 @@ Teuchos::RCP<const Teuchos::Array<std::string> > QCADT::CoupledPoissonSchrodinge
 Thyra::ModelEvaluatorBase::InArgs<ST>
 QCADT::CoupledPoissonSchrodinger::getNominalValues() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   return nominal_values_;
 }
 
 Thyra::ModelEvaluatorBase::InArgs<ST>
 QCADT::CoupledPoissonSchrodinger::getLowerBounds() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   return Thyra::ModelEvaluatorBase::InArgs<ST>(); // Default value
 }
 
 Thyra::ModelEvaluatorBase::InArgs<ST>
 QCADT::CoupledPoissonSchrodinger::getUpperBounds() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   return Thyra::ModelEvaluatorBase::InArgs<ST>(); // Default value
 }
 
@@ -642,37 +625,30 @@ QCADT::CoupledPoissonSchrodinger::getUpperBounds() const
 Teuchos::RCP<Thyra::LinearOpBase<ST>>
 QCADT::CoupledPoissonSchrodinger::create_W_op() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
-  QCADT::CoupledPSJacobian psJac(nEigenvals, disc_map, 
-                          numDims, valleyDegeneracyFactor, temperature,
-                          length_unit_in_m, energy_unit_in_eV, effMass, offset_to_CB, eigenvals, x_schrodinger, myComm);
-  return psJac.getThyraCoupledJacobian(Jac_Poisson, Jac_Schrodinger, Jac_Schrodinger); 
+  // The blocks wrap the persistent Poisson Jacobian, Hamiltonian and mass matrices,
+  // which evalModel refills in place
+  return psJacobian->getThyraCoupledJacobian(); 
 }
 
 Teuchos::RCP<Thyra::PreconditionerBase<ST>>
 QCADT::CoupledPoissonSchrodinger::create_W_prec() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
-  //Analog of EpetraExt::ModelEvaluator::Preconditioner does not exist
-  //in Thyra yet!  So problem will run for now with no
-  //preconditioner...
-   bool const
-  W_prec_not_supported = true;
-
-  TEUCHOS_TEST_FOR_EXCEPT(W_prec_not_supported);
+#ifdef ALBANY_IFPACK2
+  Teuchos::RCP<Thyra::DefaultPreconditioner<ST>>
+  W_prec = Teuchos::rcp(new Thyra::DefaultPreconditioner<ST>);
+  W_prec->initializeRight(psPreconditioner->getThyraCoupledPreconditioner());
+  return W_prec;
+#else
+  TEUCHOS_TEST_FOR_EXCEPTION(true, std::logic_error,
+      "Error!  QCADT::CoupledPoissonSchrodinger::create_W_prec():  "
+      "the coupled preconditioner requires Ifpack2" << std::endl);
   return Teuchos::null;
+#endif
 }
 
 Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>>
 QCADT::CoupledPoissonSchrodinger::get_W_factory() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   return solver_factory_;
 }
 
@@ -681,9 +657,6 @@ QCADT::CoupledPoissonSchrodinger::reportFinalPoint(
     Thyra::ModelEvaluatorBase::InArgs<ST> const & final_point,
     bool const was_solved)
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   TEUCHOS_TEST_FOR_EXCEPTION(true,
       Teuchos::Exceptions::InvalidParameter,
       "Calling reportFinalPoint in QCAD_CoupledPoissonSchrodinger.cpp" << '\n');
@@ -694,45 +667,13 @@ Teuchos::RCP<Thyra::LinearOpBase<ST>>
 QCADT::CoupledPoissonSchrodinger::
 create_DgDx_op_impl(int j) const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
-  //FIXME, IKT, 5/21/15: save for later. 
-/*  TEUCHOS_TEST_FOR_EXCEPTION(
-    j >= num_response_vecs || j < 0, 
-    Teuchos::Exceptions::InvalidParameter,
-    std::endl << 
-    "Error!  Albany::ModelEvaluator::create_DgDx_op():  " << 
-    "Invalid response index j = " << j << std::endl);
-  
-  if(j < poissonApp->getNumResponses())
-    return poissonApp->getResponse(j)->createGradientOp();
-  else
-    return schrodingerApp->getResponse(j - poissonApp->getNumResponses())->createGradientOp();
-*/
+  // Only scalar responses are supported, and their dg/dx is a multi-vector
   return Teuchos::null;
 }
 
 Teuchos::RCP<Thyra::LinearOpBase<ST>>
 QCADT::CoupledPoissonSchrodinger::create_DgDx_dot_op_impl(int j) const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
-  //FIXME, IKT, 5/21/15: save for later. 
-/*
-  TEUCHOS_TEST_FOR_EXCEPTION(
-    j >= num_response_vecs || j < 0, 
-    Teuchos::Exceptions::InvalidParameter,
-    std::endl << 
-    "Error!  Albany::ModelEvaluator::create_DgDx_dot_op():  " << 
-    "Invalid response index j = " << j << std::endl);
-  
-  if(j < poissonApp->getNumResponses())
-    return poissonApp->getResponse(j)->createGradientOp();
-  else
-    return schrodingerApp->getResponse(j - poissonApp->getNumResponses())->createGradientOp();
-*/
   return Teuchos::null;
 }
 
@@ -740,9 +681,6 @@ Thyra::ModelEvaluatorBase::InArgs<ST>
 QCADT::CoupledPoissonSchrodinger::
 createInArgsImpl() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   Thyra::ModelEvaluatorBase::InArgsSetup<ST> inArgs;
   inArgs.setModelEvalDescription("QCAD Coupled Poisson-Schrodinger Model Evaluator");
 
@@ -762,9 +700,6 @@ createInArgsImpl() const
 Thyra::ModelEvaluatorBase::InArgs<ST>
 QCADT::CoupledPoissonSchrodinger::createInArgs() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
   return this->createInArgsImpl();
 }
 
@@ -772,10 +707,6 @@ QCADT::CoupledPoissonSchrodinger::createInArgs() const
 Thyra::ModelEvaluatorBase::OutArgs<ST> 
 QCADT::CoupledPoissonSchrodinger::createOutArgsImpl() const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
-
   Thyra::ModelEvaluatorBase::OutArgsSetup<ST> outArgs; 
   outArgs.setModelEvalDescription("QCAD Coupled Poisson-Schrodinger Model Evaluator");
 
@@ -785,16 +716,19 @@ QCADT::CoupledPoissonSchrodinger::createOutArgsImpl() const
   // Deterministic
   outArgs.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_f,true);
   outArgs.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_W_op,true);
+#ifdef ALBANY_IFPACK2
+  outArgs.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_W_prec,true);
+#endif
   outArgs.set_W_properties(
       Thyra::ModelEvaluatorBase::DerivativeProperties(
           Thyra::ModelEvaluatorBase::DERIV_LINEARITY_UNKNOWN,
           Thyra::ModelEvaluatorBase::DERIV_RANK_FULL,
           true));
   outArgs.set_Np_Ng(num_param_vecs, n_g);
-/*
- * FIXME, IKT, 5/21/15, save for later
+
   for (int i=0; i<num_param_vecs; i++)
-    outArgs.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_DfDp, i, DerivativeSupport(DERIV_MV_BY_COL));
+    outArgs.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_DfDp, i,
+                        Thyra::ModelEvaluatorBase::DERIV_MV_BY_COL);
   for (int i=0; i<n_g; i++) {
 
     if(i < poissonApp->getNumResponses())
@@ -802,23 +736,15 @@ QCADT::CoupledPoissonSchrodinger::createOutArgsImpl() const
     else
       bScalarResponse = schrodingerApp->getResponse(i - poissonApp->getNumResponses())->isScalarResponse();
 
-    if(bScalarResponse) {
-      outArgs.setSupports(OUT_ARG_DgDx, i,
-                          DerivativeSupport(DERIV_TRANS_MV_BY_ROW));
-      outArgs.setSupports(OUT_ARG_DgDx_dot, i,
-                          DerivativeSupport(DERIV_TRANS_MV_BY_ROW));
-    }
-    else {
-      outArgs.setSupports(OUT_ARG_DgDx, i,
-                          DerivativeSupport(DERIV_LINEAR_OP));
-      outArgs.setSupports(OUT_ARG_DgDx_dot, i,
-                          DerivativeSupport(DERIV_LINEAR_OP));
-    }
+    // dg/dx of a non-scalar response would need a blocked gradient operator, which is not implemented
+    if(bScalarResponse)
+      outArgs.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_DgDx, i,
+                          Thyra::ModelEvaluatorBase::DERIV_TRANS_MV_BY_ROW);
 
     for (int j=0; j<num_param_vecs; j++)
-      outArgs.setSupports(OUT_ARG_DgDp, i, j,
-                          DerivativeSupport(DERIV_MV_BY_COL));
-  }*/
+      outArgs.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_DgDp, i, j,
+                          Thyra::ModelEvaluatorBase::DERIV_MV_BY_COL);
+  }
 
   //Note: no SG support yet...
 
@@ -833,11 +759,6 @@ evalModelImpl(
     Thyra::ModelEvaluatorBase::InArgs<ST> const & in_args,
     Thyra::ModelEvaluatorBase::OutArgs<ST> const & out_args) const
 {
-#ifdef OUTPUT_TO_SCREEN
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
-#endif
-  //?? Teuchos::TimeMonitor Timer(*timer); //start timer
-
   //
   // Get the input arguments
   
@@ -878,30 +799,26 @@ evalModelImpl(
     alpha = in_args.get_alpha();
     beta = in_args.get_beta();
     curr_time  = in_args.get_t();
-    std::cout << "DEBUG: WARNING: x_dot given to CoupledPoissonSchrodinger evalModel!!" << std::endl;
   }
 
   for (int i=0; i<in_args.Np(); i++) {
     Teuchos::RCP<Thyra::ProductVectorBase<ST> const> pT =
-      Teuchos::rcp_dynamic_cast<const Thyra::ProductVectorBase<ST>>(
-         in_args.get_p(i), true);
-    //Teuchos::RCP<const Epetra_Vector> p = inArgs.get_p(i);
+      Teuchos::nonnull(in_args.get_p(i)) ?
+        Teuchos::rcp_dynamic_cast<const Thyra::ProductVectorBase<ST>>(
+           in_args.get_p(i), true) :
+        Teuchos::null;
     if (pT != Teuchos::null) {
+      // each parameter vector space is a product of the single space of the owning application
+      Teuchos::RCP<Tpetra_Vector const> pT_app = Teuchos::rcp_dynamic_cast<const ThyraVector>(
+                                        pT->getVectorBlock(0), true)->getConstTpetraVector();
+      Teuchos::ArrayRCP<ST const> pT_app_constView = pT_app->get1dView();
       if(i < num_poisson_param_vecs) {
-        //get Poisson parameter vector
-        Teuchos::RCP<Tpetra_Vector const> pT_poisson = Teuchos::rcp_dynamic_cast<const ThyraVector>(
-                                          pT->getVectorBlock(0), true)->getConstTpetraVector();
-        Teuchos::ArrayRCP<ST const> pT_poisson_constView = pT_poisson->get1dView();
 	for (unsigned int j=0; j<poisson_sacado_param_vec[i].size(); j++) 
-	  poisson_sacado_param_vec[i][j].baseValue = pT_poisson_constView[j];
+	  poisson_sacado_param_vec[i][j].baseValue = pT_app_constView[j];
       }
       else {
-        //get Schrodinger parameter vector
-        Teuchos::RCP<Tpetra_Vector const> pT_schrodinger = Teuchos::rcp_dynamic_cast<const ThyraVector>(
-                                          pT->getVectorBlock(1), true)->getConstTpetraVector();
-        Teuchos::ArrayRCP<ST const> pT_schrodinger_constView = pT_schrodinger->get1dView();
 	for (unsigned int j=0; j<schrodinger_sacado_param_vec[i-num_poisson_param_vecs].size(); j++)
-	  schrodinger_sacado_param_vec[i-num_poisson_param_vecs][j].baseValue = pT_schrodinger_constView[j];
+	  schrodinger_sacado_param_vec[i-num_poisson_param_vecs][j].baseValue = pT_app_constView[j];
       }
     }
   }
@@ -915,16 +832,16 @@ evalModelImpl(
               out_args.get_f(), true) :
           Teuchos::null;
 
-  Teuchos::RCP<Thyra::LinearOpBase<ST>> W_out = Teuchos::nonnull(out_args.get_W_op()) ?
-                                                    out_args.get_W_op() : Teuchos::null;
+  Teuchos::RCP<Thyra::LinearOpBase<ST>> W_out = out_args.get_W_op();
+
+  Teuchos::RCP<Thyra::PreconditionerBase<ST>> W_prec_out;
+  if (out_args.supports(Thyra::ModelEvaluatorBase::OUT_ARG_W_prec))
+    W_prec_out = out_args.get_W_prec();
 
 
   // Get views into 'x' (and 'xdot'?) vectors to use for separate poisson and schrodinger application object calls
   //
-  int disc_nMyElements = disc_map->getNodeNumElements();
-
   Teuchos::RCP<const Tpetra_Vector> x_poisson, xdot_poisson, eigenvals_dist;
-  Teuchos::RCP<Tpetra_MultiVector> xdot_schrodinger = Teuchos::rcp(new Tpetra_MultiVector(disc_map, nEigenvals));
   
   std::vector<const Tpetra_Vector*> xdot_schrodinger_vec(nEigenvals);
 
@@ -932,13 +849,8 @@ evalModelImpl(
   x_poisson = xTs[0];
 
   //Next nEigenvals models are Schrodinger
-  //IKT, can we accomplish the following with arrayviews?  
-  for (int m=1; m < 1+nEigenvals; ++m) {
-    Teuchos::Array<ST> array(xTs[m]->getMap()->getNodeNumElements());
-    xTs[m]->get1dCopy(array);
-    for (std::size_t i=0; i<xTs[m]->getMap()->getNodeNumElements(); ++i)
-       x_schrodinger->replaceLocalValue(i,m-1,array[i]);
-  }
+  for (int m=1; m < 1+nEigenvals; ++m)
+    x_schrodinger->getVectorNonConst(m-1)->assign(*xTs[m]);
  
   //Last model is eigenvalues
   eigenvals_dist = xTs[1+nEigenvals]; 
@@ -967,7 +879,6 @@ evalModelImpl(
   // Get views into 'f' residual vector to use for separate poisson and schrodinger application object calls
   //
   Teuchos::RCP<Tpetra_Vector> f_poisson, f_norm_local, f_norm_dist; 
-  Teuchos::RCP<Tpetra_MultiVector> f_schrodinger;
   std::vector<Tpetra_Vector*> f_schrodinger_vec(nEigenvals);
 
   if (f_out != Teuchos::null) {
@@ -991,8 +902,6 @@ evalModelImpl(
     for(int i=0; i<nEigenvals; i++) f_schrodinger_vec[i] = NULL;
     f_norm_local = f_norm_dist = Teuchos::null;
   }
-  const Teuchos::ArrayRCP<ST> f_norm_local_nonConstView = f_norm_local->get1dViewNonConst(); 
-  const Teuchos::ArrayRCP<ST> f_norm_dist_nonConstView = f_norm_dist->get1dViewNonConst(); 
  
   // Create an eigendata struct for passing the eigenvectors to the poisson app
   //  -- note that this requires the *overlapped* eigenvectors
@@ -1006,16 +915,10 @@ evalModelImpl(
   Teuchos::RCP<Tpetra_Import> overlap_importer =
     Teuchos::rcp(new Tpetra_Import(disc_map, disc_overlap_map));
 
-  
-    // Overlapped eigenstate vectors
-   //(eigenData->eigenvectorRe)->doImport( *x_schrodinger, *overlap_importer, Tpetra::INSERT );
-   for(int i=0; i<nEigenvals; i++) {
-     Teuchos::RCP<Tpetra_Vector> eigenData_i = (eigenData->eigenvectorRe)->getVectorNonConst(i); 
-     eigenData_i->doImport(*(x_schrodinger->getVector(i)), *overlap_importer, Tpetra::INSERT); 
-     //eigenData_i->putScalar(0.0); //DEBUG - zero out eigenvectors passed to Poisson
-   }
+  // Overlapped eigenstate vectors
+  (eigenData->eigenvectorRe)->doImport( *x_schrodinger, *overlap_importer, Tpetra::INSERT );
 
-    // set eigenvalues / eigenvectors for use in poisson problem:
+  // set eigenvalues / eigenvectors for use in poisson problem:
   poissonApp->getStateMgr().setEigenDataT(eigenData);
 
   // Get overlapped version of potential (x_poisson) for passing as auxData to schrodinger app
@@ -1025,7 +928,6 @@ evalModelImpl(
   Teuchos::RCP<Tpetra_Vector> overlapped_V0 = overlapped_V->getVectorNonConst(0); 
   overlapped_V0->doImport( *x_poisson, *overlap_importer, Tpetra::INSERT);
   overlapped_V0->update(offset_to_CB, *ones_vec, -1.0);
-  //std::cout << "DEBUG: Offset to conduction band = " << offset_to_CB << std::endl;
   // set potential for use in schrodinger problem
   schrodingerApp->getStateMgr().setAuxDataT(overlapped_V);
 
@@ -1036,192 +938,65 @@ evalModelImpl(
   bool f_poisson_already_computed = false;
   std::vector<bool> f_schrodinger_already_computed(nEigenvals, false);
 
-  Teuchos::RCP<Tpetra_CrsMatrix> W_out_poisson_crs; //possibly used by preconditioner, so declare here
-  Teuchos::RCP<Tpetra_CrsMatrix> W_out_schrodinger_crs; //possibly used by preconditioner, so declare here
-
   // Mass Matrix -- needed even if we don't need to compute the Jacobian, since it enters into the normalization equations
   //   --> Compute mass matrix using schrodinger equation -- independent of eigenvector so can just use 0th
   //       Note: to compute this, we need to evaluate the schrodinger problem as a transient problem, so create a dummy xdot...
-  const Teuchos::RCP<Tpetra_Operator> M_out_schrodinger = Teuchos::nonnull(schrodingerModel->create_W_op()) ?
-            ConverterT::getTpetraOperator(schrodingerModel->create_W_op()) :
-            Teuchos::null; //maybe re-use this and not create it every time?
-
-  Teuchos::RCP<Tpetra_CrsMatrix> M_out_schrodinger_crs =   Teuchos::nonnull(M_out_schrodinger) ?
-            Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(M_out_schrodinger, true) :
-            Teuchos::null;
-
   Teuchos::RCP<const Tpetra_Vector> dummy_xdot = 
       ConverterT::getConstTpetraVector(schrodingerModel->getNominalValues().get_x_dot()); 
 
   schrodingerApp->computeGlobalJacobianT(1.0, 0.0, 0.0, curr_time, dummy_xdot.get(), NULL, *x_schrodinger->getVector(0), 
-					    schrodinger_sacado_param_vec, f_schrodinger_vec[0], *M_out_schrodinger_crs);
+					    schrodinger_sacado_param_vec, f_schrodinger_vec[0], *Mass_Schrodinger);
   
   // Hamiltionan Matrix -- needed even if we don't need to compute the Jacobian, since this is how we compute the schrodinger residuals
   //   --> Computed as jacobian matrix of schrodinger equation -- independent of eigenvector so can just use 0th
-  Teuchos::RCP<Tpetra_Operator> const J_out_schrodinger =
-        Teuchos::nonnull(schrodingerModel->create_W_op()) ?
-            ConverterT::getTpetraOperator(schrodingerModel->create_W_op()) :
-            Teuchos::null;
-  Teuchos::RCP<Tpetra_CrsMatrix> J_out_schrodinger_crs =
-        Teuchos::nonnull(J_out_schrodinger) ?
-            Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(J_out_schrodinger, true) :
-            Teuchos::null;
   schrodingerApp->computeGlobalJacobianT(0.0, 1.0, 0.0, curr_time, dummy_xdot.get(), NULL, *x_schrodinger->getVector(0), 
-					    schrodinger_sacado_param_vec, f_schrodinger_vec[0], *J_out_schrodinger_crs);
+					    schrodinger_sacado_param_vec, f_schrodinger_vec[0], *Jac_Schrodinger);
   
   f_schrodinger_already_computed[0] = true; //residual is not affected by alpha & beta, so both of the above calls compute it.
 
-  // W 
-  if (W_out != Teuchos::null) { 
-    // W = alpha*M + beta*J where M is mass mx and J is jacobian
+  // W and its preconditioner
+  if (W_out != Teuchos::null || W_prec_out != Teuchos::null) { 
+    // W = alpha*M + beta*J where M is mass mx and J is jacobian.  The
+    //   normalization equations have no mass term, so only the steady Jacobian is available.
+    TEUCHOS_TEST_FOR_EXCEPTION(alpha != 0.0 || beta != 1.0, Teuchos::Exceptions::InvalidParameter,
+        "Error!  QCADT::CoupledPoissonSchrodinger only computes the steady Jacobian (alpha = 0, beta = 1)" << std::endl);
 
-    //if we need to compute the jacobian, get the jacobians of the poisson and schrodinger
-    //  applications (as crs matrices), as well as the mass matrix (from the schrodinger problem,
-    //  since it includes xdot - maybe need to fabricate this??) and from these construct a CoupledPoissonSchrodingerJacobian object (an Epetra_Operator)
-    
-    //TODO - how to allow general alpha and beta?  This won't work given current logic, so we should test that alpha=0, beta=1 and throw an error otherwise...
+    TEUCHOS_TEST_FOR_EXCEPTION(nEigenvals <= 0, Teuchos::Exceptions::InvalidParameter,"Error! The number of eigenvalues must be greater than zero.");
 
     // Compute poisson Jacobian
-    const Teuchos::RCP<Tpetra_Operator> W_out_poisson = Teuchos::nonnull(poissonModel->create_W_op()) ?
-            ConverterT::getTpetraOperator(poissonModel->create_W_op()) :
-            Teuchos::null; //maybe re-use this and not create it every time? 
-
-    Teuchos::RCP<Tpetra_CrsMatrix> W_out_poisson_crs =   Teuchos::nonnull(W_out_poisson) ?
-            Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(W_out_poisson, true) :
-            Teuchos::null;
-
     poissonApp->computeGlobalJacobianT(alpha, beta, 0.0, curr_time, xdot_poisson.get(), NULL, *x_poisson, 
-				      poisson_sacado_param_vec, f_poisson.get(), *W_out_poisson_crs);
+				      poisson_sacado_param_vec, f_poisson.get(), *Jac_Poisson);
     f_poisson_already_computed = true;
 
-    TEUCHOS_TEST_FOR_EXCEPTION(nEigenvals <= 0, Teuchos::Exceptions::InvalidParameter,"Error! The number of eigenvalues must be greater than zero.");
-      
-    //Compute schrodinger Jacobian using first eigenvector -- independent of eigenvector since Schro. eqn is linear
-    // (test for cases we've already computed above)
-    if(alpha == 1.0 && beta == 0.0)
-      W_out_schrodinger_crs = M_out_schrodinger_crs;
-    else if(alpha == 0.0 && beta == 1.0)
-      W_out_schrodinger_crs = J_out_schrodinger_crs;
-    else {
-      const Teuchos::RCP<Tpetra_Operator> W_out_schrodinger = Teuchos::nonnull(schrodingerModel->create_W_op()) ?
-              ConverterT::getTpetraOperator(schrodingerModel->create_W_op()) :
-              Teuchos::null; //maybe re-use this and not create it every time? 
-      Teuchos::RCP<Tpetra_CrsMatrix> W_out_schrodinger_crs =   Teuchos::nonnull(W_out_schrodinger) ?
-              Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(W_out_schrodinger, true) :
-              Teuchos::null;
-      schrodingerApp->computeGlobalJacobianT(alpha, beta, 0.0, curr_time, xdot_schrodinger_vec[0], NULL, *x_schrodinger->getVector(0), 
-					  schrodinger_sacado_param_vec, f_schrodinger_vec[0], *W_out_schrodinger_crs);
-      f_schrodinger_already_computed[0] = true;
-    }    
-    if (W_out != Teuchos::null) {
-      QCADT::CoupledPSJacobian psJac(nEigenvals, disc_map,
-                          numDims, valleyDegeneracyFactor, temperature,
-                          length_unit_in_m, energy_unit_in_eV, effMass, offset_to_CB, eigenvals, x_schrodinger, myComm);
-      W_out = psJac.getThyraCoupledJacobian(W_out_poisson_crs, W_out_schrodinger_crs, M_out_schrodinger_crs); 
-    } 
-
-    /*
-    // DEBUG --- JACOBIAN TEST -----------------------------------------------------------------------------------------
-     
-    Teuchos::RCP<Epetra_Vector> x_plus_dx = Teuchos::rcp( new Epetra_Vector(*combined_SP_map) );
-    Teuchos::RCP<Epetra_Vector> dx_test = Teuchos::rcp( new Epetra_Vector(*combined_SP_map) );
-    double eps;
-    
-    //Init dx_test
-    Teuchos::RCP<Epetra_Vector> dx_test_poisson, dx_test_eigenvals;
-    Teuchos::RCP<Epetra_MultiVector> dx_test_schrodinger;
-    separateCombinedVector(dx_test, dx_test_poisson, dx_test_schrodinger, dx_test_eigenvals);
-
-    eps = 1e-7;
-    dx_test->PutScalar(1.0);
-    //dx_test_poisson->PutScalar(1.0);
-    //dx_test_schrodinger->PutScalar(1.0);
-    //dx_test_eigenvals->PutScalar(1.0);
-
-    Teuchos::RCP<Epetra_Vector> f_test_manual = Teuchos::rcp( new Epetra_Vector(*combined_SP_map) );
-    Teuchos::RCP<Epetra_Vector> f_test_tmp = Teuchos::rcp( new Epetra_Vector(*combined_SP_map) );
-    Teuchos::RCP<Epetra_Vector> f_test_jac = Teuchos::rcp( new Epetra_Vector(*combined_SP_map) );
-
-    computeResidual(x, f_test_manual, M_out_schrodinger_crs);
-    //f_test_manual->Print( std::cout << "JACOBIAN TEST:  MANUAL 1" << std::endl);
-    x_plus_dx->Update(1.0, *x, eps, *dx_test, 0.0); // x + eps*dx
-    computeResidual(x_plus_dx, f_test_tmp, M_out_schrodinger_crs);
-    //f_test_tmp->Print( std::cout << "JACOBIAN TEST:  MANUAL 2" << std::endl);
-    f_test_manual->Update(1.0/eps, *f_test_tmp, -1.0/eps); // f_test_manual = (resid(x+eps*dx) - resid(x)) / eps ~ jacobian * dx
-
-    W_out_psj->Apply(*dx_test, *f_test_jac);
-
-
-    //x_schrodinger->Print( std::cout << "JACOBIAN TEST:  X_SCHRODINGER" << std::endl);
-    f_test_manual->Print( std::cout << "JACOBIAN TEST:  MANUAL DIFF" << std::endl);
-    f_test_jac->Print( std::cout << "JACOBIAN TEST:  JACOBIAN DIFF" << std::endl);
+    // The Schrodinger Jacobian is the Hamiltonian computed above, since the Schro. eqn is linear
+    if (W_out != Teuchos::null)
+      psJacobian->initialize(eigenvals, x_schrodinger);
 
-    f_test_tmp->Update(1.0, *f_test_manual, -1.0, *f_test_jac, 0.0);
-    f_test_tmp->Print( std::cout << "JACOBIAN TEST:  COMPARISON VECTOR" << std::endl);
-    
-    double test_norm;
-    f_test_tmp->Norm2(&test_norm);
-    std::cout << "JACOBIAN TEST: COMPARISON VECTOR 2-NORM = " << test_norm << std::endl;
-
-    // DEBUG --- JACOBIAN TEST -----------------------------------------------------------------------------------------
-    */
+#ifdef ALBANY_IFPACK2
+    if (W_prec_out != Teuchos::null)
+      psPreconditioner->compute();
+#endif
   }
 
-  //IKT, 5/26/15: removed all preconditioner stuff since we'll be using Teko. 
-
-/*
-  //IKT, FIXME 5/26/15: do dfdp later.
   // df/dp
-  for (int i=0; i<outArgs.Np(); i++) {
-    Teuchos::RCP<Epetra_MultiVector> dfdp_out = 
-      outArgs.get_DfDp(i).getMultiVector();
-    if (dfdp_out != Teuchos::null) {
-
+  for (int i=0; i<out_args.Np(); i++) {
+    Teuchos::RCP<Thyra::MultiVectorBase<ST>> dfdp_mv = out_args.get_DfDp(i).getMultiVector();
+    if (dfdp_mv != Teuchos::null) {
+      Teuchos::RCP<Thyra::ProductMultiVectorBase<ST>> dfdp_out =
+        Teuchos::rcp_dynamic_cast<Thyra::ProductMultiVectorBase<ST>>(dfdp_mv, true);
 
-      // Get views into dfdp_out vectors for poisson and schrodinger parts
       //  Note that df/dp will be zero for parts of f corresponding to an app
       //    different from the one owning the p vector.  E.g. if i==0 corresponds
       //    to p being a poisson parameter vector then df/dp == 0 for all the schrodinger
       //    parts of f.
+      Thyra::assign(dfdp_mv.ptr(), 0.0);
 
-      int nParamComponents = dfdp_out->NumVectors();
-      Teuchos::RCP<Epetra_MultiVector> dfdp_poisson;
-      std::vector< Teuchos::RCP<Epetra_MultiVector> > dfdp_schrodinger(nEigenvals);
-
-      double *dfdp_data; int myLDA;
-      if(dfdp_out->ExtractView(&dfdp_data, &myLDA) != 0) 
-	TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter,
-				   "Error!  QCADT::CoupledPoissonSchrodinger -- cannot extract dgdp vector view");
-
-      dfdp_poisson = Teuchos::rcp(new Epetra_MultiVector(::View, *disc_map, &(dfdp_data[0]), myLDA, nParamComponents));
-      for(int k=0; k<nEigenvals; k++)
-	dfdp_schrodinger[k] = Teuchos::rcp(new Epetra_MultiVector(::View, *disc_map, &(dfdp_data[(k+1)*disc_nMyElements]), myLDA, nParamComponents));
-
-      // Assemble p_vec
-      Teuchos::Array<int> p_indexes = 
-        outArgs.get_DfDp(i).getDerivativeMultiVector().getParamIndexes();
-      Teuchos::RCP<ParamVec> p_vec;
-
-      Teuchos::Array<ParamVec>& sacado_param_vec = 
-	(i < num_poisson_param_vecs) ? poisson_sacado_param_vec : schrodinger_sacado_param_vec;
-      int offset = (i < num_poisson_param_vecs) ? 0 : num_poisson_param_vecs;
-
-      if (p_indexes.size() == 0)
-        p_vec = Teuchos::rcp(&sacado_param_vec[i-offset],false);
-      else {
-        p_vec = Teuchos::rcp(new ParamVec);
-        for (int j=0; j<p_indexes.size(); j++)
-          p_vec->addParam(sacado_param_vec[i-offset][p_indexes[j]].family, 
-                          sacado_param_vec[i-offset][p_indexes[j]].baseValue);
-      }
-
-      dfdp_out->PutScalar(0.0);
-
-      // Compute full dfdp by computing non-zero parts and leaving zeros in others
       if (i < num_poisson_param_vecs) {
 	// "Poisson-owned" param vector, so only poisson part of dfdp vector can be nonzero
-	poissonApp->computeGlobalTangent(0.0, 0.0, 0.0, curr_time, false, xdot_poisson.get(), NULL, *x_poisson, 
-				  poisson_sacado_param_vec, p_vec.get(),
+        Teuchos::RCP<Tpetra_MultiVector> dfdp_poisson =
+          ConverterT::getTpetraMultiVector(dfdp_out->getNonconstMultiVectorBlock(0));
+	poissonApp->computeGlobalTangentT(0.0, 0.0, 0.0, curr_time, false, xdot_poisson.get(), NULL, *x_poisson, 
+				  poisson_sacado_param_vec, &poisson_sacado_param_vec[i],
 				  NULL, NULL, NULL, NULL, f_poisson.get(), NULL, 
 				  dfdp_poisson.get());
 
@@ -1230,27 +1005,18 @@ evalModelImpl(
       else {
 	// "Schrodinger-owned" param vector, so only schrodinger parts of dfdp vector can be nonzero
 	for(int k=0; k<nEigenvals; k++) {
-	  schrodingerApp->computeGlobalTangent(0.0, 0.0, 0.0, curr_time, false, xdot_schrodinger_vec[k], NULL, *((*x_schrodinger)(k)),
-					       schrodinger_sacado_param_vec, p_vec.get(),
-					       NULL, NULL, NULL, NULL, f_schrodinger_vec[k], NULL, 
-					       dfdp_schrodinger[k].get());	
-	  f_schrodinger_already_computed[k]=true;
+          Teuchos::RCP<Tpetra_MultiVector> dfdp_schrodinger =
+            ConverterT::getTpetraMultiVector(dfdp_out->getNonconstMultiVectorBlock(1+k));
+	  schrodingerApp->computeGlobalTangentT(0.0, 0.0, 0.0, curr_time, false, xdot_schrodinger_vec[k], NULL, *x_schrodinger->getVector(k),
+					       schrodinger_sacado_param_vec, &schrodinger_sacado_param_vec[i-num_poisson_param_vecs],
+					       NULL, NULL, NULL, NULL, NULL, NULL, 
+					       dfdp_schrodinger.get());	
 	}
       }
     }
   }
-*/
+
   // f
-  /*if (app->is_adjoint) {  //TODO: support Adjoints?
-    TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter,
-				   "Error!  QCADT::CoupledPoissonSchrodinger -- adjoints not implemented yet");
-    Derivative f_deriv(ut, DERIV_TRANS_MV_BY_ROW);
-    int response_index = 0; // need to add capability for sending this in
-    app->evaluateResponseDerivative(response_index, curr_time, x_dot.get(), *x, 
-				    sacado_param_vec, NULL, 
-				    NULL, f_deriv, Derivative(), Derivative());
-  }
-  else {  */
     if (f_out != Teuchos::null) { 
       Teuchos::RCP<Tpetra_Vector> M_vec = Teuchos::rcp(new Tpetra_Vector(disc_map));  
       //temp storage for mass matrix times vec -- maybe don't allocate this on the stack??
@@ -1260,72 +1026,40 @@ evalModelImpl(
 					  poisson_sacado_param_vec, *f_poisson);
       }
       
+      const Teuchos::ArrayRCP<ST> f_norm_local_nonConstView = f_norm_local->get1dViewNonConst(); 
       for(int i=0; i<nEigenvals; i++) {
 
 	// Compute Mass_matrix * eigenvector[i]
 	const Tpetra_Vector& vec = *x_schrodinger->getVector(i);
-	M_out_schrodinger_crs->apply(vec, *M_vec, Teuchos::NO_TRANS, 1.0, 0.0);  
+	Mass_Schrodinger->apply(vec, *M_vec, Teuchos::NO_TRANS, 1.0, 0.0);  
 
 
 	// Compute the schrodinger residual f_schrodinger_vec[i]: H*eigenvector[i] - eigenvalue[i] * M * eigenvector[i]
 
 	if(!f_schrodinger_already_computed[i]) {
-
-  	  //Could call this, but multiply below is faster
-	  //schrodingerApp->computeGlobalResidual(curr_time, xdot_schrodinger_vec[i], *((*x_schrodinger)(i)), 
-	  //				      schrodinger_sacado_param_vec, *(f_schrodinger_vec[i]) );  // H*evec[i] 
-
 	  // H * Psi - E * M * Psi
-	  const Tpetra_CrsMatrix& Hamiltonian_crs =  *J_out_schrodinger_crs;
-	   Hamiltonian_crs.apply(vec, *f_schrodinger_vec[i], Teuchos::NO_TRANS, 1.0, 0.0);
+	  Jac_Schrodinger->apply(vec, *f_schrodinger_vec[i], Teuchos::NO_TRANS, 1.0, 0.0);
 	}
-	/* ---- DEBUG ----
-	   double He_norm, Me_norm, H_expect;
-	   f_schrodinger_vec[i]->Norm2(&He_norm);
-	   M_vec.Norm2(&Me_norm);
-	   std::cout << "DEBUG " << i << ": norm(-H*evec) = " << He_norm << ", norm(M*evec) = " << Me_norm 
-	   << ", eval = " << (*stdvec_eigenvals)[i] << std::endl;
-	   f_schrodinger_vec[i]->Dot(vec, &H_expect);
-	*/
 
 	// add -eval[i]*M*evec[i] to H*evec[i] (recall evals are really negative_evals)
 	double eval = (*stdvec_eigenvals)[i];
 	f_schrodinger_vec[i]->update( eval, *M_vec, 1.0); 
 
         // Compute normalization equation residuals:  f_norm[i] = abs(1 - evec[i] . M . evec[i])
-	ST vec_M_vec;
-        const Teuchos::ArrayView<ST> vec_M_vec_AV = Teuchos::arrayView(&vec_M_vec, 1);
-	vec.dot( *M_vec, vec_M_vec_AV );
-	f_norm_local_nonConstView[i] = 1.0 - vec_M_vec;
-
+	f_norm_local_nonConstView[i] = 1.0 - vec.dot(*M_vec);
       }
 
       // Fill elements of f_norm_dist that belong to this processor, i.e. loop over
       // eigenvalue indices "owned" by the current proc in the combined distributed map
-      std::vector<int> eval_global_elements(my_nEigenvals_);
-      eval_global_elements[0] = dist_eigenval_map->getGlobalNumElements();
+      const Teuchos::ArrayRCP<ST> f_norm_dist_nonConstView = f_norm_dist->get1dViewNonConst(); 
+      Teuchos::ArrayView<const Tpetra_GO> eval_global_elements = dist_eigenval_map->getNodeElementList();
       for(int i=0; i<my_nEigenvals_; i++)
 	f_norm_dist_nonConstView[i] = f_norm_local_nonConstView[eval_global_elements[i]];
       
-      
-
-      //DEBUG -- print residual in gory detail for debugging
-      if(1) {
-	if(myComm->getRank() == 0) std::cout << "DEBUG: ----------------- Coupled Schrodinger Poisson Info Dump ---------------------" << std::endl;
+      if(bVerbose) {
+	if(myComm->getRank() == 0) std::cout << "----------------- Coupled Schrodinger Poisson Info Dump ---------------------" << std::endl;
 	double norm, mean;
 
-	/*std::cout << "x map has " << x->Map().NumGlobalElements() << " global els" << std::endl;
-	  std::cout << "x_poisson map has " << x_poisson->Map().NumGlobalElements() << " global els" << std::endl;
-	  std::cout << "x_schrodinger map has " << x_schrodinger->Map().NumGlobalElements() << " global els (each vec)" << std::endl;
-	  std::cout << "dist_eval_map has " << dist_eigenval_map.NumGlobalElements() << " global els" << std::endl;
-	*/
-
-       //IKT, 5/26/15, FIXME: 
-       //The following is not defined for product vectors
-       /*norm = x->norm2(); mean = x->meanValue();
-	std::cout << std::setprecision(10);
-	if(myComm->getRank() == 0) std::cout << "X Norm & Mean = " << norm << " , " << mean << std::endl;*/
-	
 	norm = x_poisson->norm2(); mean = x_poisson->meanValue();
 	if(myComm->getRank() == 0) std::cout << "Poisson-part X Norm & Mean = " << norm << " , " << mean << std::endl;
 	for(int i=0; i<nEigenvals; i++) {
@@ -1336,147 +1070,97 @@ evalModelImpl(
 	  if(myComm->getRank() == 0) std::cout << "Eigenvalue[" << i << "] = " << (*stdvec_eigenvals)[i] << std::endl;
 	
 	norm = f_poisson->norm2();
-	if(myComm->getRank() == 0) std::cout << "Poisson-part Residual Norm = " << norm << std::endl; //f_poisson->Print(std::cout);
+	if(myComm->getRank() == 0) std::cout << "Poisson-part Residual Norm = " << norm << std::endl;
 	for(int i=0; i<nEigenvals; i++) {
-	  if(f_schrodinger_vec[i] != NULL) {
-	    norm = f_schrodinger_vec[i]->norm2();
-	    if(myComm->getRank() == 0) std::cout << "Schrodinger[" << i << "]-part Residual Norm = " << norm << std::endl; //f_schrodinger_vec[i]->Print(std::cout);
-	  }
+	  norm = f_schrodinger_vec[i]->norm2();
+	  if(myComm->getRank() == 0) std::cout << "Schrodinger[" << i << "]-part Residual Norm = " << norm << std::endl;
 	}
-	if(myComm->getRank() == 0) std::cout << "Eigenvalue-part Residual: " << std::endl;
-	f_norm_dist->print(std::cout); // only rank 0 prints
+	for(int i=0; i<nEigenvals; i++) 
+	  if(myComm->getRank() == 0) std::cout << "Eigenvalue-part Residual[" << i << "] = " << f_norm_local_nonConstView[i] << std::endl;
       } 
     }
+
   // Response functions
   for (int i=0; i<out_args.Ng(); i++) {
-   Teuchos::RCP<Thyra::ProductVectorBase<ST>>
-    g_out = Teuchos::nonnull(out_args.get_g(i)) ?
-          Teuchos::rcp_dynamic_cast<Thyra::ProductVectorBase<ST>>(
-              out_args.get_g(i), true) :
-          Teuchos::null;
-   
-    bool g_computed = false;
-  // IKT, FIXME, 5/26/15: hold of conversion for now of dg/dx, dg/dp.
-/*
-    Derivative dgdx_out = outArgs.get_DgDx(i);
-    Derivative dgdxdot_out = outArgs.get_DgDx_dot(i);
-        
-    //IK, 10/9/14
-    //convert g_out to Tpetra for evaluateResponseTangentT calls
-    Teuchos::RCP<const Teuchos_Comm> commT = Albany::createTeuchosCommFromEpetraComm(commE);
-    Teuchos::RCP<Tpetra_Vector> g_outT; 
-    if (g_out != Teuchos::null) 
-      g_outT = Petra::EpetraVector_To_TpetraVectorNonConst(*g_out, commT); 
-    //convert xdot_poisson and x_poisson to Tpetra  
-    Teuchos::RCP<const Tpetra_Vector> x_poissonT, xdot_poissonT; 
-    if (x_poisson != Teuchos::null) 
-      x_poissonT  = Petra::EpetraVector_To_TpetraVectorConst(*x_poisson, commT); 
-    if (xdot_poisson != Teuchos::null)  
-      xdot_poissonT = Petra::EpetraVector_To_TpetraVectorConst(*xdot_poisson, commT);
-    //convert xdot_schrodinger and x_schrodinger to Tpetra  
-    Teuchos::RCP<const Tpetra_Vector> x_schrodingerT, xdot_schrodingerT; 
-    if (x_schrodinger != Teuchos::null) 
-      x_schrodingerT  = Petra::EpetraVector_To_TpetraVectorConst(*((*x_schrodinger)(0)), commT); 
-    if (xdot_schrodinger != Teuchos::null)
-      xdot_schrodingerT  = Petra::EpetraVector_To_TpetraVectorConst(*xdot_schrodinger_vec[0], commT); 
-
-    // dg/dx, dg/dxdot
-    if (!dgdx_out.isEmpty() || !dgdxdot_out.isEmpty()) {
-      if(i < poissonApp->getNumResponses()) {
-	poissonApp->evaluateResponseDerivative(i, curr_time, xdot_poisson.get(), NULL, *(x_poisson),
+    Teuchos::RCP<Tpetra_Vector> g_out =
+      Teuchos::nonnull(out_args.get_g(i)) ?
+        ConverterT::getTpetraVector(out_args.get_g(i)) :
+        Teuchos::null;
+
+    bool bPoissonResponse = (i < poissonApp->getNumResponses());
+    int app_response_index = bPoissonResponse ? i : i - poissonApp->getNumResponses();
+
+    // dg/dx
+    Teuchos::RCP<Thyra::MultiVectorBase<ST>> dgdx_mv = out_args.get_DgDx(i).getMultiVector();
+    if (dgdx_mv != Teuchos::null) {
+      Teuchos::RCP<Thyra::ProductMultiVectorBase<ST>> dgdx_out =
+        Teuchos::rcp_dynamic_cast<Thyra::ProductMultiVectorBase<ST>>(dgdx_mv, true);
+      // Each response depends on the solution of its own application only, so
+      //   only the Poisson block or the first Schrodinger block is nonzero
+      Thyra::assign(dgdx_mv.ptr(), 0.0);
+      const Thyra::ModelEvaluatorBase::Derivative<ST> dummy_deriv;
+      if(bPoissonResponse) {
+        const Thyra::ModelEvaluatorBase::Derivative<ST> dgdx_poisson(
+            dgdx_out->getNonconstMultiVectorBlock(0), Thyra::ModelEvaluatorBase::DERIV_TRANS_MV_BY_ROW);
+	poissonApp->evaluateResponseDerivativeT(app_response_index, curr_time, xdot_poisson.get(), NULL, *x_poisson,
                                       poisson_sacado_param_vec, NULL,
-                                      g_out.get(), dgdx_out,
-                                      dgdxdot_out, Derivative(), Derivative());
+                                      g_out.get(), dgdx_poisson,
+                                      dummy_deriv, dummy_deriv, dummy_deriv);
       }
       else {
 	// take response derivatives using lowest eigenstate only (is there something better??)
-	schrodingerApp->evaluateResponseDerivative(i - poissonApp->getNumResponses(), curr_time, xdot_schrodinger_vec[0], NULL,
-                                      *((*x_schrodinger)(0)),
+        const Thyra::ModelEvaluatorBase::Derivative<ST> dgdx_schrodinger(
+            dgdx_out->getNonconstMultiVectorBlock(1), Thyra::ModelEvaluatorBase::DERIV_TRANS_MV_BY_ROW);
+	schrodingerApp->evaluateResponseDerivativeT(app_response_index, curr_time, xdot_schrodinger_vec[0], NULL,
+                                      *x_schrodinger->getVector(0),
                                       schrodinger_sacado_param_vec, NULL,
-                                      g_out.get(), dgdx_out,
-                                      dgdxdot_out, Derivative(), Derivative());
+                                      g_out.get(), dgdx_schrodinger,
+                                      dummy_deriv, dummy_deriv, dummy_deriv);
       }
-      g_computed = true;
+      // Set g_out to null to indicate that g_out was evaluated.
+      g_out = Teuchos::null;
     }
 
     // dg/dp
-    for (int j=0; j<outArgs.Np(); j++) {
-      Teuchos::RCP<Epetra_MultiVector> dgdp_out =
-        outArgs.get_DgDp(i,j).getMultiVector();
+    for (int j=0; j<out_args.Np(); j++) {
+      Teuchos::RCP<Tpetra_MultiVector> dgdp_out =
+        Teuchos::nonnull(out_args.get_DgDp(i,j).getMultiVector()) ?
+          ConverterT::getTpetraMultiVector(out_args.get_DgDp(i,j).getMultiVector()) :
+          Teuchos::null;
       if (dgdp_out != Teuchos::null) {
-        Teuchos::Array<int> p_indexes =
-          outArgs.get_DgDp(i,j).getDerivativeMultiVector().getParamIndexes();
-
-        Teuchos::RCP<ParamVec> p_vec;
-
-	Teuchos::Array<ParamVec>& sacado_param_vec = 
-	  (j < num_poisson_param_vecs) ? poisson_sacado_param_vec : schrodinger_sacado_param_vec;
-	int offset = (j < num_poisson_param_vecs) ? 0 : num_poisson_param_vecs;
-
-        if (p_indexes.size() == 0)
-          p_vec = Teuchos::rcp(&sacado_param_vec[j-offset],false);
-        else {
-          p_vec = Teuchos::rcp(new ParamVec);
-          for (int k=0; k<p_indexes.size(); k++)
-            p_vec->addParam(sacado_param_vec[j-offset][p_indexes[k]].family,
-                            sacado_param_vec[j-offset][p_indexes[k]].baseValue);
-        }
-       //IK, 10/9/14: converg dgdp_out to Tpetra            
-       Teuchos::RCP<Tpetra_MultiVector> dgdp_outT;
-       if (dgdp_out != Teuchos::null) 
-        dgdp_outT = Petra::EpetraMultiVector_To_TpetraMultiVector(*dgdp_out, commT); 
-
-	if(i < poissonApp->getNumResponses() && j < num_poisson_param_vecs) {
+	if(bPoissonResponse && j < num_poisson_param_vecs) {
 	  //both response and param vectors belong to poisson problem
-	  poissonApp->evaluateResponseTangentT(i, alpha, beta, 0.0, curr_time, false,
-					      xdot_poissonT.get(), NULL, *x_poissonT,
-					      poisson_sacado_param_vec, p_vec.get(),
-					      NULL, NULL, NULL, NULL, g_outT.get(), NULL,
-					      dgdp_outT.get());
-          //convert g_outT to Epetra_Vector g_out
-          Petra::TpetraVector_To_EpetraVector(g_outT, *g_out, commE); 	
-          //convert dgdp_outT to Epetra_MultiVector dgdp_out
-          Petra::TpetraMultiVector_To_EpetraMultiVector(dgdp_outT, *dgdp_out, commE); 	
+	  poissonApp->evaluateResponseTangentT(app_response_index, alpha, beta, 0.0, curr_time, false,
+					      xdot_poisson.get(), NULL, *x_poisson,
+					      poisson_sacado_param_vec, &poisson_sacado_param_vec[j],
+					      NULL, NULL, NULL, NULL, g_out.get(), NULL,
+					      dgdp_out.get());
+          g_out = Teuchos::null;
 	}
-	else if(i >= poissonApp->getNumResponses() && j >= num_poisson_param_vecs) {
+	else if(!bPoissonResponse && j >= num_poisson_param_vecs) {
 	  //both response and param vectors belong to schrodinger problem -- evaluate dg/dp using first eigenvector
-	  schrodingerApp->evaluateResponseTangentT(i - poissonApp->getNumResponses(), alpha, beta, 0.0, curr_time, false,
-						  xdot_schrodingerT.get(), NULL, *x_schrodingerT,
-						  schrodinger_sacado_param_vec, p_vec.get(),
-						  NULL, NULL, NULL, NULL, g_outT.get(), NULL,
-						  dgdp_outT.get());
-          //convert g_outT to Epetra_Vector g_out
-          Petra::TpetraVector_To_EpetraVector(g_outT, *g_out, commE); 	
-          //convert dgdp_outT to Epetra_MultiVector dgdp_out
-          Petra::TpetraMultiVector_To_EpetraMultiVector(dgdp_outT, *dgdp_out, commE); 	
+	  schrodingerApp->evaluateResponseTangentT(app_response_index, alpha, beta, 0.0, curr_time, false,
+						  xdot_schrodinger_vec[0], NULL, *x_schrodinger->getVector(0),
+						  schrodinger_sacado_param_vec, &schrodinger_sacado_param_vec[j-num_poisson_param_vecs],
+						  NULL, NULL, NULL, NULL, g_out.get(), NULL,
+						  dgdp_out.get());
+          g_out = Teuchos::null;
 	}
 	else {
 	  // response and param vectors belong to different sub-problems (Poisson or Schrodinger)
-	  dgdp_out->PutScalar(0.0);
+	  dgdp_out->putScalar(0.0);
 	}
-
-        g_computed = true;
       }
     }
-    */
-    if (g_out != Teuchos::null && !g_computed) {
-      //Poisson model:
-      Teuchos::RCP<Tpetra_Vector>
-        g_out_poisson = Teuchos::rcp_dynamic_cast<ThyraVector>(
-                  g_out->getNonconstVectorBlock(0),
-                  true)->getTpetraVector();
-      //Schrodinger model:
-      Teuchos::RCP<Tpetra_Vector>
-        g_out_schrodinger = Teuchos::rcp_dynamic_cast<ThyraVector>(
-                  g_out->getNonconstVectorBlock(1),
-                  true)->getTpetraVector();
-      if(i < poissonApp->getNumResponses()) {
-	poissonApp->evaluateResponseT(i, curr_time, xdot_poisson.get(), NULL, *x_poisson,
-				     poisson_sacado_param_vec, *g_out_poisson);
+
+    if (g_out != Teuchos::null) {
+      if(bPoissonResponse) {
+	poissonApp->evaluateResponseT(app_response_index, curr_time, xdot_poisson.get(), NULL, *x_poisson,
+				     poisson_sacado_param_vec, *g_out);
       }
       else {
-	schrodingerApp->evaluateResponseT(i - poissonApp->getNumResponses(), curr_time, xdot_schrodinger->getVector(0).get(), NULL, 
-                                         *x_schrodinger->getVector(0), schrodinger_sacado_param_vec, *g_out_schrodinger);
+	schrodingerApp->evaluateResponseT(app_response_index, curr_time, xdot_schrodinger_vec[0], NULL, 
+                                         *x_schrodinger->getVector(0), schrodinger_sacado_param_vec, *g_out);
       }
     }
 
@@ -1486,14 +1170,12 @@ evalModelImpl(
 Teuchos::RCP<Albany::Application>
 QCADT::CoupledPoissonSchrodinger::getPoissonApp() const
 {
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
   return poissonApp;
 }
 
 Teuchos::RCP<Albany::Application>
 QCADT::CoupledPoissonSchrodinger::getSchrodingerApp() const
 {
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
   return schrodingerApp;
 }
 
@@ -1572,7 +1254,6 @@ void QCADT::CoupledPoissonSchrodinger::separateCombinedVector(const Teuchos::RCP
 Teuchos::RCP<const Teuchos::ParameterList>
 QCADT::CoupledPoissonSchrodinger::getValidAppParameters() const
 {  
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
   Teuchos::RCP<Teuchos::ParameterList> validPL = Teuchos::rcp(new Teuchos::ParameterList("ValidAppParams"));;
   validPL->sublist("Problem",            false, "Problem sublist");
   validPL->sublist("Debug Output",       false, "Debug Output sublist");
@@ -1589,7 +1270,6 @@ QCADT::CoupledPoissonSchrodinger::getValidAppParameters() const
 Teuchos::RCP<const Teuchos::ParameterList>
 QCADT::CoupledPoissonSchrodinger::getValidProblemParameters() const
 {
-  std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
   Teuchos::RCP<Teuchos::ParameterList> validPL = Teuchos::createParameterList("ValidPoissonSchrodingerProblemParams");
 
   validPL->set<std::string>("Name", "", "String to designate Problem Class");
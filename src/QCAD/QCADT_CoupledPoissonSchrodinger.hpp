@@ -18,6 +18,10 @@
 
 #include "Albany_MaterialDatabase.hpp"
 #include "Petra_Converters.hpp"
+#include "QCADT_CoupledPSJacobian.hpp"
+#ifdef ALBANY_IFPACK2
+#include "QCADT_CoupledPSPreconditioner.hpp"
+#endif
 
 #include "Thyra_DefaultProductVector.hpp"
 #include "Thyra_DefaultProductVectorSpace.hpp"
@@ -129,12 +133,18 @@ namespace QCADT {
     Teuchos::RCP<const Tpetra_Map> local_eigenval_map;
     Teuchos::RCP<Tpetra_Vector> eigenvals;
     Teuchos::RCP<Tpetra_MultiVector> x_schrodinger;
-    Teuchos::RCP<Tpetra_Map> combined_SP_map;
     Teuchos::RCP<const Tpetra_Vector> saved_initial_guess;
     Thyra::ModelEvaluatorBase::InArgs<ST> nominal_values_; 
 
     Teuchos::RCP<Tpetra_CrsMatrix> Jac_Poisson; 
     Teuchos::RCP<Tpetra_CrsMatrix> Jac_Schrodinger; 
+    Teuchos::RCP<Tpetra_CrsMatrix> Mass_Schrodinger; 
+
+    //! Coupled Jacobian and block preconditioner, wrapping the matrices above
+    Teuchos::RCP<QCADT::CoupledPSJacobian> psJacobian;
+#ifdef ALBANY_IFPACK2
+    Teuchos::RCP<QCADT::CoupledPSPreconditioner> psPreconditioner;
+#endif
 
     //for setting get_W_factory() 
     Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<ST> const> solver_factory_;
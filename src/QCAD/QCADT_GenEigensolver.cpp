@@ -0,0 +1,319 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "QCADT_GenEigensolver.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+#include "Teuchos_TestForException.hpp"
+#include "Teuchos_VerboseObject.hpp"
+#include "Thyra_LinearOpWithSolveBase.hpp"
+#include "Thyra_TpetraLinearOp.hpp"
+#include "Thyra_TpetraMultiVector.hpp"
+
+#include "Albany_EigendataInfoStructT.hpp"
+
+#include "AnasaziConfigDefs.hpp"
+#include "AnasaziBasicEigenproblem.hpp"
+#include "AnasaziLOBPCGSolMgr.hpp"
+#include "AnasaziBlockKrylovSchurSolMgr.hpp"
+#include "AnasaziBasicOutputManager.hpp"
+#include "AnasaziTpetraAdapter.hpp"
+
+
+namespace {
+
+// Y = alpha * (K - sigma M)^{-1} M X + beta * Y, where A = K - sigma M is
+//  solved with a Stratimikos linear solver (and its preconditioner)
+class ShiftInvertOperator : public Tpetra_Operator {
+public:
+  ShiftInvertOperator(const Teuchos::RCP<Tpetra_CrsMatrix>& A_,
+		      const Teuchos::RCP<Tpetra_CrsMatrix>& M_,
+		      const Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<ST> >& lowsFactory) :
+    A(A_), M(M_)
+  {
+    Teuchos::RCP<const Thyra::LinearOpBase<ST> > A_op =
+      Thyra::createConstLinearOp<ST, LO, Tpetra_GO, KokkosNode>(A);
+    nsA = lowsFactory->createOp();
+    Thyra::initializeOp<ST>(*lowsFactory, A_op, nsA.ptr());
+  }
+
+  Teuchos::RCP<const Tpetra_Map> getDomainMap() const { return M->getDomainMap(); }
+  Teuchos::RCP<const Tpetra_Map> getRangeMap() const { return A->getDomainMap(); }
+
+  void apply(const Tpetra_MultiVector& X, Tpetra_MultiVector& Y,
+	     Teuchos::ETransp mode = Teuchos::NO_TRANS,
+	     ST alpha = Teuchos::ScalarTraits<ST>::one(),
+	     ST beta = Teuchos::ScalarTraits<ST>::zero()) const
+  {
+    TEUCHOS_TEST_FOR_EXCEPTION(mode != Teuchos::NO_TRANS, std::logic_error,
+      "Error! QCADT::GenEigensolver: shift-invert operator cannot be transposed.\n");
+
+    const Teuchos::RCP<Tpetra_MultiVector> MX =
+      Teuchos::rcp(new Tpetra_MultiVector(M->getRangeMap(), X.getNumVectors()));
+    const Teuchos::RCP<Tpetra_MultiVector> Z =
+      Teuchos::rcp(new Tpetra_MultiVector(A->getDomainMap(), X.getNumVectors()));
+    M->apply(X, *MX);
+
+    const Teuchos::RCP<Thyra::MultiVectorBase<ST> >
+      b = Thyra::createMultiVector<ST, LO, Tpetra_GO, KokkosNode>(MX),
+      z = Thyra::createMultiVector<ST, LO, Tpetra_GO, KokkosNode>(Z);
+    Thyra::solve<ST>(*nsA, Thyra::NOTRANS, *b, z.ptr());
+
+    Y.update(alpha, *Z, beta);
+  }
+
+private:
+  Teuchos::RCP<Tpetra_CrsMatrix> A, M;
+  Teuchos::RCP<Thyra::LinearOpWithSolveBase<ST> > nsA;
+};
+
+}
+
+
+QCADT::GenEigensolver::
+GenEigensolver(const Teuchos::RCP<Teuchos::ParameterList>& eigensolveParams,
+	       const Teuchos::RCP<Albany::Application>& app_,
+	       const Teuchos::RCP<Teuchos::ParameterList>& appParams,
+	       const Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<ST> >& lowsFactory_) :
+  app(app_),
+  lowsFactory(lowsFactory_)
+{
+  model = Teuchos::rcp(new Albany::ModelEvaluatorT(app, appParams));
+  model_num_g = model->Ng();
+
+  bHermitian = eigensolveParams->get<bool>("Symmetric",true);
+  nev = eigensolveParams->get<int>("Num Eigenvalues",10);
+  blockSize = eigensolveParams->get<int>("Block Size",5);
+  maxIters = eigensolveParams->get<int>("Maximum Iterations",500);
+  conv_tol = eigensolveParams->get<double>("Convergece Tolerance",1.0e-8);
+  bWarmStart = eigensolveParams->get<bool>("Warm Start",true);
+
+  // Same keys as the LOCA eigensolver list this one lives in
+  const std::string op = eigensolveParams->get<std::string>("Operator","Jacobian Inverse");
+  bShiftInvert = (op == "Shift-Invert");
+  shift = eigensolveParams->get<double>("Shift",0.0);
+  numBlocks = eigensolveParams->get<int>("Num Blocks",30);
+  maxRestarts = eigensolveParams->get<int>("Maximum Restarts",1);
+  TEUCHOS_TEST_FOR_EXCEPTION(bShiftInvert && lowsFactory == Teuchos::null, std::logic_error,
+    "Error! QCADT::GenEigensolver: Shift-Invert requires a linear solver factory.\n");
+
+  x = ConverterT::getConstTpetraVector(model->getNominalValues().get_x());
+  x_dot = Teuchos::rcp(new Tpetra_Vector(x->getMap(), true));
+}
+
+QCADT::GenEigensolver::~GenEigensolver()
+{
+}
+
+
+Teuchos::RCP<const Thyra::VectorSpaceBase<ST> >
+QCADT::GenEigensolver::get_p_space(int l) const
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter,
+    "Error in QCADT::GenEigensolver::get_p_space(): parameters are not supported.\n");
+  return Teuchos::null;
+}
+
+Teuchos::RCP<const Thyra::VectorSpaceBase<ST> >
+QCADT::GenEigensolver::get_g_space(int j) const
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(j > model_num_g || j < 0, Teuchos::Exceptions::InvalidParameter,
+    "Error in QCADT::GenEigensolver::get_g_space(): Invalid response index j = " << j << "\n");
+  if (j == model_num_g) return model->get_x_space(); //last response vector is solution (same map as x)
+  else return model->get_g_space(j);
+}
+
+Thyra::ModelEvaluatorBase::InArgs<ST>
+QCADT::GenEigensolver::createInArgs() const
+{
+  Thyra::ModelEvaluatorBase::InArgsSetup<ST> inArgs;
+  inArgs.setModelEvalDescription("QCADT Generalized Eigensolver Model Evaluator");
+  inArgs.set_Np(0);
+  return inArgs;
+}
+
+Thyra::ModelEvaluatorBase::OutArgs<ST>
+QCADT::GenEigensolver::createOutArgsImpl() const
+{
+  Thyra::ModelEvaluatorBase::OutArgsSetup<ST> outArgs;
+  outArgs.setModelEvalDescription("QCADT Generalized Eigensolver Model Evaluator");
+
+  // Ng is 1 bigger then model's Ng so that the solution vector can be an outarg
+  outArgs.set_Np_Ng(0, model_num_g+1);
+  return outArgs;
+}
+
+void
+QCADT::GenEigensolver::computeOperator(double alpha, double beta, Tpetra_CrsMatrix& W) const
+{
+  Tpetra_Vector f(x->getMap());
+  app->computeGlobalJacobianT(alpha, beta, 0.0, 0.0, x_dot.get(), NULL, *x, p, &f, W);
+}
+
+
+void
+QCADT::GenEigensolver::evalModelImpl(const Thyra::ModelEvaluatorBase::InArgs<ST>& inArgs,
+				     const Thyra::ModelEvaluatorBase::OutArgs<ST>& outArgs) const
+{
+  // type definitions
+  typedef Tpetra_MultiVector MV;
+  typedef Tpetra_Operator OP;
+  typedef Anasazi::MultiVecTraits<ST, MV> MVT;
+
+  Teuchos::RCP<Teuchos::FancyOStream> out = Teuchos::VerboseObjectBase::getDefaultOStream();
+
+  // Get the stiffness and mass matrices (allocated once and refilled by later calls)
+  if(K == Teuchos::null) {
+    K = Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(
+	  ConverterT::getTpetraOperator(model->create_W_op()), true);
+    M = Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(
+	  ConverterT::getTpetraOperator(model->create_W_op()), true);
+    if(bShiftInvert)
+      A = Teuchos::rcp_dynamic_cast<Tpetra_CrsMatrix>(
+	    ConverterT::getTpetraOperator(model->create_W_op()), true);
+  }
+  computeOperator(0.0, 1.0, *K); //compute K matrix
+  computeOperator(1.0, 0.0, *M); //compute M matrix
+  if(bShiftInvert)
+    computeOperator(-shift, 1.0, *A); // K - shift*M: the Jacobian's alpha*M + beta*K
+
+  // Initial block: the previous call's eigenvectors padded with random vectors
+  Teuchos::RCP<MV> ivec = Teuchos::rcp( new MV(K->getDomainMap(), blockSize) );
+  ivec->randomize();
+  if(bWarmStart && lastEvecs != Teuchos::null && lastEvecs->getMap()->isSameAs(*(ivec->getMap()))) {
+    int nReuse = std::min(blockSize, (int)lastEvecs->getNumVectors());
+    for(int i=0; i<nReuse; i++) ivec->getVectorNonConst(i)->assign(*(lastEvecs->getVector(i)));
+  }
+
+  // Create the eigenproblem: (K,M) directly, or the shift-inverted operator with M as
+  //  the inner product, whose largest eigenvalues theta give lambda = shift + 1/theta
+  Teuchos::RCP<Anasazi::BasicEigenproblem<ST, MV, OP> > eigenProblem;
+  if(bShiftInvert) {
+    Teuchos::RCP<OP> shiftInvert = Teuchos::rcp(new ShiftInvertOperator(A, M, lowsFactory));
+    eigenProblem = Teuchos::rcp( new Anasazi::BasicEigenproblem<ST, MV, OP>(shiftInvert, M, ivec) );
+  }
+  else
+    eigenProblem = Teuchos::rcp( new Anasazi::BasicEigenproblem<ST, MV, OP>(K, M, ivec) );
+
+  eigenProblem->setHermitian(bHermitian);
+  eigenProblem->setNEV( nev );
+
+  bool bSuccess = eigenProblem->setProblem();
+  TEUCHOS_TEST_FOR_EXCEPTION(!bSuccess, Teuchos::Exceptions::InvalidParameter,
+     "Anasazi::BasicEigenproblem::setProblem() returned an error.\n" << std::endl);
+
+  // Create parameter list to pass into the solver manager
+  Teuchos::ParameterList eigenPL;
+  eigenPL.set( "Block Size", blockSize );
+  eigenPL.set( "Convergence Tolerance", conv_tol );
+  eigenPL.set( "Verbosity", Anasazi::IterationDetails );
+
+  Anasazi::ReturnType returnCode;
+  if(bShiftInvert) {
+    eigenPL.set( "Which", std::string("LM") );
+    eigenPL.set( "Num Blocks", numBlocks );
+    eigenPL.set( "Maximum Restarts", maxRestarts );
+    Anasazi::BlockKrylovSchurSolMgr<ST, MV, OP> eigenSolverMan(eigenProblem, eigenPL);
+    returnCode = eigenSolverMan.solve();
+  }
+  else {
+    eigenPL.set( "Which", std::string("SM") ); //always get smallest eigenvalues
+    eigenPL.set( "Maximum Iterations", maxIters );
+    eigenPL.set( "Full Ortho", true );
+    eigenPL.set( "Use Locking", true );
+    Anasazi::LOBPCGSolMgr<ST, MV, OP> eigenSolverMan(eigenProblem, eigenPL);
+    returnCode = eigenSolverMan.solve();
+  }
+
+  // Get the eigenvalues and eigenvectors from the eigenproblem
+  Anasazi::Eigensolution<ST,MV> sol = eigenProblem->getSolution();
+  std::vector<Anasazi::Value<ST> > evals = sol.Evals;
+  Teuchos::RCP<MV> evecs = sol.Evecs;
+
+  std::vector<double> evals_real(sol.numVecs);
+  for(int i=0; i<sol.numVecs; i++)
+    evals_real[i] = bShiftInvert ? shift + 1.0/evals[i].realpart : evals[i].realpart;
+
+  if(bWarmStart && sol.numVecs > 0)
+    lastEvecs = Teuchos::rcp( new MV(*evecs, Teuchos::Copy) );
+
+  // Compute residuals of the original problem
+  std::vector<ST> normR(sol.numVecs);
+  if (sol.numVecs > 0) {
+    Teuchos::SerialDenseMatrix<int,ST> T(sol.numVecs, sol.numVecs);
+    MV Kvec( K->getRangeMap(), evecs->getNumVectors() );
+    MV Mvec( M->getRangeMap(), evecs->getNumVectors() );
+    T.putScalar(0.0);
+    for (int i=0; i<sol.numVecs; i++) {
+      T(i,i) = evals_real[i];
+    }
+    K->apply( *evecs, Kvec );
+    M->apply( *evecs, Mvec );
+    MVT::MvTimesMatAddMv( -1.0, Mvec, T, 1.0, Kvec );
+    MVT::MvNorm( Kvec, normR );
+  }
+
+  // Print the results
+  std::ostringstream os;
+  os.setf(std::ios_base::right, std::ios_base::adjustfield);
+  os<<"Solver manager returned " << (returnCode == Anasazi::Converged ? "converged." : "unconverged.") << std::endl;
+  os<<std::endl;
+  os<<"------------------------------------------------------"<<std::endl;
+  os<<std::setw(16)<<"Eigenvalue"
+    <<std::setw(18)<<"Direct Residual"
+    <<std::endl;
+  os<<"------------------------------------------------------"<<std::endl;
+  for (int i=0; i<sol.numVecs; i++) {
+    os<<std::setw(16)<<evals_real[i]
+      <<std::setw(18)<<normR[i]/evals_real[i]
+      <<std::endl;
+  }
+  os<<"------------------------------------------------------"<<std::endl;
+
+  *out << Anasazi::Anasazi_Version() << std::endl << std::endl;
+  *out << os.str();
+
+  TEUCHOS_TEST_FOR_EXCEPTION(returnCode != Anasazi::Converged, std::runtime_error,
+     "Anasazi eigensolver did not converge: only " << sol.numVecs << " of the "
+     << nev << " requested eigenpairs were found.\n" << std::endl);
+
+  // Package the results in an eigendata structure and put them into the
+  //  application's StateManager (see QCAD::GenEigensolver)
+  Teuchos::RCP<Albany::EigendataStructT> eigenData = Teuchos::rcp( new Albany::EigendataStructT );
+  eigenData->eigenvalueIm = Teuchos::null;  // eigenvalues are real
+  eigenData->eigenvectorIm = Teuchos::null; // eigenvectors are real
+
+  Teuchos::RCP<const Albany::AbstractDiscretization> disc = app->getDiscretization();
+
+  eigenData->eigenvalueRe = Teuchos::rcp( new std::vector<double>(evals_real) );
+  for(int i=0; i<sol.numVecs; i++) (*(eigenData->eigenvalueRe))[i] *= -1;
+      //make eigenvals --> neg_eigenvals to mimic historic LOCA eigensolver (TODO: remove this and switch convention)
+
+  if (sol.numVecs > 0) {
+    // Store *overlapped* eigenvectors in EigendataStructT
+    eigenData->eigenvectorRe =
+      Teuchos::rcp(new Tpetra_MultiVector(disc->getOverlapMapT(), sol.numVecs));
+
+    Teuchos::RCP<Tpetra_Import> importer =
+      Teuchos::rcp(new Tpetra_Import(disc->getMapT(), disc->getOverlapMapT()));
+    eigenData->eigenvectorRe->doImport(*evecs, *importer, Tpetra::INSERT);
+  }
+
+  app->getStateMgr().setEigenDataT(eigenData);
+
+  // Responses at the initial solution, then the solution itself
+  for (int j=0; j<model_num_g; ++j) {
+    const Teuchos::RCP<Thyra::VectorBase<ST> > g_out = outArgs.get_g(j);
+    if (Teuchos::nonnull(g_out))
+      app->evaluateResponseT(j, 0.0, x_dot.get(), NULL, *x, p,
+			     *ConverterT::getTpetraVector(g_out));
+  }
+  const Teuchos::RCP<Thyra::VectorBase<ST> > x_out = outArgs.get_g(model_num_g);
+  if (Teuchos::nonnull(x_out))
+    ConverterT::getTpetraVector(x_out)->assign(*x);
+}
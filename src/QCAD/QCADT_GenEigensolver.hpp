@@ -0,0 +1,89 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef QCADT_GENEIGENSOLVER_H
+#define QCADT_GENEIGENSOLVER_H
+
+#include <iostream>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Thyra_ResponseOnlyModelEvaluatorBase.hpp"
+#include "Thyra_LinearOpWithSolveFactoryBase.hpp"
+
+#include "Albany_Application.hpp"
+#include "Albany_DataTypes.hpp"
+#include "Albany_ModelEvaluatorT.hpp"
+
+
+namespace QCADT {
+
+/** \brief Thyra/Tpetra-based Model Evaluator for QCAD Generalized Eigensolver
+ *
+ *  Solves K x = lambda M x, where K and M are the Jacobians of the Albany
+ *  model with (alpha,beta) = (0,1) and (1,0), using Anasazi on Tpetra.
+ *  With "Operator" = "Shift-Invert" the eigenproblem is transformed to
+ *  (K - sigma M)^{-1} M x = x / (lambda - sigma) and solved by block
+ *  Krylov-Schur; the shifted system is solved with the Stratimikos
+ *  linear solver (e.g. Belos preconditioned by MueLu or Ifpack2).
+ *  Otherwise LOBPCG is applied to (K,M), as in QCAD::GenEigensolver.
+ *
+ *  The eigenvalues (negated, following the LOCA convention) and the
+ *  overlapped eigenvectors are put into the application's StateManager.
+ */
+
+  class GenEigensolver : public Thyra::ResponseOnlyModelEvaluatorBase<ST> {
+  public:
+
+    /** \name Constructors/initializers */
+    //@{
+
+      GenEigensolver(const Teuchos::RCP<Teuchos::ParameterList>& eigensolveParams,
+		     const Teuchos::RCP<Albany::Application>& app,
+		     const Teuchos::RCP<Teuchos::ParameterList>& appParams,
+		     const Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<ST> >& lowsFactory);
+    //@}
+
+    ~GenEigensolver();
+
+    Teuchos::RCP<const Thyra::VectorSpaceBase<ST> > get_p_space(int l) const;
+    Teuchos::RCP<const Thyra::VectorSpaceBase<ST> > get_g_space(int j) const;
+
+    Thyra::ModelEvaluatorBase::InArgs<ST> createInArgs() const;
+
+  private:
+    Thyra::ModelEvaluatorBase::OutArgs<ST> createOutArgsImpl() const;
+
+    void evalModelImpl(const Thyra::ModelEvaluatorBase::InArgs<ST>& inArgs,
+		       const Thyra::ModelEvaluatorBase::OutArgs<ST>& outArgs) const;
+
+    //! Fill W = alpha*M + beta*K at the initial solution
+    void computeOperator(double alpha, double beta, Tpetra_CrsMatrix& W) const;
+
+    Teuchos::RCP<Albany::Application> app;
+    Teuchos::RCP<Albany::ModelEvaluatorT> model;
+    Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<ST> > lowsFactory;
+    int model_num_g;
+
+    //Eigensolver parameters
+    bool bHermitian;
+    bool bShiftInvert;
+    double shift;
+    int nev, blockSize, numBlocks, maxRestarts, maxIters;
+    double conv_tol;
+
+    //Point at which K and M are evaluated
+    Teuchos::RCP<const Tpetra_Vector> x, x_dot;
+    Teuchos::Array<ParamVec> p;
+
+    //Data kept between evalModel calls (see QCAD::GenEigensolver): K, M and the
+    // shifted operator (refilled in place) and the last eigenvectors
+    bool bWarmStart;
+    mutable Teuchos::RCP<Tpetra_CrsMatrix> K, M, A;
+    mutable Teuchos::RCP<Tpetra_MultiVector> lastEvecs;
+  };
+}
+#endif
@@ -6,6 +6,8 @@
 
 #include "QCAD_GenEigensolver.hpp"
 
+#include <algorithm>
+
 //#include "Stokhos.hpp"
 //#include "Stokhos_Epetra.hpp"
 //#include "Sacado_PCE_OrthogPoly.hpp"
@@ -60,6 +62,7 @@ GenEigensolver(const Teuchos::RCP<Teuchos::ParameterList>& eigensolveParams,
   blockSize = myParams->get<int>("Block Size",5);
   maxIters = myParams->get<int>("Maximum Iterations",500);
   conv_tol = myParams->get<double>("Convergece Tolerance",1.0e-8);
+  bWarmStart = myParams->get<bool>("Warm Start",true);
 
   myComm = comm;
 }
@@ -166,9 +169,11 @@ QCAD::GenEigensolver::evalModel(const InArgs& inArgs,
   for(int i=0; i<model_num_p; i++)
     model_inArgs.set_p(i, inArgs.get_p(i));
   
-  //output args
-  Teuchos::RCP<Epetra_CrsMatrix> K = 
-    Teuchos::rcp_dynamic_cast<Epetra_CrsMatrix>(model->create_W(), true);
+  //output args (the matrices are allocated once and refilled by later calls)
+  if(K == Teuchos::null) {
+    K = Teuchos::rcp_dynamic_cast<Epetra_CrsMatrix>(model->create_W(), true);
+    M = Teuchos::rcp_dynamic_cast<Epetra_CrsMatrix>(model->create_W(), true);
+  }
   model_outArgs.set_W(K); 
 
   model->evalModel(model_inArgs, model_outArgs); //compute K matrix
@@ -176,14 +181,18 @@ QCAD::GenEigensolver::evalModel(const InArgs& inArgs,
   // reset alpha and beta to compute the mass matrix
   model_inArgs.set_alpha(1.0);
   model_inArgs.set_beta(0.0);
-  Teuchos::RCP<Epetra_CrsMatrix> M = 
-    Teuchos::rcp_dynamic_cast<Epetra_CrsMatrix>(model->create_W(), true);
   model_outArgs.set_W(M); 
 
   model->evalModel(model_inArgs, model_outArgs); //compute M matrix
 
+  // Initial block: the previous call's eigenvectors, which are close to the new ones when
+  //  the potential changed only slightly, padded with random vectors
   Teuchos::RCP<Epetra_MultiVector> ivec = Teuchos::rcp( new Epetra_MultiVector(K->OperatorDomainMap(), blockSize) );
   ivec->Random();
+  if(bWarmStart && lastEvecs != Teuchos::null && lastEvecs->Map().SameAs(ivec->Map())) {
+    int nReuse = std::min(blockSize, lastEvecs->NumVectors());
+    for(int i=0; i<nReuse; i++) *((*ivec)(i)) = *((*lastEvecs)(i));
+  }
 
   // Create the eigenproblem.
   Teuchos::RCP<Anasazi::BasicEigenproblem<double, MV, OP> > eigenProblem =
@@ -225,6 +234,9 @@ QCAD::GenEigensolver::evalModel(const InArgs& inArgs,
   std::vector<double> evals_real(sol.numVecs);
   for(int i=0; i<sol.numVecs; i++) evals_real[i] = evals[i].realpart;
 
+  if(bWarmStart && sol.numVecs > 0)
+    lastEvecs = Teuchos::rcp( new Epetra_MultiVector(*evecs) );
+
   // Compute residuals.
   std::vector<double> normR(sol.numVecs);
   if (sol.numVecs > 0) {
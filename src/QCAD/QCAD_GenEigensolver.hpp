@@ -13,6 +13,7 @@
 //#include "LOCA_Epetra.H"
 #include "Epetra_Map.h"
 #include "Epetra_Vector.h"
+#include "Epetra_CrsMatrix.h"
 //#include "Epetra_LocalMap.h"
 #include "EpetraExt_ModelEvaluator.h"
 #include "Teuchos_RCP.hpp"
@@ -74,6 +75,13 @@ namespace QCAD {
     std::string which;
     int nev, blockSize, maxIters;
     double conv_tol;
+
+    //Data kept between evalModel calls, e.g. successive Poisson-Schrodinger iterations:
+    // the K and M matrices (refilled in place) and the last eigenvectors, which seed the
+    // next solve's initial block when bWarmStart is set
+    bool bWarmStart;
+    mutable Teuchos::RCP<Epetra_CrsMatrix> K, M;
+    mutable Teuchos::RCP<Epetra_MultiVector> lastEvecs;
   };
 }
 #endif
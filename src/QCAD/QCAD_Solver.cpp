@@ -4,6 +4,8 @@
 //    in the file "license.txt" in the top-level Albany directory  //
 //*****************************************************************//
 
+#include <deque>
+
 #include "QCAD_Solver.hpp"
 #include "QCAD_CoupledPoissonSchrodinger.hpp"
 #include "Piro_Epetra_LOCASolver.hpp"
@@ -28,12 +30,20 @@ Please remove when issue is resolved
 //#include "Teuchos_FancyOStream.hpp"
 
 #include "Teuchos_ParameterList.hpp"
+#include "Teuchos_SerialDenseSolver.hpp"
 
 #include "Albany_Utils.hpp"
 #include "Albany_SolverFactory.hpp"
 #include "Albany_StateInfoStruct.hpp"
 #include "Albany_EigendataInfoStruct.hpp"
 
+#include "Epetra_CrsMatrix.h"
+#include "Piro_StratimikosUtils.hpp"
+#include "Stratimikos_DefaultLinearSolverBuilder.hpp"
+#include "Thyra_EpetraLinearOp.hpp"
+#include "Thyra_EpetraThyraWrappers.hpp"
+#include "Thyra_LinearOpWithSolveFactoryHelpers.hpp"
+
 #ifdef ALBANY_CI
 #include "AnasaziConfigDefs.hpp"
 #include "AnasaziBasicEigenproblem.hpp"
@@ -88,6 +98,10 @@ namespace QCAD {
 			    std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& prevState,
 			    std::string stateName);
   double getNorm2(std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& container, const Teuchos::RCP<const Epetra_Comm>& comm);
+  double getDotProduct(std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& container1,
+		       std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& container2, const Teuchos::RCP<const Epetra_Comm>& comm);
+  void AllocateContainerLike(std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& src,
+			     std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& dest);
   int getElementCount(std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& container);
   
   void ResetEigensolverShift(const Teuchos::RCP<EpetraExt::ModelEvaluator>& Solver, double newShift,
@@ -156,6 +170,8 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
     shiftPercentBelowMin = problemParams.get<double>("Eigensolver Percent Shift Below Potential Min", 1.0);
     ps_converge_tol = problemParams.get<double>("Iterative PS Convergence Tolerance", 1e-6);
     fixedPSOcc = problemParams.get<double>("Iterative PS Fixed Occupation", -1.0);
+    psAndersonDepth = problemParams.get<int>("Iterative PS Anderson Depth", 0);
+    psAndersonMixing = problemParams.get<double>("Iterative PS Anderson Mixing Parameter", 0.5);
   }
 
   // Get problem parameters used for Poisson-Schrodinger-CI mode
@@ -165,6 +181,9 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
     bUseTotalSpinSymmetry = problemParams.get<bool>("Use S2 Symmetry in CI", false);
   }
 
+  // Get problem parameters used by both CI modes
+  bBlockCoulombSolves = problemParams.get<bool>("Block Coulomb Solves", false);
+
   // Get problem parameters used for Schrodinger-CI mode
   if(problemNameBase == "Schrodinger CI") {
     nCIParticles = problemParams.get<int>("CI Particles");
@@ -1325,7 +1344,7 @@ QCAD::Solver::evalPoissonSchrodingerModel(const InArgs& inArgs,
   Teuchos::RCP<Albany::EigendataStruct> eigenDataToPass = Teuchos::null;
 
   //bool bConverged = doPSLoop("damping", inArgs, subSolvers, eigenDataToPass, true);
-  bool bConverged = doPSLoop("mix", inArgs, subSolvers, eigenDataToPass, true);
+  bool bConverged = doPSLoop(psAndersonDepth > 0 ? "anderson" : "mix", inArgs, subSolvers, eigenDataToPass, true);
 
   eigenvalueResponses = *(eigenDataToPass->eigenvalueRe); // copy eigenvalues to member variable
   for(std::size_t i=0; i<eigenvalueResponses.size(); ++i) eigenvalueResponses[i] *= -1; //apply minus sign (b/c of eigenval convention)
@@ -1473,6 +1492,7 @@ QCAD::Solver::evalCIModel(const InArgs& inArgs,
   //Initialize CI solver
   int n1PperBlock = nEigenvectors;
   QCAD::CISolver ciSolver(n1PperBlock, solverComm, out);
+  ciSolver.setBlockCoulombSolves(bBlockCoulombSolves);
   Teuchos::RCP<Teuchos::ParameterList> ciParams = ciSolver.getDefaultParameterList();
   ciParams->set("Num Excitations", nCIExcitations);
   ciParams->set("Subbasis Particles 0", nCIParticles);	  
@@ -1565,6 +1585,7 @@ QCAD::Solver::evalPoissonCIModel(const InArgs& inArgs,
   //Initialize CI solver
   int n1PperBlock = nEigenvectors;
   QCAD::CISolver ciSolver(n1PperBlock, solverComm, out);
+  ciSolver.setBlockCoulombSolves(bBlockCoulombSolves);
   Teuchos::RCP<Teuchos::ParameterList> ciParams = ciSolver.getDefaultParameterList();
 
   if(bUseTotalSpinSymmetry) {  //default is just Sz-symmetry
@@ -1579,7 +1600,7 @@ QCAD::Solver::evalPoissonCIModel(const InArgs& inArgs,
   // 1) converge Schrodinger-Poisson as in evalPoissonSchrodingerModel
   // 2) get the number electrons in the quantum regions
   // 3) loop with CI included
-  bool bPoissonSchrodingerConverged = doPSLoop("mix", inArgs, subSolvers, eigenDataToPass, true);
+  bool bPoissonSchrodingerConverged = doPSLoop(psAndersonDepth > 0 ? "anderson" : "mix", inArgs, subSolvers, eigenDataToPass, true);
   bool bCIConverged = false;
   std::size_t iter = 0;
 
@@ -1774,6 +1795,9 @@ bool QCAD::Solver::doPSLoop(const std::string& mode, const InArgs& inArgs,
 			    Teuchos::RCP<Albany::EigendataStruct>& eigenDataResult,
 			    bool bPrintNumOfQuantumElectrons) const
 {
+  if(mode == "anderson")
+    return doAndersonPSLoop(inArgs, subSolvers, eigenDataResult, bPrintNumOfQuantumElectrons);
+
   Teuchos::RCP<Teuchos::FancyOStream> out(Teuchos::VerboseObjectBase::getDefaultOStream());
 
   //state variables
@@ -2056,6 +2080,173 @@ bool QCAD::Solver::doPSLoop(const std::string& mode, const InArgs& inArgs,
 }
 
 
+// Poisson-Schrodinger loop as a fixed point for the electron density rho_in -> rho_out, where rho_out is
+//  the density of the Poisson solve that follows the Schrodinger solve on the potential of rho_in.
+//  Anderson mixing: with the residual r = rho_out - rho_in and the differences d(rho_in), d(r) of the last
+//  psAndersonDepth iterates, gamma = argmin |r - sum_i gamma_i d(r)_i| and
+//     rho_in <- rho_in + beta*r - sum_i gamma_i ( d(rho_in)_i + beta*d(r)_i ),   beta = psAndersonMixing
+//  The mixed density is imposed by a Poisson solve with "PS Previous Electron Density" mixing factor 1.0.
+bool QCAD::Solver::doAndersonPSLoop(const InArgs& inArgs,
+				    std::map<std::string, SolverSubSolver>& subSolvers, 
+				    Teuchos::RCP<Albany::EigendataStruct>& eigenDataResult,
+				    bool bPrintNumOfQuantumElectrons) const
+{
+  typedef std::vector<Kokkos::DynRankView<RealType, PHX::Device> > Container;
+  Teuchos::RCP<Teuchos::FancyOStream> out(Teuchos::VerboseObjectBase::getDefaultOStream());
+
+  //state variables
+  Albany::StateArrays* pStatesToPass = NULL;
+  Albany::StateArrays* pStatesToLoop = NULL; 
+  Teuchos::RCP<Albany::EigendataStruct> eigenDataNull = Teuchos::null;
+  eigenDataResult = Teuchos::null;
+
+  //Create Initial Poisson solver & fill its parameters
+  subSolvers[ "InitPoisson" ] = CreateSubSolver( "InitPoisson", getSubSolverParams("InitPoisson") , *solverComm);
+  fillSingleSubSolverParams(inArgs, "Poisson", subSolvers[ "InitPoisson" ], 1); //any Poisson[x] parameters get set in initial poisson simulation too
+
+  if(bVerbose) *out << "QCAD Solve: Initial Poisson solve (no quantum region) " << std::endl;
+  QCAD::SolveModel(subSolvers["InitPoisson"], pStatesToPass, pStatesToLoop);
+  
+  //Create Schrodinger solver & fill its parameters
+  subSolvers[ "Schrodinger" ] = CreateSubSolver( "Schrodinger", getSubSolverParams("Schrodinger") , *solverComm); // no initial guess
+  fillSingleSubSolverParams(inArgs, "Schrodinger", subSolvers[ "Schrodinger" ]);
+  
+  //Create Poisson solver & fill its parameters.  Initialize with the solution from the InitPoisson solver
+  Teuchos::RCP<Epetra_Vector> initial_solnVec = subSolvers["InitPoisson"].responses_out->get_g(1); //get the *first* response vector (solution)
+  subSolvers[ "Poisson" ] = CreateSubSolver( "Poisson", getSubSolverParams("Poisson") , *solverComm,  initial_solnVec);
+  fillSingleSubSolverParams(inArgs, "Poisson", subSolvers[ "Poisson" ]);  
+
+  if(bVerbose) *out << "QCAD Solve: Beginning Anderson mixed Poisson-Schrodinger solve loop (depth " 
+		    << psAndersonDepth << ")" << std::endl;
+  bool bConverged = false; 
+  std::size_t iter = 0;
+  double newShift, local_diff, global_diff = 0;
+  std::string ssForShift = "InitPoisson"; //which sub-solver to extract eigensolver shift from
+  Teuchos::RCP<Teuchos::ParameterList> eigList;
+  const double beta = psAndersonMixing;
+
+  Container rhoIn, rhoOut, resid, prevRhoIn, prevResid, savedSolution;
+  std::deque<Container> dRhoIn, dResid; // oldest first
+
+  // the density of the initial poisson solve is the first input density
+  QCAD::CopyStateToContainer(*pStatesToLoop, "PS Saved Electron Density", rhoIn);
+  QCAD::CopyStateToContainer(*pStatesToLoop, "PS Saved Solution", savedSolution);
+
+  while(!bConverged && iter < maxIter)
+  {
+    iter++;
+
+    // reset eigensolver shift for schrodinger solve
+    if(eigensolverName == "LOCA") {
+      newShift = QCAD::GetEigensolverShift(subSolvers[ssForShift], shiftPercentBelowMin);
+      QCAD::ResetEigensolverShift(subSolvers["Schrodinger"].model, newShift, eigList);
+    }
+
+    // Schrodinger Solve -> eigenstates
+    if(bVerbose) *out << "QCAD Solve: Schrodinger iteration " << iter << std::endl;
+    QCAD::SolveModel(subSolvers["Schrodinger"], pStatesToLoop, pStatesToPass,
+		     eigenDataNull, eigenDataResult);
+    if(iter == 1) subSolvers[ "InitPoisson" ].freeUp();  // free up memory
+
+    // Poisson Solve (no mixing) -> output density
+    if(bVerbose) *out << "QCAD Solve: Poisson iteration " << iter << std::endl;
+    QCAD::CopyContainerToState(savedSolution, *pStatesToPass, "PS Previous Poisson Potential");
+    QCAD::SetPreviousDensityMixing(subSolvers["Poisson"].params_in, 0.0);
+    QCAD::SolveModel(subSolvers["Poisson"], pStatesToPass, pStatesToLoop,
+		     eigenDataResult, eigenDataNull);
+    ssForShift = "Poisson"; //from now on, get eigensolver shift from Poisson sub-solver
+
+    if(bPrintNumOfQuantumElectrons) {
+      // see doPSLoop: the total number of quantum electrons is the 6th element from the end of response vector 0
+      Teuchos::RCP<Epetra_Vector> g = subSolvers["Poisson"].responses_out->get_g(0);
+      int totalQuantumElectronsResponseIndex = g->GlobalLength() - 6;
+      if(bVerbose) *out << "QCAD Solve: Poisson iteration has " << (*g)[totalQuantumElectronsResponseIndex] 
+			<< " electrons in the quantum region" << std::endl;
+    }
+
+    // Same convergence measure as doPSLoop: average squared change of the solution
+    local_diff = QCAD::getNorm2Difference(*pStatesToLoop, savedSolution, "PS Saved Solution");
+    solverComm->SumAll(&local_diff, &global_diff, 1);
+    int global_nEls, local_nEls = QCAD::getElementCount(savedSolution);
+    solverComm->SumAll(&local_nEls, &global_nEls, 1);
+    global_diff /= global_nEls;
+    QCAD::CopyStateToContainer(*pStatesToLoop, "PS Saved Solution", savedSolution);
+
+    if(bVerbose) *out << "QCAD Solve: Anderson iteration " << iter << " Diff=" 
+		      << global_diff << " (tol=" << ps_converge_tol << ")" << std::endl;
+    bConverged = (global_diff < ps_converge_tol);
+    if(bConverged || iter >= maxIter) break;
+
+    // Residual and history update
+    QCAD::CopyStateToContainer(*pStatesToLoop, "PS Saved Electron Density", rhoOut);
+    QCAD::AllocateContainerLike(rhoIn, resid);
+    QCAD::CopyContainer(rhoOut, resid);
+    QCAD::AddContainerToContainer(rhoIn, resid, -1.0, 1.0);  // r = rho_out - rho_in
+
+    if(iter > 1) {
+      dRhoIn.push_back(Container());  QCAD::AllocateContainerLike(rhoIn, dRhoIn.back());
+      dResid.push_back(Container());  QCAD::AllocateContainerLike(rhoIn, dResid.back());
+      QCAD::CopyContainer(rhoIn, dRhoIn.back());  QCAD::AddContainerToContainer(prevRhoIn, dRhoIn.back(), -1.0, 1.0);
+      QCAD::CopyContainer(resid, dResid.back());  QCAD::AddContainerToContainer(prevResid, dResid.back(), -1.0, 1.0);
+      if((int)dRhoIn.size() > psAndersonDepth) { dRhoIn.pop_front(); dResid.pop_front(); }
+    }
+    QCAD::AllocateContainerLike(rhoIn, prevRhoIn);   QCAD::CopyContainer(rhoIn, prevRhoIn);
+    QCAD::AllocateContainerLike(rhoIn, prevResid);   QCAD::CopyContainer(resid, prevResid);
+
+    // Least squares coefficients from the normal equations (regularized on the diagonal)
+    const int m = dResid.size();
+    Teuchos::SerialDenseVector<int,double> gamma(m);
+    if(m > 0) {
+      Teuchos::SerialDenseMatrix<int,double> A(m,m);
+      Teuchos::SerialDenseVector<int,double> b(m);
+      for(int i=0; i<m; i++) {
+	b(i) = QCAD::getDotProduct(dResid[i], resid, solverComm);
+	for(int j=0; j<=i; j++)
+	  A(i,j) = A(j,i) = QCAD::getDotProduct(dResid[i], dResid[j], solverComm);
+	A(i,i) *= (1.0 + 1e-10);
+      }
+      Teuchos::SerialDenseSolver<int,double> lsq;
+      lsq.setMatrix(Teuchos::rcpFromRef(A));
+      lsq.setVectors(Teuchos::rcpFromRef(gamma), Teuchos::rcpFromRef(b));
+      lsq.factorWithEquilibration(true);
+      if(lsq.solve() != 0) { // singular history: fall back to simple mixing and restart
+	gamma.putScalar(0.0);
+	dRhoIn.clear(); dResid.clear();
+      }
+    }
+
+    // rho_in <- rho_in + beta*r - sum_i gamma_i ( d(rho_in)_i + beta*d(r)_i ), kept non-negative
+    QCAD::AddContainerToContainer(resid, rhoIn, beta, 1.0);
+    for(int i=0; i<(int)dResid.size(); i++) {
+      QCAD::AddContainerToContainer(dRhoIn[i], rhoIn, -gamma(i), 1.0);
+      QCAD::AddContainerToContainer(dResid[i], rhoIn, -beta*gamma(i), 1.0);
+    }
+    for(std::size_t ws=0; ws < rhoIn.size(); ws++)
+      for(int cell=0; cell < rhoIn[ws].dimension(0); cell++)
+	for(int qp=0; qp < rhoIn[ws].dimension(1); qp++)
+	  if(rhoIn[ws](cell,qp) < 0) rhoIn[ws](cell,qp) = 0;
+
+    // Poisson Solve with the mixed density -> potential for the next Schrodinger solve
+    if(bVerbose) *out << "QCAD Solve: Poisson Anderson-mix iteration " << iter << " (history " << m << ")" << std::endl;
+    QCAD::CopyContainerToState(rhoIn, *pStatesToPass, "PS Previous Electron Density");
+    QCAD::SetPreviousDensityMixing(subSolvers["Poisson"].params_in, 1.0);
+    QCAD::SolveModel(subSolvers["Poisson"], pStatesToPass, pStatesToLoop,
+		     eigenDataResult, eigenDataNull);
+    QCAD::CopyStateToContainer(*pStatesToLoop, "PS Saved Solution", savedSolution);
+  }
+
+  // Done with iterative P-S loop
+  if(bVerbose) {
+    if(bConverged)
+      *out << "QCAD Solve: Converged Poisson-Schrodinger solve loop after " << iter << " iterations." << std::endl;
+    else
+      *out << "QCAD Solve: Maximum iterations (" << maxIter << ") reached." << std::endl;
+  }
+
+  return bConverged;
+}
+
+
 void QCAD::Solver::setupParameterMapping(const Teuchos::ParameterList& list, const std::string& defaultSubSolver,
 					 const std::map<std::string, SolverSubSolverData>& subSolversData)
 {
@@ -2360,12 +2551,15 @@ QCAD::Solver::getValidProblemParameters() const
   validPL->set<double>("Eigensolver Percent Shift Below Potential Min", 1.0, "Percentage of energy range of potential to subtract from the potential's minimum to obtain the eigensolver's shift");
   validPL->set<double>("Iterative PS Convergence Tolerance", 1e-6, "Convergence criterion for iterative PS solver (max potential difference across mesh)");
   validPL->set<double>("Iterative PS Fixed Occupation", -1.0, "Fixed quantum orbital occupation for iterative PS solver (non equilibrium condition)");
+  validPL->set<int>("Iterative PS Anderson Depth", 0, "Number of previous iterates used by Anderson mixing of the electron density in the iterative PS solver (0 = step size mixing)");
+  validPL->set<double>("Iterative PS Anderson Mixing Parameter", 0.5, "Fraction of the electron density residual added in each Anderson mixing step of the iterative PS solver");
 
   validPL->set<int>("Minimum CI Particles", 0, "Poisson Schrodinger CI mode only: the minimum number of particles to use in the CI phase");
   validPL->set<int>("Maximum CI Particles", 0, "Poisson Schrodinger CI mode only: the maximum number of particles to use in the CI phase");
   validPL->set<int>("CI Particles", 0, "Schrodinger CI mode only: the number of particles to use in the CI phase");
   validPL->set<int>("CI Excitations", 0, "Schrodinger CI mode only: the number of excitations with which to truncate the CI phase");
   validPL->set<bool>("Use S2 Symmetry in CI",false,"Use total spin symmetry in the CI part of a problem");
+  validPL->set<bool>("Block Coulomb Solves",false,"CI modes only: compute the Coulomb elements of all eigenvector pairs with one multiple right-hand side linear solve instead of a Poisson solve per pair");
 
   validPL->set<bool>("Include exchange-correlation potential",false,"Include exchange-correlation potential in poisson source term");
   validPL->set<bool>("Only solve schrodinger in quantum blocks",true,"Limit schrodinger solution to elements blocks labeled as quantum in the materials DB");
@@ -2902,7 +3096,7 @@ void QCAD::SolverResponseFn::fillSolverResponses(Epetra_Vector& g, Teuchos::RCP<
 
 QCAD::CISolver::CISolver(int n1PSpinlessStates, Teuchos::RCP<const Epetra_Comm> eComm,
 			 Teuchos::RCP<Teuchos::FancyOStream> outStream)
-  :n1PperBlock(n1PSpinlessStates)
+  :n1PperBlock(n1PSpinlessStates), bBlockCoulomb(false)
 {
   //Memory for CI Matrices
   //  - H1P matrix blocks (generate 2 blocks (up & down), each nEvecs x nEvecs)
@@ -3082,29 +3276,34 @@ void QCAD::CISolver::fill2Pmx(Teuchos::RCP<Albany::EigendataStruct> eigenData1P,
 			      const Teuchos::RCP<Epetra_Vector>& g_noCharge,
 			      bool bRealEvecs, bool bVerbose)
 {
-  Teuchos::RCP<Albany::EigendataStruct> eigenDataNull = Teuchos::null; // dummy
   Teuchos::RCP<Epetra_Vector> g_reSrc, g_imSrc;
 
+  // Coulomb Poisson Solves - get coulomb els of each (i2,i4) pair, i4 >= i2, in reponse vectors
+  std::vector<Teuchos::RCP<Epetra_Vector> > g_reSrcs, g_imSrcs;
+  if(bBlockCoulomb) {
+    BlockSolveCoulombPairs(eigenData1P, coulombSolver, g_reSrcs, "Coulomb", bVerbose);
+    if(!bRealEvecs)
+      BlockSolveCoulombPairs(eigenData1P, coulombSolver_ImPart, g_imSrcs, "Imaginary Coulomb", bVerbose);
+  }
+  else {
+    SolveCoulombPairs(eigenData1P, coulombSolver, g_reSrcs, "Coulomb", bVerbose);
+    if(!bRealEvecs)
+      SolveCoulombPairs(eigenData1P, coulombSolver_ImPart, g_imSrcs, "Imaginary Coulomb", bVerbose);
+  }
+
   // fill in mx2P (4 blocks, each n1PperBlock x n1PperBlock x n1PperBlock x n1PperBlock )
+  int iPair = 0;
   for(int i2=0; i2<n1PperBlock; i2++) {
-    for(int i4=i2; i4<n1PperBlock; i4++) {
+    for(int i4=i2; i4<n1PperBlock; i4++, iPair++) {
       
-      // Coulomb Poisson Solve - get coulomb els in reponse vector
-      if(bVerbose) *out << "QCAD Solve: Coulomb " << i2 << "," << i4 << " Poisson" << std::endl;
-      SetCoulombParams( coulombSolver->params_in, i2,i4 ); 
-      QCAD::SolveModel(*coulombSolver, eigenData1P, eigenDataNull);
-      g_reSrc = coulombSolver->responses_out->get_g(0); //only use *first* response vector    
+      g_reSrc = g_reSrcs[iPair];
 
       *out << "DEBUG: g_reSrc vector:" << std::endl; //DEBUG
       for(int i=0; i< g_reSrc->MyLength(); i++) *out << "  g_reSrc[" << i << "] = " << (*g_reSrc)[i] << std::endl;	      
 	      
 
       if(!bRealEvecs) {
-	// Coulomb Poisson Solve - get imaginary coulomb els in reponse vector
-	if(bVerbose) *out << "QCAD Solve: Imaginary Coulomb " << i2 << "," << i4 << " Poisson" << std::endl;
-	SetCoulombParams( coulombSolver_ImPart->params_in, i2,i4 ); 
-	QCAD::SolveModel(*coulombSolver_ImPart, eigenData1P, eigenDataNull);
-	g_imSrc = coulombSolver_ImPart->responses_out->get_g(0); //only use *first* response vector    
+	g_imSrc = g_imSrcs[iPair];
 	      
 	*out << "DEBUG: g_imSrc vector:" << std::endl; //DEBUG
 	for(int i=0; i< g_imSrc->MyLength(); i++) *out << "  g_imSrc[" << i << "] = " << (*g_imSrc)[i] << std::endl;
@@ -3213,6 +3412,110 @@ void QCAD::CISolver::fill2Pmx(Teuchos::RCP<Albany::EigendataStruct> eigenData1P,
 }
 
 
+void QCAD::CISolver::SolveCoulombPairs(Teuchos::RCP<Albany::EigendataStruct> eigenData1P,
+				       const SolverSubSolver* coulombSolver,
+				       std::vector<Teuchos::RCP<Epetra_Vector> >& g_pairs,
+				       const std::string& desc, bool bVerbose) const
+{
+  Teuchos::RCP<Albany::EigendataStruct> eigenDataNull = Teuchos::null; // dummy
+  g_pairs.clear();
+
+  for(int i2=0; i2<n1PperBlock; i2++) {
+    for(int i4=i2; i4<n1PperBlock; i4++) {
+      if(bVerbose) *out << "QCAD Solve: " << desc << " " << i2 << "," << i4 << " Poisson" << std::endl;
+      SetCoulombParams( coulombSolver->params_in, i2,i4 ); 
+      QCAD::SolveModel(*coulombSolver, eigenData1P, eigenDataNull);
+
+      //only use *first* response vector; copy since responses_out is reused by the next solve
+      g_pairs.push_back( Teuchos::rcp(new Epetra_Vector(*(coulombSolver->responses_out->get_g(0)))) );
+    }
+  }
+}
+
+
+void QCAD::CISolver::BlockSolveCoulombPairs(Teuchos::RCP<Albany::EigendataStruct> eigenData1P,
+					    const SolverSubSolver* coulombSolver,
+					    std::vector<Teuchos::RCP<Epetra_Vector> >& g_pairs,
+					    const std::string& desc, bool bVerbose) const
+{
+  // The Coulomb Poisson problem is linear in the potential and only its source depends
+  //  on the (i2,i4) pair, so with r(x) = J*x + r(0) each pair's potential is x = -J^{-1} r(0).
+  //  J is assembled and factored/preconditioned once, and all the pairs are solved together.
+  const Teuchos::RCP<Albany::Application>& app = coulombSolver->app;
+  const int nPairs = n1PperBlock * (n1PperBlock + 1) / 2;
+
+  app->getStateMgr().setEigenData(eigenData1P);
+
+  // Sacado parameter vector of the sub-application, filled from the sub-solver's parameters
+  //  as the Albany::ModelEvaluator would (the source eigenvector indices are the last two)
+  Teuchos::ParameterList& paramList = app->getProblemPL()->sublist("Parameters");
+  int nParams = paramList.get<int>("Number", 0);
+  Teuchos::Array<std::string> paramNames(nParams);
+  for(int k=0; k<nParams; k++)
+    paramNames[k] = paramList.get<std::string>(Albany::strint("Parameter",k));
+  Teuchos::Array<ParamVec> p(1);
+  app->getParamLib()->fillVector<PHAL::AlbanyTraits::Residual>(paramNames, p[0]);
+
+  const Epetra_Map& map = *(app->getMap());
+  Epetra_Vector x(map, true), f(map);
+  Epetra_MultiVector rhs(map, nPairs), X(map, nPairs, true);
+  Teuchos::RCP<Epetra_CrsMatrix> jac = Teuchos::rcp(new Epetra_CrsMatrix(Copy, *(app->getJacobianGraph())));
+
+  int iPair = 0;
+  for(int i2=0; i2<n1PperBlock; i2++) {
+    for(int i4=i2; i4<n1PperBlock; i4++, iPair++) {
+      SetCoulombParams( coulombSolver->params_in, i2,i4 ); 
+      const Epetra_Vector& pv = *(coulombSolver->params_in->get_p(0));
+      for(int k=0; k<nParams; k++) p[0][k].baseValue = pv[k];
+
+      if(iPair == 0)
+	app->computeGlobalJacobian(0.0, 1.0, 0.0, 0.0, NULL, NULL, x, p, &f, *jac);
+      else
+	app->computeGlobalResidual(0.0, NULL, NULL, x, p, f);
+      rhs(iPair)->Scale(-1.0, f);
+    }
+  }
+
+  if(bVerbose) *out << "QCAD Solve: " << desc << " Poisson, block solve of " << nPairs << " pairs" << std::endl;
+
+  // Linear solver from the sub-application's Piro list, i.e. the one its Newton solves would use
+  Stratimikos::DefaultLinearSolverBuilder linearSolverBuilder;
+  linearSolverBuilder.setParameterList(Piro::extractStratimikosParams(Teuchos::sublist(app->getAppPL(), "Piro")));
+  Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<double> > lowsFactory =
+    Thyra::createLinearSolveStrategy(linearSolverBuilder);
+
+  Teuchos::RCP<const Thyra::LinearOpBase<double> > A = Thyra::epetraLinearOp(jac);
+  Teuchos::RCP<Thyra::LinearOpWithSolveBase<double> > lows = Thyra::linearOpWithSolve(*lowsFactory, A);
+  Teuchos::RCP<const Thyra::MultiVectorBase<double> > B_th =
+    Thyra::create_MultiVector(Teuchos::rcpFromRef(const_cast<const Epetra_MultiVector&>(rhs)), A->range());
+  Teuchos::RCP<Thyra::MultiVectorBase<double> > X_th =
+    Thyra::create_MultiVector(Teuchos::rcpFromRef(X), A->domain());
+
+  Thyra::SolveStatus<double> status = Thyra::solve<double>(*lows, Thyra::NOTRANS, *B_th, X_th.ptr());
+  if(bVerbose) *out << "QCAD Solve: " << desc << " Poisson block solve status: " << status.message << std::endl;
+
+  // Responses at each pair's potential
+  const Teuchos::RCP<const Teuchos_Comm> commT = app->getComm();
+  const Teuchos::RCP<const Epetra_Comm> commE = app->getEpetraComm();
+  g_pairs.resize(nPairs);
+  iPair = 0;
+  for(int i2=0; i2<n1PperBlock; i2++) {
+    for(int i4=i2; i4<n1PperBlock; i4++, iPair++) {
+      SetCoulombParams( coulombSolver->params_in, i2,i4 ); 
+      const Epetra_Vector& pv = *(coulombSolver->params_in->get_p(0));
+      for(int k=0; k<nParams; k++) p[0][k].baseValue = pv[k];
+
+      Teuchos::RCP<const Tpetra_Vector> xT = Petra::EpetraVector_To_TpetraVectorConst(*X(iPair), commT);
+      Teuchos::RCP<Tpetra_Vector> gT = Teuchos::rcp(new Tpetra_Vector(app->getResponse(0)->responseMapT())); //only use *first* response vector
+      app->evaluateResponseT(0, 0.0, NULL, NULL, *xT, p, *gT);
+
+      g_pairs[iPair] = Teuchos::rcp(new Epetra_Vector(*(app->getResponse(0)->responseMap())));
+      Petra::TpetraVector_To_EpetraVector(gT, *g_pairs[iPair], commE);
+    }
+  }
+}
+
+
 Teuchos::RCP<AlbanyCI::Solution> 
 QCAD::CISolver::Solve(Teuchos::RCP<Teuchos::ParameterList> AlbanyCIList) const
 {
@@ -3608,6 +3911,39 @@ double QCAD::getNorm2(std::vector<Kokkos::DynRankView<RealType, PHX::Device> >&
   return global_norm2;
 }
 
+double QCAD::getDotProduct(std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& container1,
+			   std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& container2,
+			   const Teuchos::RCP<const Epetra_Comm>& comm)
+{
+  double dot = 0.0;
+  int numWorksets = container1.size();
+
+  for (int ws = 0; ws < numWorksets; ws++)
+  {
+    TEUCHOS_TEST_FOR_EXCEPT( container1[ws].rank() != 2 );
+
+    for(int cell=0; cell < container1[ws].dimension(0); cell++) 
+      for(int qp=0; qp < container1[ws].dimension(1); qp++) 
+	dot += container1[ws](cell,qp) * container2[ws](cell,qp);
+  }
+
+  double global_dot;
+  comm->SumAll(&dot, &global_dot, 1);
+  return global_dot;
+}
+
+//Allocate dest with the shape of src if necessary (values are not copied)
+void QCAD::AllocateContainerLike(std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& src,
+				 std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& dest)
+{
+  int numWorksets = src.size();
+  if(dest.size() == (unsigned int)numWorksets) return;
+
+  dest.resize(numWorksets);
+  for (int ws = 0; ws < numWorksets; ws++)
+    dest[ws] = Kokkos::DynRankView<RealType, PHX::Device>("XXX", src[ws].dimension(0), src[ws].dimension(1));
+}
+
 int QCAD::getElementCount(std::vector<Kokkos::DynRankView<RealType, PHX::Device> >& container)
 {
   int cnt = 0;
@@ -96,6 +96,8 @@ namespace QCAD {
 
     bool doPSLoop(const std::string& mode, const InArgs& inArgs, std::map<std::string, SolverSubSolver>& subSolvers,
 		  Teuchos::RCP<Albany::EigendataStruct>& eigenDataResult, bool bPrintNumOfQuantumElectrons) const;
+    bool doAndersonPSLoop(const InArgs& inArgs, std::map<std::string, SolverSubSolver>& subSolvers,
+			  Teuchos::RCP<Albany::EigendataStruct>& eigenDataResult, bool bPrintNumOfQuantumElectrons) const;
 
     void setupParameterMapping(const Teuchos::ParameterList& list, const std::string& defaultSubSolver,
 			       const std::map<std::string, SolverSubSolverData>& subSolversData);
@@ -171,8 +173,11 @@ namespace QCAD {
     int    nCIParticles;          // the number of particles used in CI calculation
     int    nCIExcitations;        // the number of excitations used in CI calculation
     double fixedPSOcc;
+    int    psAndersonDepth;       // Anderson mixing history depth of the iterative P-S loop (0 = step size mixing)
+    double psAndersonMixing;      // Anderson mixing parameter (fraction of the density residual added per step)
     bool   bUseIntegratedPS;
     bool   bUseTotalSpinSymmetry; // use S2 symmetry in CI calculation
+    bool   bBlockCoulombSolves;   // solve the Coulomb Poisson problems of all source pairs together
   };
 
 
@@ -274,14 +279,33 @@ namespace QCAD {
     Teuchos::RCP<Epetra_MultiVector> ComputeStateDensities(Teuchos::RCP<Albany::EigendataStruct> eigenData1P,
 							   Teuchos::RCP<AlbanyCI::Solution> soln);
 
+    //! Solve the (linear) Coulomb Poisson problems of all source pairs as one multi-RHS solve
+    void setBlockCoulombSolves(bool bBlock) { bBlockCoulomb = bBlock; }
+
 
   private:
     void SetCoulombParams(const Teuchos::RCP<EpetraExt::ModelEvaluator::InArgs> inArgs, int i2, int i4) const;
 
+    //! Coulomb responses of every (i2,i4) source pair, one Poisson solve per pair
+    void SolveCoulombPairs(Teuchos::RCP<Albany::EigendataStruct> eigenData1P,
+			   const SolverSubSolver* coulombSolver,
+			   std::vector<Teuchos::RCP<Epetra_Vector> >& g_pairs,
+			   const std::string& desc, bool bVerbose) const;
+
+    //! Coulomb responses of every (i2,i4) source pair from a single factorization of the
+    //!  Poisson operator, with the pair sources as the columns of a multivector right-hand side
+    void BlockSolveCoulombPairs(Teuchos::RCP<Albany::EigendataStruct> eigenData1P,
+				const SolverSubSolver* coulombSolver,
+				std::vector<Teuchos::RCP<Epetra_Vector> >& g_pairs,
+				const std::string& desc, bool bVerbose) const;
+
   private:
     // number of single particle states of each type of spin (up / down)
     int n1PperBlock;
 
+    // whether fill2Pmx batches the Coulomb Poisson solves
+    bool bBlockCoulomb;
+
     // 1P Blocks, accessed individually or as a vector
     Teuchos::RCP<AlbanyCI::Tensor<AlbanyCI::dcmplx> > blockU,blockD;
     std::vector<Teuchos::RCP<AlbanyCI::Tensor<AlbanyCI::dcmplx> > > blocks1P;
@@ -14,6 +14,7 @@
 #include "Tpetra_Map.hpp"
 #include "QCAD_GreensFunctionTunneling.hpp"
 #include <fstream>
+#include <algorithm>
 #include "Petra_Converters.hpp" 
 
 //! Helper function prototypes
@@ -34,6 +35,10 @@ namespace QCAD
 	      std::pair<std::size_t, double> const& b);
   double averageOfVector(const std::vector<double>& v);
   double distance(const std::vector<double>* vCoords, int ind1, int ind2, std::size_t nDims);
+
+  //! pointFn weights below this are zero, i.e. beyond radius * sqrt(-2 ln(pointFnMinWeight))
+  const double pointFnMinWeight = 1e-2;
+  const double pointFnCutoffFctr = sqrt(-2*log(pointFnMinWeight));
 }
 
 QCAD::SaddleValueResponseFunction::
@@ -2108,6 +2113,9 @@ getImagePointValues(const double current_time,
   xmin -= 5*imagePtSize; xmax += 5*imagePtSize;
   ymin -= 5*imagePtSize; ymax += 5*imagePtSize;
     
+  //Bin image points so each cell only visits the image points near it
+  imagePtGrid.build(imagePts, numDims, pointFnCutoffFctr);
+
   //Reset value, weight, and gradient of image points as these are accumulated by evaluator fill
   imagePtValues.fill(0.0);
   imagePtWeights.fill(0.0);
@@ -2134,10 +2142,11 @@ getImagePointValues(const double current_time,
 				     current_time, xdotT.get(), NULL, *xT, p, *gT);
   }
 
-  //MPI -- sum weights, value, and gradient for each image pt
-  comm->SumAll( imagePtValues.data(),    globalPtValues,  nImagePts );
-  comm->SumAll( imagePtWeights.data(),   globalPtWeights, nImagePts );
-  comm->SumAll( imagePtGradComps.data(), globalPtGrads,   nImagePts*numDims );
+  //MPI -- sum weights, value, and gradient for each image pt (one reduction)
+  std::vector<double> localPtData, globalPtData(nImagePts*(2+numDims));
+  packImagePointData(localPtData);
+  comm->SumAll( &localPtData[0], &globalPtData[0], localPtData.size() );
+  unpackImagePointData(globalPtData, globalPtValues, globalPtWeights, globalPtGrads);
 
   // Put summed data into imagePts, normalizing value and 
   //   gradient from different cell contributions
@@ -2179,6 +2188,9 @@ getFinalImagePointValues(const double current_time,
   xmin -= 5*imagePtSize; xmax += 5*imagePtSize;
   ymin -= 5*imagePtSize; ymax += 5*imagePtSize;
     
+  //Bin final image points so each cell only visits the points near it
+  finalPtGrid.build(finalPts, numDims, pointFnCutoffFctr);
+
   //Reset value and weight of final image points as these are accumulated by evaluator fill
   finalPtValues.fill(0.0);
   finalPtWeights.fill(0.0);
@@ -2256,6 +2268,9 @@ getImagePointValuesT(const double current_time,
   xmin -= 5*imagePtSize; xmax += 5*imagePtSize;
   ymin -= 5*imagePtSize; ymax += 5*imagePtSize;
     
+  //Bin image points so each cell only visits the image points near it
+  imagePtGrid.build(imagePts, numDims, pointFnCutoffFctr);
+
   //Reset value, weight, and gradient of image points as these are accumulated by evaluator fill
   imagePtValues.fill(0.0);
   imagePtWeights.fill(0.0);
@@ -2273,13 +2288,11 @@ getImagePointValuesT(const double current_time,
 				     current_time, xdotT, NULL, xT, p, gT);
   }
 
-  //MPI -- sum weights, value, and gradient for each image pt
-  Teuchos::reduceAll<LO, ST>(*commT, Teuchos::REDUCE_SUM, nImagePts, imagePtValues.data(), globalPtValues); 
-  Teuchos::reduceAll<LO, ST>(*commT, Teuchos::REDUCE_SUM, nImagePts, imagePtWeights.data(), globalPtWeights); 
-  Teuchos::reduceAll<LO, ST>(*commT, Teuchos::REDUCE_SUM, nImagePts*numDims, imagePtGradComps.data(), globalPtGrads); 
-  //comm.SumAll( imagePtValues.data(),    globalPtValues,  nImagePts );
-  //comm.SumAll( imagePtWeights.data(),   globalPtWeights, nImagePts );
-  //comm.SumAll( imagePtGradComps.data(), globalPtGrads,   nImagePts*numDims );
+  //MPI -- sum weights, value, and gradient for each image pt (one reduction)
+  std::vector<double> localPtData, globalPtData(nImagePts*(2+numDims));
+  packImagePointData(localPtData);
+  Teuchos::reduceAll<LO, ST>(*commT, Teuchos::REDUCE_SUM, localPtData.size(), &localPtData[0], &globalPtData[0]); 
+  unpackImagePointData(globalPtData, globalPtValues, globalPtWeights, globalPtGrads);
 
   // Put summed data into imagePts, normalizing value and 
   //   gradient from different cell contributions
@@ -2545,7 +2558,9 @@ void QCAD::SaddleValueResponseFunction::
 addImagePointData(const double* p, double value, double* grad)
 {
   double w, effDims = (bLockToPlane && numDims > 2) ? 2 : numDims;
-  for(std::size_t i=0; i<nImagePts; i++) {
+  imagePtGrid.nearbyPoints(p, nearPts);
+  for(std::size_t j=0; j<nearPts.size(); j++) {
+    std::size_t i = nearPts[j];
     w = pointFn(imagePts[i].coords.distanceTo(p) , imagePts[i].radius );
     if(w > 0) {
       imagePtWeights[i] += w;
@@ -2564,7 +2579,9 @@ void QCAD::SaddleValueResponseFunction::
 addFinalImagePointData(const double* p, double value)
 {
   double w;
-  for(std::size_t i=0; i< finalPts.size(); i++) {
+  finalPtGrid.nearbyPoints(p, nearPts);
+  for(std::size_t j=0; j<nearPts.size(); j++) {
+    std::size_t i = nearPts[j];
     w = pointFn(finalPts[i].coords.distanceTo(p) , finalPts[i].radius );
     if(w > 0) {
       finalPtWeights[i] += w;
@@ -2657,7 +2674,25 @@ pointFn(double d, double radius) const {
 
   const double N = 1.0;
   double val = N*exp(-d*d / (2*radius*radius));
-  return (val >= 1e-2) ? val : 0.0;
+  return (val >= pointFnMinWeight) ? val : 0.0;
+}
+
+void QCAD::SaddleValueResponseFunction::
+packImagePointData(std::vector<double>& buf) const
+{
+  buf.resize(nImagePts*(2+numDims));
+  std::copy(imagePtValues.data(), imagePtValues.data()+nImagePts, buf.begin());
+  std::copy(imagePtWeights.data(), imagePtWeights.data()+nImagePts, buf.begin()+nImagePts);
+  std::copy(imagePtGradComps.data(), imagePtGradComps.data()+nImagePts*numDims, buf.begin()+2*nImagePts);
+}
+
+void QCAD::SaddleValueResponseFunction::
+unpackImagePointData(const std::vector<double>& buf, double* globalPtValues,
+		     double* globalPtWeights, double* globalPtGrads) const
+{
+  std::copy(buf.begin(), buf.begin()+nImagePts, globalPtValues);
+  std::copy(buf.begin()+nImagePts, buf.begin()+2*nImagePts, globalPtWeights);
+  std::copy(buf.begin()+2*nImagePts, buf.begin()+nImagePts*(2+numDims), globalPtGrads);
 }
 
 int QCAD::SaddleValueResponseFunction::
@@ -2673,6 +2708,94 @@ getHighestPtIndex() const
 
 
 
+/*************************************************************/
+//! Image point bins
+/*************************************************************/
+
+QCAD::imagePtBins::imagePtBins() :
+  dims(0), binSize(1.0)
+{
+  for(int k=0; k<MAX_DIMENSIONS; k++) { lo[k] = 0.0; nBins[k] = 1; }
+}
+
+void QCAD::imagePtBins::
+build(const std::vector<nebImagePt>& pts, std::size_t nDims, double cutoffFctr)
+{
+  dims = nDims;
+  binStart.assign(2, 0);
+  binPts.clear();
+  for(int k=0; k<MAX_DIMENSIONS; k++) { lo[k] = 0.0; nBins[k] = 1; }
+  if(pts.size() == 0) return;
+
+  double hi[MAX_DIMENSIONS];
+  binSize = 0.0;
+  for(std::size_t k=0; k<dims; k++) lo[k] = hi[k] = pts[0].coords[k];
+  for(std::size_t i=0; i<pts.size(); i++) {
+    binSize = std::max(binSize, cutoffFctr*pts[i].radius);
+    for(std::size_t k=0; k<dims; k++) {
+      lo[k] = std::min(lo[k], pts[i].coords[k]);
+      hi[k] = std::max(hi[k], pts[i].coords[k]);
+    }
+  }
+  if(!(binSize > 0)) binSize = 1.0;
+
+  // coarsen until the number of bins is proportional to the number of points
+  const double maxBins = 8.0*pts.size() + 64;
+  double totalBins;
+  do {
+    totalBins = 1.0;
+    for(std::size_t k=0; k<dims; k++) totalBins *= floor((hi[k]-lo[k])/binSize) + 1;
+    if(totalBins > maxBins) binSize *= 2;
+  } while(totalBins > maxBins);
+  for(std::size_t k=0; k<dims; k++) nBins[k] = (int)floor((hi[k]-lo[k])/binSize) + 1;
+
+  // counting sort of the points by bin
+  std::vector<std::size_t> ptBin(pts.size());
+  binStart.assign((std::size_t)totalBins + 1, 0);
+  for(std::size_t i=0; i<pts.size(); i++) {
+    std::size_t b = 0;
+    for(std::size_t k=0; k<dims; k++) {
+      int c = std::min((int)floor((pts[i].coords[k]-lo[k])/binSize), nBins[k]-1);
+      b = b*nBins[k] + c;
+    }
+    ptBin[i] = b;
+    binStart[b+1]++;
+  }
+  for(std::size_t b=1; b<binStart.size(); b++) binStart[b] += binStart[b-1];
+
+  std::vector<std::size_t> next(binStart.begin(), binStart.end()-1);
+  binPts.resize(pts.size());
+  for(std::size_t i=0; i<pts.size(); i++) binPts[next[ptBin[i]]++] = i;
+}
+
+void QCAD::imagePtBins::
+nearbyPoints(const double* p, std::vector<std::size_t>& indices) const
+{
+  // range of adjacent bins in each dimension (unused dimensions have a single bin)
+  int first[MAX_DIMENSIONS], last[MAX_DIMENSIONS];
+  for(int k=0; k<MAX_DIMENSIONS; k++) first[k] = last[k] = 0;
+
+  indices.clear();
+  for(std::size_t k=0; k<dims; k++) {
+    double c = floor((p[k]-lo[k])/binSize);
+    if(c < -1 || c > nBins[k]) return; // farther than one bin from every point
+    first[k] = std::max((int)c - 1, 0);
+    last[k]  = std::min((int)c + 1, nBins[k]-1);
+  }
+
+  for(int i0=first[0]; i0<=last[0]; i0++)
+    for(int i1=first[1]; i1<=last[1]; i1++)
+      for(int i2=first[2]; i2<=last[2]; i2++) {
+	std::size_t b = i0;
+	if(dims > 1) b = b*nBins[1] + i1;
+	if(dims > 2) b = b*nBins[2] + i2;
+	indices.insert(indices.end(), binPts.begin()+binStart[b], binPts.begin()+binStart[b+1]);
+      }
+  std::sort(indices.begin(), indices.end());
+}
+
+
+
 /*************************************************************/
 //! Helper functions
 /*************************************************************/
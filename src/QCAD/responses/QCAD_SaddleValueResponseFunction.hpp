@@ -96,6 +96,24 @@ namespace QCAD {
     double data[MAX_DIMENSIONS];
   };
 
+  // Uniform grid of bins over a set of image points.  The bin size is at least the
+  //  largest cutoff distance, so only points in the bins adjacent to p can be within it.
+  class imagePtBins {
+  public:
+    imagePtBins();
+    void build(const std::vector<nebImagePt>& pts, std::size_t nDims, double cutoffFctr);
+    //! fills indices (ascending) with the points that may lie within the cutoff of p
+    void nearbyPoints(const double* p, std::vector<std::size_t>& indices) const;
+
+  private:
+    std::size_t dims;
+    double binSize;
+    double lo[MAX_DIMENSIONS];
+    int nBins[MAX_DIMENSIONS];
+    std::vector<std::size_t> binStart; // points of bin b are binPts[binStart[b]..binStart[b+1])
+    std::vector<std::size_t> binPts;
+  };
+
  
   /*!
    * \brief Reponse function for finding saddle point values of a field
@@ -285,6 +303,11 @@ namespace QCAD {
     //! function giving distribution of weights for "point"
     double pointFn(double d, double radius) const;
 
+    //! pack the local image point sums into buf, and unpack their global sums
+    void packImagePointData(std::vector<double>& buf) const;
+    void unpackImagePointData(const std::vector<double>& buf, double* globalPtValues,
+			      double* globalPtWeights, double* globalPtGrads) const;
+
     //! helper function to get the highest image point (the one with the largest value)
     int getHighestPtIndex() const;
 
@@ -366,6 +389,10 @@ namespace QCAD {
     mathVector finalPtValues;
     mathVector finalPtWeights;
 
+    //! spatial bins of imagePts and finalPts, rebuilt before each fill
+    imagePtBins imagePtGrid, finalPtGrid;
+    std::vector<std::size_t> nearPts;
+
 
     //! mode of current evaluator operation (maybe not thread safe?)
     std::string mode;
@@ -41,6 +41,7 @@ AAdapt::AdaptiveSolutionManagerT::AdaptiveSolutionManagerT(
     const Teuchos::RCP<rc::Manager>& rc_mgr,
     const Teuchos::RCP<const Teuchos_Comm>& commT) :
 
+    numScatterVecs(0),
     out(Teuchos::VerboseObjectBase::getDefaultOStream()),
     appParams_(appParams),
     disc_(stateMgr.getDiscretization()),
@@ -409,6 +410,56 @@ AAdapt::AdaptiveSolutionManagerT::scatterXT(
 
 }
 
+void
+AAdapt::AdaptiveSolutionManagerT::beginScatterXT(
+    const Tpetra_Vector& xT, /* note that none are overlapped */
+    const Tpetra_Vector* x_dotT,
+    const Tpetra_Vector* x_dotdotT)
+{
+  // Same packing as Tpetra::DistObject::doTransfer: exports in the order of
+  // the importer's export ids, imports in the order of its remote ids
+  const size_t numSame = importerT->getNumSameIDs();
+  const Teuchos::ArrayView<const LO> permuteFrom = importerT->getPermuteFromLIDs();
+  const Teuchos::ArrayView<const LO> permuteTo   = importerT->getPermuteToLIDs();
+  const Teuchos::ArrayView<const LO> exportLIDs  = importerT->getExportLIDs();
+
+  const Tpetra_Vector* src[3] = {&xT, x_dotT, x_dotdotT};
+  numScatterVecs = x_dotdotT ? 3 : (x_dotT ? 2 : 1);
+  TEUCHOS_TEST_FOR_EXCEPTION(!x_dotT && x_dotdotT, std::logic_error,
+      "AdaptiveSolutionManager error: x_dotdotT defined without x_dotT");
+  TEUCHOS_TEST_FOR_EXCEPTION(static_cast<int>(overlapped_soln->getNumVectors()) < numScatterVecs, std::logic_error,
+      "AdaptiveSolutionManager error: time derivative defined but not available in the multivector");
+
+  scatterExports.resize(exportLIDs.size()*numScatterVecs);
+  scatterImports.resize(importerT->getNumRemoteIDs()*numScatterVecs);
+
+  for (int k = 0; k < numScatterVecs; ++k) {
+    Teuchos::ArrayRCP<const ST> from = src[k]->get1dView();
+    Teuchos::ArrayRCP<ST> to = overlapped_soln->getVectorNonConst(k)->get1dViewNonConst();
+    for (size_t i = 0; i < numSame; ++i)
+      to[i] = from[i];
+    for (int i = 0; i < permuteFrom.size(); ++i)
+      to[permuteTo[i]] = from[permuteFrom[i]];
+    for (int i = 0; i < exportLIDs.size(); ++i)
+      scatterExports[i*numScatterVecs+k] = from[exportLIDs[i]];
+  }
+
+  importerT->getDistributor().doPosts(
+      scatterExports.getConst(), numScatterVecs, scatterImports);
+}
+
+void
+AAdapt::AdaptiveSolutionManagerT::endScatterXT()
+{
+  importerT->getDistributor().doWaits();
+
+  const Teuchos::ArrayView<const LO> remoteLIDs = importerT->getRemoteLIDs();
+  for (int k = 0; k < numScatterVecs; ++k) {
+    Teuchos::ArrayRCP<ST> to = overlapped_soln->getVectorNonConst(k)->get1dViewNonConst();
+    for (int i = 0; i < remoteLIDs.size(); ++i)
+      to[remoteLIDs[i]] = scatterImports[i*numScatterVecs+k];
+  }
+}
 
 Teuchos::RCP<Thyra::MultiVectorBase<double> >
 AAdapt::AdaptiveSolutionManagerT::
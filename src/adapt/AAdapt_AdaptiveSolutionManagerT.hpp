@@ -44,6 +44,10 @@ public:
 
    Teuchos::RCP<const Tpetra_MultiVector> getInitialSolution() const { return current_soln; }
 
+   //! Reload the solution from the discretization, e.g. after a coupled code
+   //! has written a new initial guess into the mesh between two solves
+   void reloadSolutionFromDiscretization() { current_soln = disc_->getSolutionMV(); }
+
    Teuchos::RCP<Tpetra_MultiVector> getOverlappedSolution() { return overlapped_soln; }
 
    Teuchos::RCP<const Tpetra_MultiVector> getOverlappedSolution() const { return overlapped_soln; }
@@ -69,11 +73,27 @@ public:
    void scatterXT(
        const Tpetra_MultiVector& soln);
 
+   //! Split-phase scatterXT. beginScatterXT copies the owned entries into
+   //! the overlapped vectors and posts the messages carrying the ghosted
+   //! ones; endScatterXT waits for them and unpacks. Between the two only
+   //! the owned entries of the overlapped solution are valid.
+   void beginScatterXT(
+       const Tpetra_Vector& xT,
+       const Tpetra_Vector* x_dotT,
+       const Tpetra_Vector* x_dotdotT);
+
+   void endScatterXT();
+
 private:
 
     Teuchos::RCP<Tpetra_Import> importerT;
     Teuchos::RCP<Tpetra_Export> exporterT;
 
+    //! Message buffers of a split-phase scatter, entry i*numScatterVecs+k
+    //! holds vector k at the i-th export (remote) id of importerT
+    Teuchos::ArrayRCP<ST> scatterExports, scatterImports;
+    int numScatterVecs;
+
     Teuchos::RCP<Tpetra_Vector> overlapped_fT;
     Teuchos::RCP<Tpetra_CrsMatrix> overlapped_jacT;
 
@@ -115,6 +115,9 @@ class AbstractDiscretization {
     //! Get Side set lists
     virtual const SideSetList& getSideSets(const int ws) const = 0;
 
+    //! Get the flat per-workset side set views (sides grouped by element)
+    virtual const LocalSideSetInfoList& getLocalSideSets(const int ws) const = 0;
+
     using WorksetConn = Kokkos::View<LO***, Kokkos::LayoutRight, PHX::Device>;
     using Conn = typename Albany::WorksetArray<WorksetConn>::type;
 
@@ -253,6 +256,13 @@ class AbstractDiscretization {
     //! Get Numbering for layered mesh (mesh structred in one direction)
     virtual Teuchos::RCP<LayeredMeshNumbering<LO> > getLayeredMeshNumbering() = 0;
 
+    //! Get the layer index of each cell, per workset (empty if the mesh is not layered)
+    virtual const WorksetArray<Teuchos::ArrayRCP<LO> >::type& getWsElLayerID() const = 0;
+
+    //! Per workset, true if all the nodes of its cells are owned, so that it can be
+    //! evaluated before the halo import completes (empty if the worksets are not classified)
+    virtual const WorksetArray<bool>::type& getWsIsInterior() const = 0;
+
   private:
 
     //! Private to prohibit copying
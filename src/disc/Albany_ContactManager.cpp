@@ -9,6 +9,8 @@
 
 #include "Moertel_InterfaceT.hpp"
 
+#include "utility/PerformanceContext.hpp"
+
 const int printLevel = 4;
 
 Albany::ContactManager::ContactManager(const Teuchos::RCP<Teuchos::ParameterList>& params_,
@@ -164,6 +166,11 @@ Albany::ContactManager::processSS(const int ctr, const std::string& sideSetName,
   moertelInterface->SetMortarSide(mortarside);
   moertelInterface->SetFunctionTypes(primal, dual);
 
+  // report the mortar search and overlap costs with the rest of the timers
+  util::TimeMonitor& tmonitor = util::PerformanceContext::instance().timeMonitor();
+  moertelInterface->SetSearchTimers(tmonitor["Mortar: Segment Search Time"],
+                                    tmonitor["Mortar: Segment Overlap Time"]);
+
 //  std::size_t numFields = disc.getWsElNodeEqID()[0][0][0].size(); // num equations at each node
   std::size_t numFields = disc.getWsElNodeEqID()->dimension(3); // num equations at each node
 
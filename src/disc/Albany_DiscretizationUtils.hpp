@@ -11,6 +11,8 @@
 
 #include <vector>
 #include <string>
+#include <map>
+#include <algorithm>
 
 #include "Teuchos_RCP.hpp"
 #include "Teuchos_ArrayRCP.hpp"
@@ -39,6 +41,57 @@ class SideStruct {
 
 typedef std::map<std::string, std::vector<SideStruct> > SideSetList;
 
+/*! Flat view of the sides of one side set within one workset.
+ *
+ *  The sides are sorted by the workset-local id of their element, so the
+ *  sides of the i-th distinct cell are [cellOffsets[i], cellOffsets[i+1]).
+ *  Evaluators can thread over the distinct cells without two threads ever
+ *  writing to the same cell.
+ */
+struct LocalSideSetInfo {
+
+  int numSides;  // number of sides in this side set on this workset
+  int numCells;  // number of distinct elements owning those sides
+
+  Teuchos::ArrayRCP<int> elem_LID;       // workset-local element id, per side
+  Teuchos::ArrayRCP<int> side_local_id;  // side id relative to the element, per side
+  Teuchos::ArrayRCP<int> cellOffsets;    // numCells+1 offsets into the side arrays
+};
+
+typedef std::map<std::string, LocalSideSetInfo> LocalSideSetInfoList;
+
+//! Build the flat side set views of a workset from its side set list
+inline void
+buildLocalSideSetInfo (const SideSetList& ssList, LocalSideSetInfoList& localList)
+{
+  localList.clear();
+  for (const auto& it : ssList) {
+    std::vector<std::pair<int,int> > sides;
+    sides.reserve(it.second.size());
+    for (const auto& side : it.second)
+      sides.push_back(std::make_pair(side.elem_LID, static_cast<int>(side.side_local_id)));
+    std::sort(sides.begin(), sides.end());
+
+    LocalSideSetInfo& info = localList[it.first];
+    info.numSides = sides.size();
+    info.elem_LID.resize(info.numSides);
+    info.side_local_id.resize(info.numSides);
+
+    std::vector<int> offsets;
+    for (int i=0; i<info.numSides; ++i) {
+      info.elem_LID[i]      = sides[i].first;
+      info.side_local_id[i] = sides[i].second;
+      if (i==0 || sides[i].first!=sides[i-1].first)
+        offsets.push_back(i);
+    }
+    offsets.push_back(info.numSides);
+
+    info.numCells = offsets.size()-1;
+    info.cellOffsets = Teuchos::arcp(static_cast<int>(offsets.size()));
+    std::copy(offsets.begin(), offsets.end(), info.cellOffsets.begin());
+  }
+}
+
 class wsLid {
 
   public:
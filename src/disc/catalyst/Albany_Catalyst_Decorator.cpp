@@ -143,6 +143,11 @@ const SideSetList &Decorator::getSideSets(const int workset) const
   return discretization->getSideSets(workset);
 }
 
+const LocalSideSetInfoList &Decorator::getLocalSideSets(const int workset) const
+{
+  return discretization->getLocalSideSets(workset);
+}
+
 const Decorator::Conn&
 Decorator::getWsElNodeEqID() const
 {
@@ -421,5 +426,15 @@ Teuchos::RCP<LayeredMeshNumbering<LO> > Decorator::getLayeredMeshNumbering() {
   return discretization->getLayeredMeshNumbering();
 }
 
+const WorksetArray<Teuchos::ArrayRCP<LO> >::type& Decorator::getWsElLayerID() const
+{
+  return discretization->getWsElLayerID();
+}
+
+const WorksetArray<bool>::type& Decorator::getWsIsInterior() const
+{
+  return discretization->getWsIsInterior();
+}
+
 } // end namespace Catalyst
 } // end namespace Albany
@@ -89,6 +89,9 @@ public:
   //! Get Side set lists (typedef in Albany_AbstractDiscretization.hpp)
   const SideSetList& getSideSets(const int workset) const override;
 
+  //! Get the flat side set views of a workset
+  const LocalSideSetInfoList& getLocalSideSets(const int workset) const override;
+
   //! Get map from (Ws, El, Local Node) -> NodeLID
   using AbstractDiscretization::Conn;
   const Conn& getWsElNodeEqID() const override;
@@ -221,6 +224,12 @@ public:
   //! Get Numbering for layered mesh (mesh structred in one direction)
   Teuchos::RCP<LayeredMeshNumbering<LO> > getLayeredMeshNumbering() override;
 
+  //! Get the layer index of each cell, per workset
+  const WorksetArray<Teuchos::ArrayRCP<LO> >::type& getWsElLayerID() const override;
+
+  //! Per workset, true if all the nodes of its cells are owned
+  const WorksetArray<bool>::type& getWsIsInterior() const override;
+
 private:
   //! Private to prohibit copying
   Decorator(const Decorator&);
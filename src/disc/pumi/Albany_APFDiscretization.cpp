@@ -1293,6 +1293,10 @@ void Albany::APFDiscretization::computeSideSets()
     }
   }
   m->end(it);
+
+  localSideSets.resize(num_buckets);
+  for (int ws = 0; ws < num_buckets; ++ws)
+    Albany::buildLocalSideSetInfo(sideSets[ws], localSideSets[ws]);
 }
 
 void Albany::APFDiscretization::copyQPScalarToAPF(
@@ -87,6 +87,9 @@ class APFDiscretization : public Albany::AbstractDiscretization {
     //! Get Side set lists (typedef in Albany_AbstractDiscretization.hpp)
     const Albany::SideSetList& getSideSets(const int workset) const override { return sideSets[workset]; }
 
+    //! Get the flat side set views of a workset
+    const Albany::LocalSideSetInfoList& getLocalSideSets(const int workset) const override { return localSideSets[workset]; }
+
     //! Get connectivity map from elementGID to workset
     Albany::WsLIDList& getElemGIDws() override { return elemGIDws; }
     const Albany::WsLIDList& getElemGIDws() const override { return elemGIDws; }
@@ -332,6 +335,18 @@ class APFDiscretization : public Albany::AbstractDiscretization {
       return Teuchos::null;
     }
 
+    //! The mesh is not layered
+    const Albany::WorksetArray<Teuchos::ArrayRCP<LO> >::type& getWsElLayerID() const override {
+      static const Albany::WorksetArray<Teuchos::ArrayRCP<LO> >::type empty;
+      return empty;
+    }
+
+    //! Worksets are not classified
+    const Albany::WorksetArray<bool>::type& getWsIsInterior() const override {
+      static const Albany::WorksetArray<bool>::type empty;
+      return empty;
+    }
+
     void initTemperatureHack();
 
     //! Set any FELIX Data
@@ -470,6 +485,9 @@ class APFDiscretization : public Albany::AbstractDiscretization {
     //! side sets stored as std::map(string ID, SideArray classes) per workset (std::vector across worksets)
     std::vector<Albany::SideSetList> sideSets;
 
+    //! flat views of sideSets, one per workset
+    std::vector<Albany::LocalSideSetInfoList> localSideSets;
+
     // Side set discretizations related structures (not supported but needed for getters return values)
     std::map<std::string,Teuchos::RCP<Albany::AbstractDiscretization> > sideSetDiscretizations;
     std::map<std::string,std::map<GO,GO> >                              sideToSideSetCellMap;
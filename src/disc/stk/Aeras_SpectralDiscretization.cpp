@@ -2439,6 +2439,7 @@ void Aeras::SpectralDiscretization::computeWorksetInfo()
   // Fill  wsElNodeEqID(workset, el_LID, local node, Eq) => unk_LID
 
   wsElNodeEqID.resize(numBuckets);
+  wsIsInterior.resize(numBuckets);
   //wsElNodeID.resize(numBuckets);
   //coords.resize(numBuckets);
   sphereVolume.resize(numBuckets);
@@ -2464,6 +2465,7 @@ void Aeras::SpectralDiscretization::computeWorksetInfo()
 
     // Set size of Kokkos views
     wsElNodeEqID[b] = WorksetConn("wsElNodeEqID", buck.size(), nodes_per_element, neq);
+    wsIsInterior[b] = true;
 
     {  // nodalDataToElemNode.
 
@@ -2575,6 +2577,8 @@ void Aeras::SpectralDiscretization::computeWorksetInfo()
           node_lid < 0,
           std::logic_error,
 	  "STK1D_Disc: node_lid out of range " << node_lid << std::endl);
+        if (!node_mapT->isNodeGlobalElement(node_gid))
+          wsIsInterior[b] = false;
         //coords[b][i][j] = stk::mesh::field_data(*coordinates_field, rowNode);
 
         //wsElNodeID[b][i][j] = node_gid;
@@ -2829,6 +2833,10 @@ void Aeras::SpectralDiscretization::computeSideSetsLines()
 
     ss++;
   }*/
+
+  localSideSets.resize(sideSets.size());
+  for (int ws = 0; ws < sideSets.size(); ++ws)
+    Albany::buildLocalSideSetInfo(sideSets[ws], localSideSets[ws]);
 }
 
 unsigned
@@ -289,6 +289,12 @@ namespace Aeras
       return sideSets[workset];
     };
 
+    //! Get the flat side set views of a workset
+    const Albany::LocalSideSetInfoList& getLocalSideSets(const int workset) const override
+    {
+      return localSideSets[workset];
+    };
+
     //! Get connectivity map from elementGID to workset
     Albany::WsLIDList& getElemGIDws() override
     {
@@ -571,6 +577,17 @@ namespace Aeras
       return Teuchos::null;
     }
 
+    //! The mesh is not layered
+    const Albany::WorksetArray<Teuchos::ArrayRCP<LO> >::type& getWsElLayerID() const override {
+      static const Albany::WorksetArray<Teuchos::ArrayRCP<LO> >::type empty;
+      return empty;
+    }
+
+    //! Per workset, true if all the (enriched) nodes of its elements are owned
+    const Albany::WorksetArray<bool>::type& getWsIsInterior() const override {
+      return wsIsInterior;
+    }
+
   private:
 
     //! Private to prohibit copying
@@ -764,6 +781,9 @@ namespace Aeras
     //! workset (std::vector across worksets)
     std::vector<Albany::SideSetList> sideSets;
 
+    //! flat views of sideSets, one per workset
+    std::vector<Albany::LocalSideSetInfoList> localSideSets;
+
     //! Flags indicating which edges are owned
     std::map< GO, bool > edgeIsOwned;
 
@@ -776,6 +796,9 @@ namespace Aeras
     //! Connectivity array [workset, element, local-node] => GID
     Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<GO> > >::type wsElNodeID;
 
+    //! Worksets whose elements have owned nodes only
+    Albany::WorksetArray<bool>::type wsIsInterior;
+
     mutable Teuchos::ArrayRCP<double> coordinates;
     Albany::WorksetArray<std::string>::type wsEBNames;
     Albany::WorksetArray<int>::type wsPhysIndex;
@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <iostream>
+#include <algorithm>
 
 #include "Albany_ExtrudedSTKMeshStruct.hpp"
 #include "Teuchos_VerboseObject.hpp"
@@ -143,13 +144,27 @@ Albany::ExtrudedSTKMeshStruct::ExtrudedSTKMeshStruct(const Teuchos::RCP<Teuchos:
 
   numDim = 3;
   numLayers = params->get<int>("NumLayers");
-  Ordering = params->get("Columnwise Ordering", false) ? LayeredMeshOrdering::COLUMN : LayeredMeshOrdering::LAYER;
+  bool columnwiseWorksets = params->get("Columnwise Worksets", false);
+  Ordering = params->get("Columnwise Ordering", columnwiseWorksets) ? LayeredMeshOrdering::COLUMN : LayeredMeshOrdering::LAYER;
+
+  // Worksets are STK buckets, filled with elements sorted by id. With the columnwise ordering the elements
+  // of a column have consecutive ids, so a workset size multiple of the column size gives worksets made of
+  // complete columns, ordered as the basal mesh.
+  TEUCHOS_TEST_FOR_EXCEPTION (columnwiseWorksets && Ordering!=LayeredMeshOrdering::COLUMN, std::logic_error,
+                              "Error! 'Columnwise Worksets' requires 'Columnwise Ordering'.\n");
 
   int cub = params->get("Cubature Degree", 3);
   int basalWorksetSize = basalMeshStruct->getMeshSpecs()[0]->worksetSize;
   int worksetSizeMax = params->get<int>("Workset Size", DEFAULT_WORKSET_SIZE);
   int numElemsInColumn = numLayers*((ElemShape==Tetrahedron) ? 3 : 1);
-  int worksetSize = this->computeWorksetSize(worksetSizeMax, basalWorksetSize*numElemsInColumn);
+  int worksetSize;
+  if (columnwiseWorksets)
+  {
+    int numColumnsMax = std::max(worksetSizeMax/numElemsInColumn, 1);
+    worksetSize = numElemsInColumn*this->computeWorksetSize(numColumnsMax, basalWorksetSize);
+  }
+  else
+    worksetSize = this->computeWorksetSize(worksetSizeMax, basalWorksetSize*numElemsInColumn);
 
   const CellTopologyData& ctd = *metaData->get_cell_topology(*partVec[0]).getCellTopologyData();
 
@@ -1365,6 +1380,7 @@ Teuchos::RCP<const Teuchos::ParameterList> Albany::ExtrudedSTKMeshStruct::getVal
   validPL->set<int>("NumLayers", 10, "Number of vertical Layers of the extruded mesh. In a vertical column, the mesh will have numLayers+1 nodes");
   validPL->set<bool>("Use Glimmer Spacing", false, "When true, the layer spacing is computed according to Glimmer formula (layers are denser close to the bedrock)");
   validPL->set<bool>("Columnwise Ordering", false, "True for Columnwise ordering, false for Layerwise ordering");
+  validPL->set<bool>("Columnwise Worksets", false, "If true, each workset is made of complete columns (requires Columnwise Ordering)");
 
   validPL->set<std::string>("Thickness Field Name","thickness","Name of the 'thickness' field to use for extrusion");
   validPL->set<std::string>("Surface Height Field Name","surface_height","Name of the 'surface_height' field to use for extrusion");
@@ -702,6 +702,15 @@ Albany::STKDiscretization::setupMLCoords()
 
   rigidBodyModes->setCoordinatesAndNullspace(coordMV, mapT);
 
+  // Expose the column structure of extruded meshes to the preconditioner
+  if (Teuchos::nonnull(stkMeshStruct->layered_mesh_numbering)) {
+    const LayeredMeshNumbering<LO>& layeredMeshNumbering =
+        *stkMeshStruct->layered_mesh_numbering;
+    rigidBodyModes->setLayeredMeshInfo(
+        layeredMeshNumbering.numLayers,
+        layeredMeshNumbering.ordering == LayeredMeshOrdering::COLUMN);
+  }
+
   // Some optional matrix-market output was tagged on here; keep that
   // functionality.
   writeCoordsToMatrixMarket();
@@ -1967,6 +1976,14 @@ Albany::STKDiscretization::computeWorksetInfo()
     for (int i       = 0; i < numBuckets; i++)
       wsPhysIndex[i] = stkMeshStruct->ebNameToIndex[wsEBNames[i]];
 
+  // For layered meshes, the layer of a cell is the lowest level of its nodes
+  Teuchos::RCP<LayeredMeshNumbering<LO>> layeredMeshNumbering =
+      stkMeshStruct->layered_mesh_numbering;
+  if (Teuchos::nonnull(layeredMeshNumbering))
+    wsElLayerID.resize(numBuckets);
+  else
+    wsElLayerID.clear();
+
   // Fill  wsElNodeEqID(workset, el_LID, local node, Eq) => unk_LID
   wsElNodeEqID.resize(numBuckets);
   wsElNodeID.resize(numBuckets);
@@ -1999,6 +2016,8 @@ Albany::STKDiscretization::computeWorksetInfo()
     stk::mesh::Bucket& buck = *buckets[b];
     wsElNodeID[b].resize(buck.size());
     coords[b].resize(buck.size());
+    if (Teuchos::nonnull(layeredMeshNumbering))
+      wsElLayerID[b].resize(buck.size());
 
     // Set size of Kokkos views
     // Note: Assumes nodes_per_element is the same across all elements in a
@@ -2176,6 +2195,13 @@ Albany::STKDiscretization::computeWorksetInfo()
             "STK1D_Disc: node_lid out of range " << node_lid << std::endl);
         coords[b][i][j] = stk::mesh::field_data(*coordinates_field, rowNode);
 
+        if (Teuchos::nonnull(layeredMeshNumbering)) {
+          LO column_id, level_index;
+          layeredMeshNumbering->getIndices(node_lid, column_id, level_index);
+          if (j == 0 || level_index < wsElLayerID[b][i])
+            wsElLayerID[b][i] = level_index;
+        }
+
         wsElNodeID[b][i][j] = node_array((int)i, j);
 
         for (int eq = 0; eq < neq; eq++)
@@ -2513,6 +2539,10 @@ Albany::STKDiscretization::computeSideSets()
     ss++;
   }
 
+  localSideSets.resize(numBuckets);
+  for (int ws = 0; ws < numBuckets; ++ws)
+    buildLocalSideSetInfo(sideSets[ws], localSideSets[ws]);
+
 #ifdef ALBANY_CONTACT
   contactManager = Teuchos::rcp(new Albany::ContactManager(
       discParams, *this, stkMeshStruct->getMeshSpecs()));
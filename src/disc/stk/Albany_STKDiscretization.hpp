@@ -228,6 +228,13 @@ class STKDiscretization : public Albany::AbstractDiscretization {
     return sideSets[workset];
   };
 
+  //! Get the flat side set views of a workset
+  const LocalSideSetInfoList&
+  getLocalSideSets(const int workset) const
+  {
+    return localSideSets[workset];
+  };
+
   //! Get connectivity map from elementGID to workset
   WsLIDList&
   getElemGIDws()
@@ -536,6 +543,20 @@ class STKDiscretization : public Albany::AbstractDiscretization {
     return stkMeshStruct->layered_mesh_numbering;
   }
 
+  const Albany::WorksetArray<Teuchos::ArrayRCP<LO>>::type&
+  getWsElLayerID() const
+  {
+    return wsElLayerID;
+  }
+
+  //! Worksets are not classified
+  const Albany::WorksetArray<bool>::type&
+  getWsIsInterior() const
+  {
+    static const Albany::WorksetArray<bool>::type empty;
+    return empty;
+  }
+
   //! used when NetCDF output on a latitude-longitude grid is requested.
   // Each struct contains a latitude/longitude index and it's parametric
   // coordinates in an element.
@@ -738,6 +759,9 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   //! (std::vector across worksets)
   std::vector<Albany::SideSetList> sideSets;
 
+  //! flat views of sideSets, one per workset
+  std::vector<Albany::LocalSideSetInfoList> localSideSets;
+
   //! Connectivity array [workset, element, local-node, Eq] => LID
   Conn wsElNodeEqID;
 
@@ -749,6 +773,7 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   Teuchos::RCP<Tpetra_MultiVector>        coordMV;
   Albany::WorksetArray<std::string>::type wsEBNames;
   Albany::WorksetArray<int>::type         wsPhysIndex;
+  Albany::WorksetArray<Teuchos::ArrayRCP<LO>>::type      wsElLayerID;
   Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*>>>::type
                                                          coords;
   Albany::WorksetArray<Teuchos::ArrayRCP<double>>::type  sphereVolume;
@@ -0,0 +1,162 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+
+#include "Albany_EigenvalueResponseFunction.hpp"
+
+Albany::EigenvalueResponseFunction::
+EigenvalueResponseFunction(const Teuchos::RCP<Application>& app_,
+                           Teuchos::ParameterList& responseParams) :
+  ScalarResponseFunction(app_->getComm()),
+  app(app_)
+{
+  numEigenvalues = responseParams.get("Number of Eigenvalues", 1);
+}
+
+Albany::EigenvalueResponseFunction::
+~EigenvalueResponseFunction()
+{
+}
+
+unsigned int
+Albany::EigenvalueResponseFunction::
+numResponses() const 
+{
+  return numEigenvalues;
+}
+
+void
+Albany::EigenvalueResponseFunction::
+getEigenvalues(Tpetra_Vector& gT) const
+{
+  Teuchos::RCP<Albany::EigendataStructT> eigenData =
+    app->getStateMgr().getEigenDataT();
+  TEUCHOS_TEST_FOR_EXCEPTION(eigenData == Teuchos::null ||
+     eigenData->eigenvalueRe == Teuchos::null ||
+     (int)eigenData->eigenvalueRe->size() < numEigenvalues,
+     Teuchos::Exceptions::InvalidParameter,
+     "Eigenvalue response requested " << numEigenvalues << " eigenvalues but "
+     << "the StateManager does not hold that many (was an eigensolve run?)" << std::endl);
+
+  // The StateManager holds negated eigenvalues (historic LOCA convention)
+  Teuchos::ArrayRCP<ST> gT_nonconstView = gT.get1dViewNonConst();
+  for (int i=0; i<numEigenvalues; i++)
+    gT_nonconstView[i] = -(*(eigenData->eigenvalueRe))[i];
+}
+
+void
+Albany::EigenvalueResponseFunction::
+evaluateResponseT(const double current_time,
+		 const Tpetra_Vector* xdotT,
+		 const Tpetra_Vector* xdotdotT,
+		 const Tpetra_Vector& xT,
+		 const Teuchos::Array<ParamVec>& p,
+		 Tpetra_Vector& gT)
+{
+  getEigenvalues(gT);
+}
+
+
+void
+Albany::EigenvalueResponseFunction::
+evaluateTangentT(const double alpha, 
+		const double beta,
+		const double omega,
+		const double current_time,
+		bool sum_derivs,
+		const Tpetra_Vector* xdotT,
+		const Tpetra_Vector* xdotdotT,
+		const Tpetra_Vector& xT,
+		const Teuchos::Array<ParamVec>& p,
+		ParamVec* deriv_p,
+		const Tpetra_MultiVector* VxdotT,
+		const Tpetra_MultiVector* VxdotdotT,
+		const Tpetra_MultiVector* VxT,
+		const Tpetra_MultiVector* VpT,
+		Tpetra_Vector* gT,
+		Tpetra_MultiVector* gxT,
+		Tpetra_MultiVector* gpT)
+{
+  // Evaluate response g
+  if (gT != NULL)
+    getEigenvalues(*gT);
+
+  // The eigenvalues do not depend on the solution vector
+  if (gxT != NULL)
+    gxT->putScalar(0.0);
+  
+  if (gpT != NULL)
+    gpT->putScalar(0.0);
+}
+
+#if defined(ALBANY_EPETRA)
+void
+Albany::EigenvalueResponseFunction::
+evaluateGradient(const double current_time,
+		 const Epetra_Vector* xdot,
+		 const Epetra_Vector* xdotdot,
+		 const Epetra_Vector& x,
+		 const Teuchos::Array<ParamVec>& p,
+		 ParamVec* deriv_p,
+		 Epetra_Vector* g,
+		 Epetra_MultiVector* dg_dx,
+		 Epetra_MultiVector* dg_dxdot,
+		 Epetra_MultiVector* dg_dxdotdot,
+		 Epetra_MultiVector* dg_dp)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter,
+     "Eigenvalue response is only available with Tpetra eigensolves" << std::endl);
+}
+#endif 
+
+void
+Albany::EigenvalueResponseFunction::
+evaluateGradientT(const double current_time,
+		 const Tpetra_Vector* xdotT,
+		 const Tpetra_Vector* xdotdotT,
+		 const Tpetra_Vector& xT,
+		 const Teuchos::Array<ParamVec>& p,
+		 ParamVec* deriv_p,
+		 Tpetra_Vector* gT,
+		 Tpetra_MultiVector* dg_dxT,
+		 Tpetra_MultiVector* dg_dxdotT,
+		 Tpetra_MultiVector* dg_dxdotdotT,
+		 Tpetra_MultiVector* dg_dpT)
+{
+
+  // Evaluate response g
+  if (gT != NULL)
+    getEigenvalues(*gT);
+
+  // Evaluate dg/dx
+  if (dg_dxT != NULL)
+    dg_dxT->putScalar(0.0);
+
+  // Evaluate dg/dxdot
+  if (dg_dxdotT != NULL)
+    dg_dxdotT->putScalar(0.0);
+  if (dg_dxdotdotT != NULL)
+    dg_dxdotdotT->putScalar(0.0);
+
+  // Evaluate dg/dp
+  if (dg_dpT != NULL)
+    dg_dpT->putScalar(0.0);
+}
+
+void
+Albany::EigenvalueResponseFunction::
+evaluateDistParamDerivT(
+         const double current_time,
+         const Tpetra_Vector* xdotT,
+         const Tpetra_Vector* xdotdotT,
+         const Tpetra_Vector& xT,
+         const Teuchos::Array<ParamVec>& param_array,
+         const std::string& dist_param_name,
+         Tpetra_MultiVector* dg_dpT) {
+  // Evaluate response derivative dg_dp
+  if (dg_dpT != NULL)
+    dg_dpT->putScalar(0.0);
+}
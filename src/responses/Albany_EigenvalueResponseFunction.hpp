@@ -0,0 +1,125 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+
+#ifndef ALBANY_EIGENVALUERESPONSEFUNCTION_HPP
+#define ALBANY_EIGENVALUERESPONSEFUNCTION_HPP
+
+#include "Albany_ScalarResponseFunction.hpp"
+#include "Albany_Application.hpp"
+
+#include "Teuchos_ParameterList.hpp"
+
+namespace Albany {
+
+  /*!
+   * \brief Reponse function returning the lowest eigenvalues stored in the
+   * application's StateManager by the last (Tpetra) eigensolve
+   */
+  class EigenvalueResponseFunction : 
+    public ScalarResponseFunction {
+  public:
+  
+    //! Constructor
+    EigenvalueResponseFunction(
+      const Teuchos::RCP<Application>& app,
+      Teuchos::ParameterList& responseParams);
+
+    //! Destructor
+    virtual ~EigenvalueResponseFunction();
+
+    //! Get the number of responses
+    virtual unsigned int numResponses() const;
+
+    //! Evaluate responses
+    virtual void 
+    evaluateResponseT(const double current_time,
+		     const Tpetra_Vector* xdotT,
+		     const Tpetra_Vector* xdotdotT,
+		     const Tpetra_Vector& xT,
+		     const Teuchos::Array<ParamVec>& p,
+		     Tpetra_Vector& gT);
+
+
+    //! Evaluate tangent = dg/dx*dx/dp + dg/dxdot*dxdot/dp + dg/dp
+    virtual void 
+    evaluateTangentT(const double alpha, 
+		    const double beta,
+		    const double omega,
+		    const double current_time,
+		    bool sum_derivs,
+		    const Tpetra_Vector* xdot,
+		    const Tpetra_Vector* xdotdot,
+		    const Tpetra_Vector& x,
+		    const Teuchos::Array<ParamVec>& p,
+		    ParamVec* deriv_p,
+		    const Tpetra_MultiVector* Vxdot,
+		    const Tpetra_MultiVector* Vxdotdot,
+		    const Tpetra_MultiVector* Vx,
+		    const Tpetra_MultiVector* Vp,
+		    Tpetra_Vector* g,
+		    Tpetra_MultiVector* gx,
+		    Tpetra_MultiVector* gp);
+
+#if defined(ALBANY_EPETRA)
+    //! Evaluate gradient = dg/dx, dg/dxdot, dg/dp
+    virtual void 
+    evaluateGradient(const double current_time,
+		     const Epetra_Vector* xdot,
+		     const Epetra_Vector* xdotdot,
+		     const Epetra_Vector& x,
+		     const Teuchos::Array<ParamVec>& p,
+		     ParamVec* deriv_p,
+		     Epetra_Vector* g,
+		     Epetra_MultiVector* dg_dx,
+		     Epetra_MultiVector* dg_dxdot,
+		     Epetra_MultiVector* dg_dxdotdot,
+		     Epetra_MultiVector* dg_dp);
+#endif
+
+    //! Evaluate gradient = dg/dx, dg/dxdot, dg/dp
+    virtual void 
+    evaluateGradientT(const double current_time,
+		     const Tpetra_Vector* xdotT,
+		     const Tpetra_Vector* xdotdotT,
+		     const Tpetra_Vector& xT,
+		     const Teuchos::Array<ParamVec>& p,
+		     ParamVec* deriv_p,
+		     Tpetra_Vector* gT,
+		     Tpetra_MultiVector* dg_dxT,
+		     Tpetra_MultiVector* dg_dxdotT,
+		     Tpetra_MultiVector* dg_dxdotdotT,
+		     Tpetra_MultiVector* dg_dpT);
+
+    //! Evaluate distributed parameter derivative dg/dp
+    virtual void
+    evaluateDistParamDerivT(
+             const double current_time,
+             const Tpetra_Vector* xdotT,
+             const Tpetra_Vector* xdotdotT,
+             const Tpetra_Vector& xT,
+             const Teuchos::Array<ParamVec>& param_array,
+             const std::string& dist_param_name,
+             Tpetra_MultiVector* dg_dpT);
+
+  private:
+
+    //! Private to prohibit copying
+    EigenvalueResponseFunction(const EigenvalueResponseFunction&);
+    
+    //! Private to prohibit copying
+    EigenvalueResponseFunction& operator=(const EigenvalueResponseFunction&);
+
+    //! Copy the stored eigenvalues into g
+    void getEigenvalues(Tpetra_Vector& gT) const;
+
+    Teuchos::RCP<Application> app;
+    int numEigenvalues;
+  };
+
+}
+
+#endif // ALBANY_EIGENVALUERESPONSEFUNCTION_HPP
@@ -13,6 +13,7 @@
 #include "Albany_SolutionMaxValueResponseFunction.hpp"
 #include "Albany_SolutionMinValueResponseFunction.hpp"
 #include "Albany_SolutionFileResponseFunction.hpp"
+#include "Albany_EigenvalueResponseFunction.hpp"
 #ifdef ALBANY_PERIDIGM
 #ifdef ALBANY_EPETRA
 #include "AlbanyPeridigmOBCFunctional.hpp"
@@ -89,6 +90,11 @@ createResponseFunction(
       rcp(new Albany::SolutionFileResponseFunction<Albany::NormInf>(comm)));
   }
 
+  else if (name == "Eigenvalue") {
+    responses.push_back(
+      rcp(new Albany::EigenvalueResponseFunction(app, responseParams)));
+  }
+
   else if (name == "OBC Functional") {
 #ifdef ALBANY_PERIDIGM
 #ifdef ALBANY_EPETRA